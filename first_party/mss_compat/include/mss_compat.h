@@ -3,6 +3,8 @@
 
 #include <stdbool.h>
 
+#include <SDL3/SDL.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -28,8 +30,11 @@ void AILCALL AIL_close_stream(HSTREAM stream);
 int AILCALL AIL_digital_handle_reacquire(HDIGDRIVER drvr);
 int AILCALL AIL_digital_handle_release(HDIGDRIVER drvr);
 HSTREAM AILCALL AIL_open_stream(HDIGDRIVER dig, const char* filename, int stream_mem);
+HSTREAM AILCALL AIL_open_stream_io(HDIGDRIVER dig, SDL_IOStream* io);
 void AILCALL AIL_quick_handles(HDIGDRIVER* pdig, HMDIDRIVER* pmdi, HDLSDEVICE* pdls);
 HAUDIO AILCALL AIL_quick_load_mem(void const* mem, unsigned size);
+HAUDIO AILCALL AIL_quick_load_io(SDL_IOStream* io);
+HAUDIO AILCALL AIL_quick_load_cached(const char* name, void const* mem, unsigned size);
 int AILCALL AIL_quick_play(HAUDIO audio, unsigned loop_count);
 void AILCALL AIL_quick_set_volume(HAUDIO audio, int volume, int extravol);
 void AILCALL AIL_quick_shutdown(void);
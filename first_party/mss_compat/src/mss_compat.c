@@ -5,9 +5,26 @@
 #include <SDL3/SDL.h>
 #include <SDL3_mixer/SDL_mixer.h>
 
+// Upper bound of decoded audio kept around for reuse. Audio which is being
+// played is never evicted, so the cache can temporarily exceed the budget.
+#define AUDIO_CACHE_BUDGET (32 * 1024 * 1024)
+
+// Decoded audio shared by all plays of the same file (see
+// `AIL_quick_load_cached`).
+typedef struct AudioCacheEntry {
+    char* name;
+    unsigned int hash;
+    unsigned size;
+    size_t bytes;
+    MIX_Audio* audio;
+    int refcount;
+    unsigned int timestamp;
+} AudioCacheEntry;
+
 struct AUDIO {
     MIX_Audio* audio;
     MIX_Track* track;
+    AudioCacheEntry* cache_entry;
 };
 
 struct STREAM {
@@ -18,10 +35,141 @@ struct STREAM {
 
 static MIX_Mixer* mixer;
 
+static AudioCacheEntry** audio_cache_entries;
+static int audio_cache_length;
+static int audio_cache_capacity;
+static size_t audio_cache_bytes;
+static unsigned int audio_cache_timestamp;
+
+static unsigned int audio_cache_hash(const char* name)
+{
+    unsigned int hash = 2166136261u;
+
+    while (*name != '\0') {
+        hash ^= (unsigned char)SDL_tolower((unsigned char)*name++);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static void audio_cache_remove(int index)
+{
+    AudioCacheEntry* entry = audio_cache_entries[index];
+
+    audio_cache_bytes -= entry->bytes;
+    MIX_DestroyAudio(entry->audio);
+    SDL_free(entry->name);
+    free(entry);
+
+    audio_cache_entries[index] = audio_cache_entries[--audio_cache_length];
+}
+
+// Evicts least recently used audio which is not being played until the cache
+// fits the budget.
+static void audio_cache_trim(void)
+{
+    int index;
+    int candidate;
+
+    while (audio_cache_bytes > AUDIO_CACHE_BUDGET) {
+        candidate = -1;
+        for (index = 0; index < audio_cache_length; index++) {
+            if (audio_cache_entries[index]->refcount == 0
+                && (candidate == -1 || audio_cache_entries[index]->timestamp < audio_cache_entries[candidate]->timestamp)) {
+                candidate = index;
+            }
+        }
+
+        if (candidate == -1) {
+            break;
+        }
+
+        audio_cache_remove(candidate);
+    }
+}
+
+static void audio_cache_flush(void)
+{
+    while (audio_cache_length > 0) {
+        audio_cache_remove(audio_cache_length - 1);
+    }
+
+    free(audio_cache_entries);
+    audio_cache_entries = NULL;
+    audio_cache_capacity = 0;
+}
+
+static AudioCacheEntry* audio_cache_acquire(const char* name, void const* mem, unsigned size)
+{
+    unsigned int hash;
+    int index;
+    AudioCacheEntry* entry;
+    MIX_Audio* audio;
+    SDL_AudioSpec spec;
+    Sint64 frames;
+
+    hash = audio_cache_hash(name);
+
+    for (index = 0; index < audio_cache_length; index++) {
+        entry = audio_cache_entries[index];
+        if (entry->hash == hash
+            && entry->size == size
+            && SDL_strcasecmp(entry->name, name) == 0) {
+            entry->refcount++;
+            entry->timestamp = ++audio_cache_timestamp;
+            return entry;
+        }
+    }
+
+    audio = MIX_LoadAudio_IO(mixer, SDL_IOFromConstMem(mem, size), true, true);
+    if (audio == NULL) {
+        return NULL;
+    }
+
+    entry = (AudioCacheEntry*)malloc(sizeof(*entry));
+    entry->name = SDL_strdup(name);
+    entry->hash = hash;
+    entry->size = size;
+    entry->audio = audio;
+    entry->refcount = 1;
+    entry->timestamp = ++audio_cache_timestamp;
+
+    // Predecoded audio is kept as float samples. Fall back to the size of the
+    // source when the duration is unknown.
+    frames = MIX_GetAudioDuration(audio);
+    if (frames > 0 && MIX_GetAudioFormat(audio, &spec)) {
+        entry->bytes = (size_t)frames * spec.channels * sizeof(float);
+    } else {
+        entry->bytes = size;
+    }
+
+    if (audio_cache_length == audio_cache_capacity) {
+        audio_cache_capacity = audio_cache_capacity != 0 ? audio_cache_capacity * 2 : 64;
+        audio_cache_entries = (AudioCacheEntry**)realloc(audio_cache_entries, sizeof(*audio_cache_entries) * audio_cache_capacity);
+    }
+
+    audio_cache_entries[audio_cache_length++] = entry;
+    audio_cache_bytes += entry->bytes;
+    audio_cache_trim();
+
+    return entry;
+}
+
+static void audio_cache_release(AudioCacheEntry* entry)
+{
+    entry->refcount--;
+    if (entry->refcount == 0) {
+        audio_cache_trim();
+    }
+}
+
 void AILCALL AIL_close_stream(HSTREAM stream)
 {
     MIX_DestroyTrack(stream->track);
-    MIX_DestroyAudio(stream->audio);
+    if (stream->audio != NULL) {
+        MIX_DestroyAudio(stream->audio);
+    }
     free(stream);
 }
 
@@ -44,6 +192,25 @@ HSTREAM AILCALL AIL_open_stream(HDIGDRIVER dig, const char* filename, int stream
     return stream;
 }
 
+// Not a part of MSS API. Unlike `AIL_open_stream` the audio is decoded on the
+// fly straight from `io` while playing (nothing is loaded upfront), the `io` is
+// closed when the stream is closed.
+HSTREAM AILCALL AIL_open_stream_io(HDIGDRIVER dig, SDL_IOStream* io)
+{
+    HSTREAM stream = malloc(sizeof(*stream));
+    stream->track = MIX_CreateTrack(mixer);
+    stream->audio = NULL;
+
+    // NOTE: `io` is closed even on failure.
+    if (!MIX_SetTrackIOStream(stream->track, io, true)) {
+        MIX_DestroyTrack(stream->track);
+        free(stream);
+        return NULL;
+    }
+
+    return stream;
+}
+
 void AILCALL AIL_quick_handles(HDIGDRIVER* pdig, HMDIDRIVER* pmdi, HDLSDEVICE* pdls)
 {
     if (pdig != NULL) {
@@ -64,6 +231,41 @@ HAUDIO AILCALL AIL_quick_load_mem(void const* mem, unsigned size)
     HAUDIO audio = malloc(sizeof(*audio));
     audio->track = MIX_CreateTrack(mixer);
     audio->audio = MIX_LoadAudio_IO(mixer, SDL_IOFromConstMem(mem, size), true, true);
+    audio->cache_entry = NULL;
+    MIX_SetTrackAudio(audio->track, audio->audio);
+    return audio;
+}
+
+// Not a part of MSS API. Same as `AIL_quick_load_mem`, but the decoded audio
+// is shared between all plays of the file identified by `name` (and `size`),
+// so that repeated plays only create a track. `mem` is only read when the file
+// is not in the cache.
+HAUDIO AILCALL AIL_quick_load_cached(const char* name, void const* mem, unsigned size)
+{
+    AudioCacheEntry* cache_entry;
+    HAUDIO audio;
+
+    cache_entry = audio_cache_acquire(name, mem, size);
+    if (cache_entry == NULL) {
+        return AIL_quick_load_mem(mem, size);
+    }
+
+    audio = malloc(sizeof(*audio));
+    audio->track = MIX_CreateTrack(mixer);
+    audio->audio = cache_entry->audio;
+    audio->cache_entry = cache_entry;
+    MIX_SetTrackAudio(audio->track, audio->audio);
+    return audio;
+}
+
+// Not a part of MSS API. Unlike `AIL_quick_load_mem` the audio is decoded on
+// the fly while playing, the stream is closed when the audio is unloaded.
+HAUDIO AILCALL AIL_quick_load_io(SDL_IOStream* io)
+{
+    HAUDIO audio = malloc(sizeof(*audio));
+    audio->track = MIX_CreateTrack(mixer);
+    audio->audio = MIX_LoadAudio_IO(mixer, io, false, true);
+    audio->cache_entry = NULL;
     MIX_SetTrackAudio(audio->track, audio->audio);
     return audio;
 }
@@ -90,6 +292,7 @@ void AILCALL AIL_quick_set_volume(HAUDIO audio, int volume, int extravol)
 
 void AILCALL AIL_quick_shutdown(void)
 {
+    audio_cache_flush();
     MIX_DestroyMixer(mixer);
 }
 
@@ -117,7 +320,11 @@ int AILCALL AIL_quick_status(HAUDIO audio)
 void AILCALL AIL_quick_unload(HAUDIO audio)
 {
     MIX_DestroyTrack(audio->track);
-    MIX_DestroyAudio(audio->audio);
+    if (audio->cache_entry != NULL) {
+        audio_cache_release(audio->cache_entry);
+    } else {
+        MIX_DestroyAudio(audio->audio);
+    }
     free(audio);
 }
 
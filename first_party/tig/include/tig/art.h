@@ -415,6 +415,16 @@ typedef struct TigArtBlitInfo {
 
 typedef bool (*TigArtBlitPaletteAdjustCallback)(tig_art_id_t art_id, TigPaletteModifyInfo* modify_info);
 
+// Art cache lookup statistics.
+typedef struct TigArtCacheStats {
+    // Lookups resolved by the art_id table without building the path.
+    unsigned int id_hits;
+    // Lookups which built the path and found the entry in the cache.
+    unsigned int path_hits;
+    // Lookups which had to load the art file.
+    unsigned int misses;
+} TigArtCacheStats;
+
 int tig_art_init(TigInitInfo* init_info);
 void tig_art_exit(void);
 void tig_art_ping(void);
@@ -527,6 +537,7 @@ tig_art_id_t tig_art_eye_candy_id_scale_set(tig_art_id_t art_id, int value);
 int tig_art_id_flags_get(tig_art_id_t art_id);
 void sub_505000(tig_art_id_t art_id, TigPalette* src_palette, TigPalette* dst_palette);
 void tig_art_cache_set_video_memory_fullness(int fullness);
+void tig_art_cache_get_stats(TigArtCacheStats* stats);
 tig_art_id_t tig_art_id_reset(tig_art_id_t art_id);
 
 #ifdef __cplusplus
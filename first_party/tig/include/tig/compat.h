@@ -27,6 +27,8 @@ void compat_join_path_ex(char* path, size_t size, ...);
 #define compat_join_path(path, size, ...) compat_join_path_ex(path, size, __VA_ARGS__, NULL)
 void compat_splitpath(const char* path, char* drive, char* dir, char* fname, char* ext);
 void compat_makepath(char* path, const char* drive, const char* dir, const char* fname, const char* ext);
+void* compat_map_file(const char* path, size_t* size_ptr);
+void compat_unmap_file(void* data, size_t size);
 
 #ifdef __cplusplus
 }
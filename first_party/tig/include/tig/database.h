@@ -12,6 +12,7 @@ typedef struct TigDatabase TigDatabase;
 typedef struct TigDatabaseEntry TigDatabaseEntry;
 typedef struct TigDatabaseFileHandle TigDatabaseFileHandle;
 typedef struct TigDatabaseFindFileData TigDatabaseFindFileData;
+typedef struct TigDatabaseMapping TigDatabaseMapping;
 
 typedef struct TigDatabase {
     /* 0000 */ char* path;
@@ -22,6 +23,7 @@ typedef struct TigDatabase {
     /* 0014 */ TigGuid guid;
     /* 0024 */ int field_24;
     /* 0028 */ char* name_table;
+    TigDatabaseMapping* mapping;
 } TigDatabase;
 
 #define TIG_DATABASE_ENTRY_PLAIN 0x01
@@ -61,6 +63,7 @@ int tig_database_fflush(TigDatabaseFileHandle* stream);
 TigDatabaseFileHandle* tig_database_fopen(TigDatabase* database, const char* file_name, const char* mode);
 TigDatabaseFileHandle* tig_database_reopen(TigDatabase* database, const char* path, const char* mode, TigDatabaseFileHandle* stream);
 TigDatabaseFileHandle* tig_database_fopen_entry(TigDatabase* database, TigDatabaseEntry* entry, const char* mode);
+TigDatabaseFileHandle* tig_database_fopen_contents(TigDatabase* database, TigDatabaseEntry* entry, const char* mode, TigDatabaseMapping* contents);
 int tig_database_setbuf(TigDatabaseFileHandle* stream, char* buffer);
 int tig_database_setvbuf(TigDatabaseFileHandle* fp, char* buffer, int mode, size_t size);
 int tig_database_vfprintf(TigDatabaseFileHandle* stream, const char* fmt, va_list args);
@@ -82,6 +85,9 @@ void tig_database_rewind(TigDatabaseFileHandle* stream);
 void tig_database_clearerr(TigDatabaseFileHandle* stream);
 int tig_database_feof(TigDatabaseFileHandle* stream);
 int tig_database_ferror(TigDatabaseFileHandle* stream);
+const void* tig_database_map_contents(TigDatabaseFileHandle* stream, TigDatabaseMapping** mapping_ptr);
+void tig_database_unmap_contents(TigDatabaseMapping* mapping);
+bool tig_database_prefetch(TigDatabase* database, TigDatabaseEntry* entry, TigDatabaseMapping** contents_ptr);
 
 #ifdef __cplusplus
 }
@@ -33,6 +33,18 @@ typedef struct TigFileList {
     TigFileInfo* entries;
 } TigFileList;
 
+// Contents of the file obtained with `tig_file_map_contents`.
+//
+// The `data` either points directly into memory-mapped archive (no copy), or
+// to the private buffer the file was read into. In both cases it's read-only
+// and valid until `tig_file_unmap_contents`.
+typedef struct TigFileMapping {
+    const void* data;
+    size_t size;
+    void* buffer;
+    void* database_mapping;
+} TigFileMapping;
+
 bool tig_file_mkdir(const char* path);
 bool tig_file_rmdir(const char* path);
 bool tig_file_empty_directory(const char* path);
@@ -41,6 +53,12 @@ bool tig_file_is_directory(const char* path);
 bool tig_file_copy_directory(const char* dst, const char* src);
 bool tig_file_archive(const char* dst, const char* src);
 bool tig_file_unarchive(const char* src, const char* dst);
+
+// Makes `dst` directory mirror the archive at `src` (without extension). Only
+// files which differ from the archive are written, and files which are not in
+// the archive are removed.
+bool tig_file_unarchive_sync(const char* src, const char* dst);
+
 int tig_file_init(TigInitInfo* init_info);
 void tig_file_exit(void);
 bool tig_file_repository_add(const char* path);
@@ -84,6 +102,35 @@ bool tig_file_lock(const char* filename, const void* owner, size_t size);
 bool tig_file_unlock(const char* filename, const void* owner, size_t size);
 bool tig_file_locked_by(const char* filename, const void* owner, size_t size);
 bool tig_file_copy(const char* src, const char* dst);
+bool tig_file_map_contents(const char* path, TigFileMapping* mapping);
+void tig_file_unmap_contents(TigFileMapping* mapping);
+
+// Where the contents of an archive entry come from, see `tig_file_locate`.
+typedef struct TigFileLocation {
+    char archive_path[TIG_MAX_PATH];
+    uint64_t archive_size;
+    time_t archive_modify_time;
+    unsigned int offset;
+    unsigned int size;
+    unsigned int compressed_size;
+    unsigned int flags;
+} TigFileLocation;
+
+// Finds the archive entry `tig_file_fopen` would read `path` from, along with
+// the identity of the archive itself. Together they change whenever the
+// contents might, which is much cheaper to check than the contents.
+//
+// Returns `false` if the file is missing, or is served from a directory.
+bool tig_file_locate(const char* path, TigFileLocation* location);
+
+// Schedules reading (and inflating) of the archive entry at `path` on a
+// background thread, so that the next `tig_file_fopen` of this file is served
+// from memory. Requests with higher `priority` are processed first.
+//
+// Returns the handle to pass to `tig_file_prefetch_wait`, or `0` when there is
+// nothing to prefetch (the file is missing or is not in an archive).
+unsigned int tig_file_prefetch(const char* path, int priority);
+bool tig_file_prefetch_wait(unsigned int handle);
 
 SDL_IOStream* tig_file_io_open(const char* path, const char* mode);
 
@@ -3,6 +3,7 @@
 
 #include <time.h>
 
+#include "tig/file.h"
 #include "tig/types.h"
 
 #ifdef __cplusplus
@@ -10,11 +11,18 @@ extern "C" {
 #endif
 
 // Represents cached file.
+//
+// The `data` may point right into read-only archive mapping, so it must not be
+// written to.
 typedef struct TigFileCacheEntry {
-    void* data;
+    const void* data;
     int size;
     int index;
     char* path;
+
+    // The file is too big to be kept in cache and has no `data`. Use
+    // `tig_file_cache_entry_open_io` to read it.
+    bool streamed;
 } TigFileCacheEntry;
 
 // An item in file cache.
@@ -22,6 +30,13 @@ typedef struct TigFileCacheItem {
     TigFileCacheEntry entry;
     int refcount;
     time_t timestamp;
+    TigFileMapping mapping;
+    unsigned int hash;
+    int next_hash;
+    int next_free;
+    int lru_prev;
+    int lru_next;
+    bool in_lru;
 } TigFileCacheItem;
 
 // A collection of cached files.
@@ -31,7 +46,14 @@ typedef struct TigFileCache {
     int max_size;
     int bytes;
     int items_count;
-    TigFileCacheItem* items;
+    TigFileCacheItem** blocks;
+    int blocks_count;
+    int stream_size;
+    int* buckets;
+    int buckets_count;
+    int free_head;
+    int lru_head;
+    int lru_tail;
 } TigFileCache;
 
 // Initializes file cache system.
@@ -45,10 +67,16 @@ void tig_file_cache_flush(TigFileCache* cache);
 
 // Creates a new file cache.
 //
-// - `capacity`: total nubmer of files this cache object can manage.
-// - `max_size`: max size of files this cache object can manage.
+// - `capacity`: number of files to make room for up front, the cache grows
+// past it as needed.
+// - `max_size`: max size of files this cache object can manage, unused files
+// are evicted once it is exceeded.
 TigFileCache* tig_file_cache_create(int capacity, int max_size);
 
+// Sets the size of files above which they are streamed instead of being
+// loaded into the cache. Defaults to `max_size`.
+void tig_file_cache_set_stream_size(TigFileCache* cache, int size);
+
 // Destroys the given file cache.
 //
 // NOTE: It's an error to have acquired but not released entries, which is a
@@ -62,6 +90,12 @@ TigFileCacheEntry* tig_file_cache_acquire(TigFileCache* cache, const char* path)
 // Releases access to given entry.
 void tig_file_cache_release(TigFileCache* cache, TigFileCacheEntry* entry);
 
+// Opens a stream over contents of the given entry, which is either a view of
+// cached data, or a stream reading the file on demand (for `streamed`
+// entries). The caller is responsible for closing it, the entry must be kept
+// acquired while the stream is in use.
+SDL_IOStream* tig_file_cache_entry_open_io(TigFileCacheEntry* entry);
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,6 +38,10 @@ void tig_memory_get_system_status(size_t* total, size_t* available);
 // manage memory, allocation functions of this module are never used (at least
 // in Arcanum, one call in ToEE doesn't count). However, their presence imply
 // they were probably used during development, so should we.
+//
+// Define `TIG_DEBUG_MEMORY` to opt in guard bytes and leak tracking (every
+// block is recorded along with the place it was allocated). Otherwise blocks
+// come from the C runtime.
 #ifdef TIG_DEBUG_MEMORY
 #define MALLOC(size) tig_memory_alloc(size, __FILE__, __LINE__)
 #define REALLOC(ptr, size) tig_memory_realloc(ptr, size, __FILE__, __LINE__)
@@ -141,8 +141,12 @@ typedef struct TigArtHeader {
     /* 0064 */ uint8_t* pixels_tbl[MAX_ROTATIONS];
 } TigArtHeader;
 
+#define TIG_ART_CACHE_ENTRY_USED 0x01
 #define TIG_ART_CACHE_ENTRY_MODIFIED 0x02
 
+// Cache entries live in slots which never change their index. Used slots are
+// linked in the LRU list (least recently used first) and in the hash chains
+// keyed on path, free slots are chained through `lru_next`.
 typedef struct TigArtCacheEntry {
     /* 0000 */ unsigned int flags;
     /* 0004 */ char path[TIG_MAX_PATH];
@@ -155,27 +159,88 @@ typedef struct TigArtCacheEntry {
     /* 0254 */ TigPalette* palette_tbl[MAX_PALETTES];
     /* 0264 */ art_size_t system_memory_usage;
     /* 0268 */ art_size_t video_memory_usage;
+    unsigned int hash;
+    int hash_next;
+    int lru_prev;
+    int lru_next;
+    unsigned int generation;
 } TigArtCacheEntry;
 
+// Size of the direct-mapped art_id lookup table (must be power of two).
+#define TIG_ART_CACHE_ID_TABLE_SIZE 4096
+#define TIG_ART_CACHE_ID_TABLE_BITS 12
+
+// Remembers which slot the art_id resolved to. The slot is only trusted when
+// its generation matches, i.e. it was not evicted and reused since.
+typedef struct TigArtCacheIdTableEntry {
+    tig_art_id_t art_id;
+    int cache_entry_index;
+    unsigned int generation;
+} TigArtCacheIdTableEntry;
+
+// Sequential reader over ART file contents borrowed with
+// `tig_file_map_contents`.
+typedef struct TigArtReader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+} TigArtReader;
+
+// Minimum number of pixels for the blit to go through vectorized row blitter
+// (tables are built per blit, so it doesn't pay off for tiny blits).
+#define TIG_ART_BLIT_ROW_MIN_PIXELS 256
+
+#define TIG_ART_BLIT_ROW_COPY 0
+#define TIG_ART_BLIT_ROW_ADD 1
+#define TIG_ART_BLIT_ROW_SUB 2
+#define TIG_ART_BLIT_ROW_MUL 3
+#define TIG_ART_BLIT_ROW_BLEND 4
+
+// Per-blit state of the vectorized unstretched blitter. Every palette index
+// is resolved in advance with the same color functions the regular code uses,
+// so vector code only has to combine the result with destination.
+typedef struct TigArtBlitRowInfo {
+    int op;
+    uint32_t alpha_mask;
+    // Source color for every palette index (with the constant color applied).
+    uint32_t colors[256];
+    // Blend factor for every palette index (`TIG_ART_BLIT_ROW_BLEND` only).
+    uint32_t alphas[256];
+} TigArtBlitRowInfo;
+
+typedef void(TigArtBlitRowFunc)(uint32_t* dst, const uint8_t* src, int src_step, int count, const TigArtBlitRowInfo* info);
+
 static int art_get_video_buffer(int cache_entry_index, tig_art_id_t art_id, TigVideoBuffer** video_buffer_ptr);
 static int sub_505940(unsigned int art_blt_flags, unsigned int* vb_blt_flags_ptr);
 static int sub_5059F0(int cache_entry_index, TigArtBlitInfo* blit_info);
 static int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info);
 static int sub_51AA90(tig_art_id_t art_id);
 static void tig_art_cache_check_fullness(void);
-static int tig_art_cache_entry_compare_time(const void* va, const void* vb);
-static int tig_art_cache_entry_compare_name(const void* va, const void* vb);
 static int tig_art_build_path(unsigned int art_id, char* path, size_t maxlen);
-static bool tig_art_cache_find(const char* path, int* index);
+static unsigned int tig_art_cache_hash(const char* path);
+static bool tig_art_cache_find(const char* path, unsigned int hash, int* index);
+static int tig_art_cache_slot_alloc(void);
+static void tig_art_cache_slot_free(int cache_entry_index);
+static void tig_art_cache_buckets_resize(void);
+static void tig_art_cache_link(int cache_entry_index, unsigned int hash);
+static void tig_art_cache_unlink(int cache_entry_index);
+static void tig_art_cache_touch(int cache_entry_index);
+static void tig_art_cache_reset(void);
+static TigArtCacheIdTableEntry* tig_art_cache_id_table_entry(tig_art_id_t art_id);
 static bool tig_art_cache_entry_load(tig_art_id_t art_id, const char* path, int index);
 static void tig_art_cache_entry_unload(int cache_entry_index);
 static void art_invalidate(int cache_entry_index);
 static void sub_51B650(int cache_entry_index);
 static int sub_51B710(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, TigPalette** palettes, int a5, art_size_t* size_ptr);
 static int sub_51BE30(TigArtHeader* hdr);
-static void sub_51BE50(TigFile* stream, TigArtHeader* hdr, TigPalette** palette_tbl);
+static void sub_51BE50(TigFileMapping* mapping, TigArtHeader* hdr, TigPalette** palette_tbl);
 static void sub_51BF20(TigArtHeader* hdr);
-static bool art_read_header(TigArtHeader* hdr, TigFile* stream);
+static bool art_read_header(TigArtHeader* hdr, TigArtReader* reader);
+static bool art_read(TigArtReader* reader, void* buffer, size_t size);
+static int* tig_art_blit_stretch_advance(int count, float ratio);
+static void tig_art_blit_row_init(void);
+static bool tig_art_blit_row_info_init(TigArtBlitInfo* blit_info, TigPalette* plt, int pixels, TigArtBlitRowInfo* info);
+static void tig_art_blit_row_tail(uint32_t* dst, const uint8_t* src, int src_step, int count, const TigArtBlitRowInfo* info);
 
 // 0x5BE880
 static int dword_5BE880[16] = {
@@ -335,6 +400,25 @@ static int tig_art_cache_entries_length;
 // 0x604720
 static TigArtCacheEntry* tig_art_cache_entries;
 
+// Hash index of used cache slots.
+static int* tig_art_cache_buckets;
+static unsigned int tig_art_cache_buckets_mask;
+
+// Ends of the LRU list (least recently used first).
+static int tig_art_cache_lru_head;
+static int tig_art_cache_lru_tail;
+
+// Head of the free slots list.
+static int tig_art_cache_free_head;
+
+// Incremented every time slot is filled, see `TigArtCacheIdTableEntry`.
+static unsigned int tig_art_cache_generation;
+
+// Fast art_id lookup in front of path-based lookup.
+static TigArtCacheIdTableEntry tig_art_cache_id_table[TIG_ART_CACHE_ID_TABLE_SIZE];
+
+static TigArtCacheStats tig_art_cache_stats;
+
 // 0x604724
 static art_size_t tig_art_total_system_memory;
 
@@ -368,6 +452,13 @@ static TigArtIdResetFunc tig_art_id_reset_func;
 // 0x604754
 static int dword_604754;
 
+// Vectorized row blitter selected for this CPU, `NULL` if there is none.
+static TigArtBlitRowFunc* tig_art_blit_row_func;
+
+// Scratch buffer of `tig_art_blit_stretch_advance`.
+static int* tig_art_blit_stretch_advance_buffer;
+static int tig_art_blit_stretch_advance_capacity;
+
 // 0x500590
 int tig_art_init(TigInitInfo* init_info)
 {
@@ -381,6 +472,8 @@ int tig_art_init(TigInitInfo* init_info)
     tig_art_cache_entries_capacity = 512;
     tig_art_cache_entries_length = 0;
     tig_art_cache_entries = (TigArtCacheEntry*)MALLOC(sizeof(TigArtCacheEntry) * tig_art_cache_entries_capacity);
+    tig_art_cache_buckets_resize();
+    tig_art_cache_reset();
 
     tig_memory_get_system_status(&total_memory, &available_memory);
 
@@ -405,6 +498,8 @@ int tig_art_init(TigInitInfo* init_info)
 
     tig_art_hardware_accelerated = tig_video_3d_check_initialized() == TIG_OK;
 
+    tig_art_blit_row_init();
+
     return TIG_OK;
 }
 
@@ -412,6 +507,14 @@ int tig_art_init(TigInitInfo* init_info)
 void tig_art_exit(void)
 {
     if (tig_art_initialized) {
+        if (tig_art_cache_stats.id_hits + tig_art_cache_stats.path_hits + tig_art_cache_stats.misses != 0) {
+            tig_debug_printf("Art cache: %u id hits, %u path hits, %u misses (%.1f%% id hit rate)\n",
+                tig_art_cache_stats.id_hits,
+                tig_art_cache_stats.path_hits,
+                tig_art_cache_stats.misses,
+                100.0 * tig_art_cache_stats.id_hits / (tig_art_cache_stats.id_hits + tig_art_cache_stats.path_hits + tig_art_cache_stats.misses));
+        }
+
         tig_art_flush();
 
         if (tig_art_cache_entries != NULL) {
@@ -421,6 +524,18 @@ void tig_art_exit(void)
             tig_art_cache_entries_capacity = 0;
         }
 
+        if (tig_art_cache_buckets != NULL) {
+            FREE(tig_art_cache_buckets);
+            tig_art_cache_buckets = NULL;
+            tig_art_cache_buckets_mask = 0;
+        }
+
+        if (tig_art_blit_stretch_advance_buffer != NULL) {
+            FREE(tig_art_blit_stretch_advance_buffer);
+            tig_art_blit_stretch_advance_buffer = NULL;
+            tig_art_blit_stretch_advance_capacity = 0;
+        }
+
         tig_art_initialized = false;
     }
 }
@@ -455,10 +570,12 @@ void tig_art_flush(void)
     }
 
     for (index = 0; index < tig_art_cache_entries_length; index++) {
-        tig_art_cache_entry_unload(index);
+        if ((tig_art_cache_entries[index].flags & TIG_ART_CACHE_ENTRY_USED) != 0) {
+            tig_art_cache_entry_unload(index);
+        }
     }
 
-    tig_art_cache_entries_length = 0;
+    tig_art_cache_reset();
 }
 
 // 0x502220
@@ -508,6 +625,10 @@ void sub_5022D0(void)
     unsigned int palette;
 
     for (index = 0; index < tig_art_cache_entries_length; index++) {
+        if ((tig_art_cache_entries[index].flags & TIG_ART_CACHE_ENTRY_USED) == 0) {
+            continue;
+        }
+
         for (palette = 0; palette < MAX_PALETTES; palette++) {
             if (tig_art_cache_entries[index].hdr.palette_tbl[palette] != NULL) {
                 sub_505000(tig_art_cache_entries[index].art_id,
@@ -3074,6 +3195,7 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
     int src_checkerboard_cur_y;
     int dst_checkerboard_cur_x;
     int dst_checkerboard_cur_y;
+    TigArtBlitRowInfo row_info;
 
     rc = tig_video_buffer_lock(blit_info->dst_video_buffer);
     if (rc != TIG_OK) {
@@ -3269,8 +3391,12 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
     if (stretched) {
         float width_error;
         float height_error;
+        int* src_advance;
         uint8_t* prev_src_pixels = src_pixels;
 
+        // Horizontal stepping through the source is the same for every row.
+        src_advance = tig_art_blit_stretch_advance(dst_rect.width, width_ratio);
+
         if ((blit_info->flags & TIG_ART_BLT_BLEND_COLOR_CONST) != 0) {
             if ((blit_info->flags & TIG_ART_BLT_BLEND_ADD) != 0) {
                 // 0x5126AA
@@ -3278,18 +3404,13 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 uint32_t color = tig_color_mul(plt->colors[*src_pixels], blit_info->color);
                                 *(uint32_t*)dst_pixels = tig_color_add(*(uint32_t*)dst_pixels, color);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3312,18 +3433,13 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_sub(tig_color_mul(plt->colors[*src_pixels], blit_info->color),
                                     *(uint32_t*)dst_pixels);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3346,18 +3462,13 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 uint32_t color = tig_color_mul(plt->colors[*src_pixels], blit_info->color);
                                 *(uint32_t*)dst_pixels = tig_color_mul(color, *(uint32_t*)dst_pixels);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3380,7 +3491,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 uint32_t color = tig_color_mul(plt->colors[*src_pixels], blit_info->color);
@@ -3389,11 +3499,7 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                     tig_color_rgb_to_grayscale(color));
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3416,7 +3522,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_blend_alpha(tig_color_mul(plt->colors[*src_pixels], blit_info->color),
@@ -3424,11 +3529,7 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                     blit_info->alpha[0]);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3451,7 +3552,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_blend_alpha(blit_info->color,
@@ -3459,11 +3559,7 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                     tig_color_alpha(plt->colors[*src_pixels]));
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3554,7 +3650,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (((src_checkerboard_cur_x ^ src_checkerboard_cur_y) & 1) != 0) {
                                 if (*src_pixels != 0) {
@@ -3562,12 +3657,8 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                 }
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                src_checkerboard_cur_x++;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
+                            src_checkerboard_cur_x += src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3592,7 +3683,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (((dst_checkerboard_cur_x ^ dst_checkerboard_cur_y) & 1) != 0) {
                                 if (*src_pixels != 0) {
@@ -3600,12 +3690,8 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                 }
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                dst_checkerboard_cur_x++;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
+                            dst_checkerboard_cur_x += src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3630,17 +3716,12 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_mul(plt->colors[*src_pixels], blit_info->color);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3667,19 +3748,14 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                     for (y = 0; y < dst_rect.height; y++) {
                         mask = &(blit_info->field_14[src_rect.x]);
 
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 uint32_t color = tig_color_mul(plt->colors[*src_pixels], *mask);
                                 *(uint32_t*)dst_pixels = tig_color_add(*(uint32_t*)dst_pixels, color);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                mask++;
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            mask += src_advance[x];
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3704,19 +3780,14 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                     for (y = 0; y < dst_rect.height; y++) {
                         mask = &(blit_info->field_14[src_rect.x]);
 
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_sub(tig_color_mul(plt->colors[*src_pixels], *mask),
                                     *(uint32_t*)dst_pixels);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                mask++;
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            mask += src_advance[x];
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3741,19 +3812,14 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                     for (y = 0; y < dst_rect.height; y++) {
                         mask = &(blit_info->field_14[src_rect.x]);
 
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 uint32_t color = tig_color_mul(plt->colors[*src_pixels], *mask);
                                 *(uint32_t*)dst_pixels = tig_color_mul(color, *(uint32_t*)dst_pixels);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                mask++;
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            mask += src_advance[x];
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3778,7 +3844,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                     for (y = 0; y < dst_rect.height; y++) {
                         mask = &(blit_info->field_14[src_rect.x]);
 
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 uint32_t color = tig_color_mul(plt->colors[*src_pixels], *mask);
@@ -3787,12 +3852,8 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                     tig_color_rgb_to_grayscale(color));
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                mask++;
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            mask += src_advance[x];
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3817,7 +3878,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                     for (y = 0; y < dst_rect.height; y++) {
                         mask = &(blit_info->field_14[src_rect.x]);
 
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 uint32_t color = tig_color_mul(plt->colors[*src_pixels], *mask);
@@ -3826,12 +3886,8 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                     blit_info->alpha[0]);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                mask++;
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            mask += src_advance[x];
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3856,7 +3912,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                     for (y = 0; y < dst_rect.height; y++) {
                         mask = &(blit_info->field_14[src_rect.x]);
 
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_blend_alpha(*mask,
@@ -3864,12 +3919,8 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                     tig_color_alpha(plt->colors[*src_pixels]));
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                mask++;
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            mask += src_advance[x];
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -3965,7 +4016,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                     for (y = 0; y < dst_rect.height; y++) {
                         mask = &(blit_info->field_14[src_rect.x]);
 
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (((src_checkerboard_cur_x ^ src_checkerboard_cur_y) & 1) != 0) {
                                 if (*src_pixels != 0) {
@@ -3973,13 +4023,9 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                 }
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                mask++;
-                                src_pixels += src_step;
-                                src_checkerboard_cur_x++;
-                                width_error -= 1.0f;
-                            }
+                            mask += src_advance[x];
+                            src_pixels += src_step * src_advance[x];
+                            src_checkerboard_cur_x += src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -4006,7 +4052,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                     for (y = 0; y < dst_rect.height; y++) {
                         mask = &(blit_info->field_14[src_rect.x]);
 
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (((dst_checkerboard_cur_x ^ dst_checkerboard_cur_y) & 1) != 0) {
                                 if (*src_pixels != 0) {
@@ -4014,13 +4059,9 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                 }
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                mask++;
-                                src_pixels += src_step;
-                                dst_checkerboard_cur_x++;
-                                width_error -= 1.0f;
-                            }
+                            mask += src_advance[x];
+                            src_pixels += src_step * src_advance[x];
+                            dst_checkerboard_cur_x += src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -4047,18 +4088,13 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                     for (y = 0; y < dst_rect.height; y++) {
                         mask = &(blit_info->field_14[src_rect.x]);
 
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_mul(plt->colors[*src_pixels], *mask);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                mask++;
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            mask += src_advance[x];
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -4086,18 +4122,13 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_add(plt->colors[*src_pixels],
                                     *(uint32_t*)dst_pixels);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -4120,18 +4151,13 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_sub(plt->colors[*src_pixels],
                                     *(uint32_t*)dst_pixels);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -4154,18 +4180,13 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_mul(plt->colors[*src_pixels],
                                     *(uint32_t*)dst_pixels);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -4188,7 +4209,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_blend_alpha(plt->colors[*src_pixels],
@@ -4196,11 +4216,7 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                     tig_color_rgb_to_grayscale(plt->colors[*src_pixels]));
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -4223,7 +4239,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_blend_alpha(plt->colors[*src_pixels],
@@ -4231,11 +4246,7 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                     blit_info->alpha[0]);
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -4258,7 +4269,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = tig_color_blend_alpha(plt->colors[*src_pixels],
@@ -4266,11 +4276,7 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                     tig_color_alpha(plt->colors[*src_pixels]));
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -4361,7 +4367,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (((src_checkerboard_cur_x ^ src_checkerboard_cur_y) & 1) != 0) {
                                 if (*src_pixels != 0) {
@@ -4369,12 +4374,8 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                 }
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                src_checkerboard_cur_x++;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
+                            src_checkerboard_cur_x += src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -4399,7 +4400,6 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (((dst_checkerboard_cur_x ^ dst_checkerboard_cur_y) & 1) != 0) {
                                 if (*src_pixels != 0) {
@@ -4407,12 +4407,8 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                                 }
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                dst_checkerboard_cur_x++;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
+                            dst_checkerboard_cur_x += src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -4437,17 +4433,12 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
                 case 32:
                     height_error = 0.5f;
                     for (y = 0; y < dst_rect.height; y++) {
-                        width_error = 0.5f;
                         for (x = 0; x < dst_rect.width; x++) {
                             if (*src_pixels != 0) {
                                 *(uint32_t*)dst_pixels = plt->colors[*src_pixels];
                             }
 
-                            width_error += width_ratio;
-                            while (width_error > 1.0f) {
-                                src_pixels += src_step;
-                                width_error -= 1.0f;
-                            }
+                            src_pixels += src_step * src_advance[x];
 
                             dst_pixels += 4;
                         }
@@ -4467,7 +4458,13 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
             }
         }
     } else {
-        if ((blit_info->flags & TIG_ART_BLT_BLEND_COLOR_CONST) != 0) {
+        if (tig_art_blit_row_info_init(blit_info, plt, dst_rect.width * dst_rect.height, &row_info)) {
+            for (y = 0; y < dst_rect.height; y++) {
+                tig_art_blit_row_func((uint32_t*)dst_pixels, src_pixels, src_step, dst_rect.width, &row_info);
+                src_pixels += src_step * dst_rect.width + src_pitch;
+                dst_pixels += 4 * dst_rect.width + dst_skip;
+            }
+        } else if ((blit_info->flags & TIG_ART_BLT_BLEND_COLOR_CONST) != 0) {
             // 0x5084E9
             if ((blit_info->flags & TIG_ART_BLT_BLEND_ADD) != 0) {
                 // 0x5084F5
@@ -5288,19 +5285,558 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
     return TIG_OK;
 }
 
+// Calculates how many source columns the stretched blit advances after every
+// destination column.
+//
+// NOTE: The table is produced with exactly the same float error accumulator
+// the per-pixel code used to run for every row, so the output is the same
+// pixel for pixel.
+int* tig_art_blit_stretch_advance(int count, float ratio)
+{
+    float error;
+    int x;
+
+    if (count > tig_art_blit_stretch_advance_capacity) {
+        tig_art_blit_stretch_advance_capacity = count;
+        tig_art_blit_stretch_advance_buffer = (int*)REALLOC(tig_art_blit_stretch_advance_buffer,
+            sizeof(*tig_art_blit_stretch_advance_buffer) * tig_art_blit_stretch_advance_capacity);
+    }
+
+    error = 0.5f;
+    for (x = 0; x < count; x++) {
+        tig_art_blit_stretch_advance_buffer[x] = 0;
+
+        error += ratio;
+        while (error > 1.0f) {
+            tig_art_blit_stretch_advance_buffer[x]++;
+            error -= 1.0f;
+        }
+    }
+
+    return tig_art_blit_stretch_advance_buffer;
+}
+
+// Builds tables for the vectorized unstretched blitter. Returns `false` when
+// the blit should go through the regular per-pixel code.
+bool tig_art_blit_row_info_init(TigArtBlitInfo* blit_info, TigPalette* plt, int pixels, TigArtBlitRowInfo* info)
+{
+    unsigned int flags;
+    bool color_const;
+    tig_color_t color;
+    int index;
+
+    if (tig_art_blit_row_func == NULL
+        || tig_art_bits_per_pixel != 32
+        || pixels < TIG_ART_BLIT_ROW_MIN_PIXELS) {
+        return false;
+    }
+
+    // The vectorized code operates on bytes, so color components must occupy
+    // separate bytes, with alpha (if any) in the remaining one.
+    if (tig_color_red_mask != 0xFF0000
+        || tig_color_green_mask != 0xFF00
+        || tig_color_blue_mask != 0xFF
+        || (tig_color_alpha_mask & 0xFFFFFF) != 0) {
+        return false;
+    }
+
+    // Mode selection mirrors the order of checks in `art_blit`.
+    flags = blit_info->flags;
+    if ((flags & TIG_ART_BLT_BLEND_COLOR_CONST) != 0) {
+        color_const = true;
+    } else if ((flags & (TIG_ART_BLT_BLEND_COLOR_ARRAY | TIG_ART_BLT_BLEND_COLOR_LERP)) != 0) {
+        return false;
+    } else {
+        color_const = false;
+    }
+
+    if ((flags & TIG_ART_BLT_BLEND_ADD) != 0) {
+        info->op = TIG_ART_BLIT_ROW_ADD;
+    } else if ((flags & TIG_ART_BLT_BLEND_SUB) != 0) {
+        info->op = TIG_ART_BLIT_ROW_SUB;
+    } else if ((flags & TIG_ART_BLT_BLEND_MUL) != 0) {
+        info->op = TIG_ART_BLIT_ROW_MUL;
+    } else if ((flags & (TIG_ART_BLT_BLEND_ALPHA_AVG | TIG_ART_BLT_BLEND_ALPHA_CONST | TIG_ART_BLT_BLEND_ALPHA_SRC)) != 0) {
+        info->op = TIG_ART_BLIT_ROW_BLEND;
+    } else if ((flags & (TIG_ART_BLT_BLEND_ALPHA_LERP_ANY | TIG_ART_BLT_BLEND_ALPHA_STIPPLE_S | TIG_ART_BLT_BLEND_ALPHA_STIPPLE_D)) != 0) {
+        return false;
+    } else {
+        info->op = TIG_ART_BLIT_ROW_COPY;
+    }
+
+    info->alpha_mask = tig_color_alpha_mask;
+
+    for (index = 0; index < 256; index++) {
+        color = plt->colors[index];
+        if (color_const) {
+            color = tig_color_mul(color, blit_info->color);
+        }
+        info->colors[index] = color;
+    }
+
+    if (info->op == TIG_ART_BLIT_ROW_BLEND) {
+        // NOTE: Only low 16 bits of alpha affect the result of
+        // `tig_color_blend_alpha` (grayscale "alpha" is a full color).
+        if ((flags & TIG_ART_BLT_BLEND_ALPHA_AVG) != 0) {
+            for (index = 0; index < 256; index++) {
+                info->alphas[index] = tig_color_rgb_to_grayscale(info->colors[index]) & 0xFFFF;
+            }
+        } else if ((flags & TIG_ART_BLT_BLEND_ALPHA_CONST) != 0) {
+            for (index = 0; index < 256; index++) {
+                info->alphas[index] = blit_info->alpha[0];
+            }
+        } else {
+            for (index = 0; index < 256; index++) {
+                info->alphas[index] = (uint32_t)tig_color_alpha(plt->colors[index]);
+                if (color_const) {
+                    info->colors[index] = blit_info->color;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// Scalar counterpart of the vector code for a single (non-transparent) pixel.
+static inline uint32_t tig_art_blit_row_pixel(const TigArtBlitRowInfo* info, uint8_t index, uint32_t dst)
+{
+    switch (info->op) {
+    case TIG_ART_BLIT_ROW_ADD:
+        return tig_color_add(info->colors[index], dst);
+    case TIG_ART_BLIT_ROW_SUB:
+        return tig_color_sub(info->colors[index], dst);
+    case TIG_ART_BLIT_ROW_MUL:
+        return tig_color_mul(info->colors[index], dst);
+    case TIG_ART_BLIT_ROW_BLEND:
+        return tig_color_blend_alpha(info->colors[index], dst, (int)info->alphas[index]);
+    default:
+        return info->colors[index];
+    }
+}
+
+// Processes the remainder of the row which is too short for vector code.
+void tig_art_blit_row_tail(uint32_t* dst, const uint8_t* src, int src_step, int count, const TigArtBlitRowInfo* info)
+{
+    int x;
+
+    for (x = 0; x < count; x++) {
+        if (*src != 0) {
+            dst[x] = tig_art_blit_row_pixel(info, *src, dst[x]);
+        }
+        src += src_step;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+// Blends four pixels. Components are widened to 16 bits, so the code below
+// matches `tig_color_mul` and `tig_color_blend_alpha` bit for bit:
+//   - `a * b / 255 == (a * b + 1 + ((a * b) >> 8)) >> 8` for all 8-bit a, b,
+//   - `tig_color_blend_alpha` yields `(d + (((s - d) * alpha) >> 8)) & 0xFF`
+//     per component, where only low 16 bits of the product matter.
+SDL_TARGETING("sse2") static __m128i tig_art_blit_row_op_sse2(__m128i src, __m128i dst, __m128i alphas, const TigArtBlitRowInfo* info)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i rgb_mask = _mm_set1_epi32(0xFFFFFF);
+    __m128i alpha_mask = _mm_set1_epi32((int)info->alpha_mask);
+    __m128i src_lo;
+    __m128i src_hi;
+    __m128i dst_lo;
+    __m128i dst_hi;
+    __m128i alpha_lo;
+    __m128i alpha_hi;
+    __m128i one;
+    __m128i byte_mask;
+    __m128i res;
+
+    switch (info->op) {
+    case TIG_ART_BLIT_ROW_ADD:
+        res = _mm_adds_epu8(src, dst);
+        break;
+    case TIG_ART_BLIT_ROW_SUB:
+        res = _mm_subs_epu8(dst, src);
+        break;
+    case TIG_ART_BLIT_ROW_MUL:
+        one = _mm_set1_epi16(1);
+        src_lo = _mm_unpacklo_epi8(src, zero);
+        src_hi = _mm_unpackhi_epi8(src, zero);
+        dst_lo = _mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), src_lo);
+        dst_hi = _mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), src_hi);
+        dst_lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(dst_lo, one), _mm_srli_epi16(dst_lo, 8)), 8);
+        dst_hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(dst_hi, one), _mm_srli_epi16(dst_hi, 8)), 8);
+        res = _mm_packus_epi16(dst_lo, dst_hi);
+        break;
+    case TIG_ART_BLIT_ROW_BLEND:
+        byte_mask = _mm_set1_epi16(0xFF);
+        // Replicate alpha of every pixel to all four 16-bit components.
+        alphas = _mm_or_si128(alphas, _mm_slli_epi32(alphas, 16));
+        alpha_lo = _mm_unpacklo_epi32(alphas, alphas);
+        alpha_hi = _mm_unpackhi_epi32(alphas, alphas);
+        dst_lo = _mm_unpacklo_epi8(dst, zero);
+        dst_hi = _mm_unpackhi_epi8(dst, zero);
+        src_lo = _mm_mullo_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(src, zero), dst_lo), alpha_lo);
+        src_hi = _mm_mullo_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(src, zero), dst_hi), alpha_hi);
+        dst_lo = _mm_and_si128(_mm_add_epi16(dst_lo, _mm_srli_epi16(src_lo, 8)), byte_mask);
+        dst_hi = _mm_and_si128(_mm_add_epi16(dst_hi, _mm_srli_epi16(src_hi, 8)), byte_mask);
+        res = _mm_packus_epi16(dst_lo, dst_hi);
+        break;
+    default:
+        return src;
+    }
+
+    return _mm_or_si128(_mm_and_si128(res, rgb_mask), alpha_mask);
+}
+
+SDL_TARGETING("sse2") static void tig_art_blit_row_sse2(uint32_t* dst, const uint8_t* src, int src_step, int count, const TigArtBlitRowInfo* info)
+{
+    uint8_t indices[8];
+    __m128i zero = _mm_setzero_si128();
+    __m128i src_lo;
+    __m128i src_hi;
+    __m128i alphas_lo;
+    __m128i alphas_hi;
+    __m128i keep_lo;
+    __m128i keep_hi;
+    __m128i dst_lo;
+    __m128i dst_hi;
+    int x;
+    int k;
+
+    alphas_lo = zero;
+    alphas_hi = zero;
+
+    for (x = 0; x + 8 <= count; x += 8) {
+        for (k = 0; k < 8; k++) {
+            indices[k] = *src;
+            src += src_step;
+        }
+
+        // Skip fully transparent runs without touching destination.
+        if ((indices[0] | indices[1] | indices[2] | indices[3] | indices[4] | indices[5] | indices[6] | indices[7]) == 0) {
+            continue;
+        }
+
+        src_lo = _mm_setr_epi32((int)info->colors[indices[0]],
+            (int)info->colors[indices[1]],
+            (int)info->colors[indices[2]],
+            (int)info->colors[indices[3]]);
+        src_hi = _mm_setr_epi32((int)info->colors[indices[4]],
+            (int)info->colors[indices[5]],
+            (int)info->colors[indices[6]],
+            (int)info->colors[indices[7]]);
+        if (info->op == TIG_ART_BLIT_ROW_BLEND) {
+            alphas_lo = _mm_setr_epi32((int)info->alphas[indices[0]],
+                (int)info->alphas[indices[1]],
+                (int)info->alphas[indices[2]],
+                (int)info->alphas[indices[3]]);
+            alphas_hi = _mm_setr_epi32((int)info->alphas[indices[4]],
+                (int)info->alphas[indices[5]],
+                (int)info->alphas[indices[6]],
+                (int)info->alphas[indices[7]]);
+        }
+
+        keep_lo = _mm_cmpeq_epi32(_mm_setr_epi32(indices[0], indices[1], indices[2], indices[3]), zero);
+        keep_hi = _mm_cmpeq_epi32(_mm_setr_epi32(indices[4], indices[5], indices[6], indices[7]), zero);
+
+        dst_lo = _mm_loadu_si128((const __m128i*)(dst + x));
+        dst_hi = _mm_loadu_si128((const __m128i*)(dst + x + 4));
+
+        src_lo = tig_art_blit_row_op_sse2(src_lo, dst_lo, alphas_lo, info);
+        src_hi = tig_art_blit_row_op_sse2(src_hi, dst_hi, alphas_hi, info);
+
+        _mm_storeu_si128((__m128i*)(dst + x), _mm_or_si128(_mm_and_si128(keep_lo, dst_lo), _mm_andnot_si128(keep_lo, src_lo)));
+        _mm_storeu_si128((__m128i*)(dst + x + 4), _mm_or_si128(_mm_and_si128(keep_hi, dst_hi), _mm_andnot_si128(keep_hi, src_hi)));
+    }
+
+    tig_art_blit_row_tail(dst + x, src, src_step, count - x, info);
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_AVX2_INTRINSICS
+// Same as `tig_art_blit_row_op_sse2`, eight pixels at a time.
+SDL_TARGETING("avx2") static __m256i tig_art_blit_row_op_avx2(__m256i src, __m256i dst, __m256i alphas, const TigArtBlitRowInfo* info)
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m256i rgb_mask = _mm256_set1_epi32(0xFFFFFF);
+    __m256i alpha_mask = _mm256_set1_epi32((int)info->alpha_mask);
+    __m256i src_lo;
+    __m256i src_hi;
+    __m256i dst_lo;
+    __m256i dst_hi;
+    __m256i alpha_lo;
+    __m256i alpha_hi;
+    __m256i one;
+    __m256i byte_mask;
+    __m256i res;
+
+    switch (info->op) {
+    case TIG_ART_BLIT_ROW_ADD:
+        res = _mm256_adds_epu8(src, dst);
+        break;
+    case TIG_ART_BLIT_ROW_SUB:
+        res = _mm256_subs_epu8(dst, src);
+        break;
+    case TIG_ART_BLIT_ROW_MUL:
+        one = _mm256_set1_epi16(1);
+        src_lo = _mm256_unpacklo_epi8(src, zero);
+        src_hi = _mm256_unpackhi_epi8(src, zero);
+        dst_lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(dst, zero), src_lo);
+        dst_hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(dst, zero), src_hi);
+        dst_lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(dst_lo, one), _mm256_srli_epi16(dst_lo, 8)), 8);
+        dst_hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(dst_hi, one), _mm256_srli_epi16(dst_hi, 8)), 8);
+        res = _mm256_packus_epi16(dst_lo, dst_hi);
+        break;
+    case TIG_ART_BLIT_ROW_BLEND:
+        byte_mask = _mm256_set1_epi16(0xFF);
+        alphas = _mm256_or_si256(alphas, _mm256_slli_epi32(alphas, 16));
+        alpha_lo = _mm256_unpacklo_epi32(alphas, alphas);
+        alpha_hi = _mm256_unpackhi_epi32(alphas, alphas);
+        dst_lo = _mm256_unpacklo_epi8(dst, zero);
+        dst_hi = _mm256_unpackhi_epi8(dst, zero);
+        src_lo = _mm256_mullo_epi16(_mm256_sub_epi16(_mm256_unpacklo_epi8(src, zero), dst_lo), alpha_lo);
+        src_hi = _mm256_mullo_epi16(_mm256_sub_epi16(_mm256_unpackhi_epi8(src, zero), dst_hi), alpha_hi);
+        dst_lo = _mm256_and_si256(_mm256_add_epi16(dst_lo, _mm256_srli_epi16(src_lo, 8)), byte_mask);
+        dst_hi = _mm256_and_si256(_mm256_add_epi16(dst_hi, _mm256_srli_epi16(src_hi, 8)), byte_mask);
+        res = _mm256_packus_epi16(dst_lo, dst_hi);
+        break;
+    default:
+        return src;
+    }
+
+    return _mm256_or_si256(_mm256_and_si256(res, rgb_mask), alpha_mask);
+}
+
+SDL_TARGETING("avx2") static void tig_art_blit_row_avx2(uint32_t* dst, const uint8_t* src, int src_step, int count, const TigArtBlitRowInfo* info)
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m256i indices;
+    __m256i colors;
+    __m256i alphas;
+    __m256i keep;
+    __m256i pixels;
+    uint64_t run;
+    int x;
+
+    alphas = zero;
+
+    for (x = 0; x + 8 <= count; x += 8) {
+        if (src_step == 1) {
+            SDL_memcpy(&run, src, sizeof(run));
+            src += 8;
+
+            // Skip fully transparent runs without touching destination.
+            if (run == 0) {
+                continue;
+            }
+
+            indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)&run));
+        } else {
+            indices = _mm256_setr_epi32(src[0],
+                src[src_step],
+                src[2 * src_step],
+                src[3 * src_step],
+                src[4 * src_step],
+                src[5 * src_step],
+                src[6 * src_step],
+                src[7 * src_step]);
+            src += 8 * src_step;
+
+            if (_mm256_testz_si256(indices, indices)) {
+                continue;
+            }
+        }
+
+        colors = _mm256_i32gather_epi32((const int*)info->colors, indices, 4);
+        if (info->op == TIG_ART_BLIT_ROW_BLEND) {
+            alphas = _mm256_i32gather_epi32((const int*)info->alphas, indices, 4);
+        }
+
+        keep = _mm256_cmpeq_epi32(indices, zero);
+        pixels = _mm256_loadu_si256((const __m256i*)(dst + x));
+        colors = tig_art_blit_row_op_avx2(colors, pixels, alphas, info);
+        _mm256_storeu_si256((__m256i*)(dst + x), _mm256_blendv_epi8(colors, pixels, keep));
+    }
+
+    tig_art_blit_row_tail(dst + x, src, src_step, count - x, info);
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+// NEON counterpart of `tig_art_blit_row_op_sse2`, four pixels at a time.
+static uint32x4_t tig_art_blit_row_op_neon(uint32x4_t src, uint32x4_t dst, const uint32_t* alphas, const TigArtBlitRowInfo* info)
+{
+    uint8x16_t src8 = vreinterpretq_u8_u32(src);
+    uint8x16_t dst8 = vreinterpretq_u8_u32(dst);
+    uint16x8_t src_lo;
+    uint16x8_t src_hi;
+    uint16x8_t dst_lo;
+    uint16x8_t dst_hi;
+    uint16x8_t alpha_lo;
+    uint16x8_t alpha_hi;
+    uint16_t alpha_components[16];
+    uint8x16_t res;
+    int k;
+
+    switch (info->op) {
+    case TIG_ART_BLIT_ROW_ADD:
+        res = vqaddq_u8(src8, dst8);
+        break;
+    case TIG_ART_BLIT_ROW_SUB:
+        res = vqsubq_u8(dst8, src8);
+        break;
+    case TIG_ART_BLIT_ROW_MUL:
+        dst_lo = vmull_u8(vget_low_u8(src8), vget_low_u8(dst8));
+        dst_hi = vmull_u8(vget_high_u8(src8), vget_high_u8(dst8));
+        dst_lo = vshrq_n_u16(vaddq_u16(vaddq_u16(dst_lo, vdupq_n_u16(1)), vshrq_n_u16(dst_lo, 8)), 8);
+        dst_hi = vshrq_n_u16(vaddq_u16(vaddq_u16(dst_hi, vdupq_n_u16(1)), vshrq_n_u16(dst_hi, 8)), 8);
+        res = vcombine_u8(vmovn_u16(dst_lo), vmovn_u16(dst_hi));
+        break;
+    case TIG_ART_BLIT_ROW_BLEND:
+        for (k = 0; k < 16; k++) {
+            alpha_components[k] = (uint16_t)alphas[k / 4];
+        }
+        alpha_lo = vld1q_u16(&(alpha_components[0]));
+        alpha_hi = vld1q_u16(&(alpha_components[8]));
+        dst_lo = vmovl_u8(vget_low_u8(dst8));
+        dst_hi = vmovl_u8(vget_high_u8(dst8));
+        src_lo = vmulq_u16(vsubq_u16(vmovl_u8(vget_low_u8(src8)), dst_lo), alpha_lo);
+        src_hi = vmulq_u16(vsubq_u16(vmovl_u8(vget_high_u8(src8)), dst_hi), alpha_hi);
+        // Narrowing drops high bytes, which is the same as masking with 0xFF.
+        dst_lo = vaddq_u16(dst_lo, vshrq_n_u16(src_lo, 8));
+        dst_hi = vaddq_u16(dst_hi, vshrq_n_u16(src_hi, 8));
+        res = vcombine_u8(vmovn_u16(dst_lo), vmovn_u16(dst_hi));
+        break;
+    default:
+        return src;
+    }
+
+    return vorrq_u32(vandq_u32(vreinterpretq_u32_u8(res), vdupq_n_u32(0xFFFFFF)), vdupq_n_u32(info->alpha_mask));
+}
+
+static void tig_art_blit_row_neon(uint32_t* dst, const uint8_t* src, int src_step, int count, const TigArtBlitRowInfo* info)
+{
+    uint32_t indices[8];
+    uint32_t colors[8];
+    uint32_t alphas[8];
+    uint32x4_t keep_lo;
+    uint32x4_t keep_hi;
+    uint32x4_t dst_lo;
+    uint32x4_t dst_hi;
+    uint32x4_t src_lo;
+    uint32x4_t src_hi;
+    uint32_t any;
+    int x;
+    int k;
+
+    for (x = 0; x + 8 <= count; x += 8) {
+        any = 0;
+        for (k = 0; k < 8; k++) {
+            indices[k] = *src;
+            any |= indices[k];
+            src += src_step;
+        }
+
+        // Skip fully transparent runs without touching destination.
+        if (any == 0) {
+            continue;
+        }
+
+        for (k = 0; k < 8; k++) {
+            colors[k] = info->colors[indices[k]];
+            alphas[k] = info->alphas[indices[k]];
+        }
+
+        keep_lo = vceqq_u32(vld1q_u32(&(indices[0])), vdupq_n_u32(0));
+        keep_hi = vceqq_u32(vld1q_u32(&(indices[4])), vdupq_n_u32(0));
+
+        dst_lo = vld1q_u32(dst + x);
+        dst_hi = vld1q_u32(dst + x + 4);
+
+        src_lo = tig_art_blit_row_op_neon(vld1q_u32(&(colors[0])), dst_lo, &(alphas[0]), info);
+        src_hi = tig_art_blit_row_op_neon(vld1q_u32(&(colors[4])), dst_hi, &(alphas[4]), info);
+
+        vst1q_u32(dst + x, vbslq_u32(keep_lo, dst_lo, src_lo));
+        vst1q_u32(dst + x + 4, vbslq_u32(keep_hi, dst_hi, src_hi));
+    }
+
+    tig_art_blit_row_tail(dst + x, src, src_step, count - x, info);
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+// Picks the best row blitter supported by the CPU.
+void tig_art_blit_row_init(void)
+{
+    tig_art_blit_row_func = NULL;
+
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        tig_art_blit_row_func = tig_art_blit_row_neon;
+        tig_debug_printf("Art blitter: NEON\n");
+        return;
+    }
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        tig_art_blit_row_func = tig_art_blit_row_avx2;
+        tig_debug_printf("Art blitter: AVX2\n");
+        return;
+    }
+#endif
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        tig_art_blit_row_func = tig_art_blit_row_sse2;
+        tig_debug_printf("Art blitter: SSE2\n");
+        return;
+    }
+#endif
+
+    tig_debug_printf("Art blitter: scalar\n");
+}
+
 // 0x51AA90
 int sub_51AA90(tig_art_id_t art_id)
 {
     char path[TIG_MAX_PATH];
+    unsigned int hash;
     int cache_entry_index;
+    TigArtCacheIdTableEntry* id_table_entry;
+    TigArtCacheEntry* cache_entry;
+
+    // Check if we've seen this art_id before, path building is quite
+    // expensive to do on every blit.
+    id_table_entry = tig_art_cache_id_table_entry(art_id);
+    if (id_table_entry->art_id == art_id
+        && id_table_entry->cache_entry_index < tig_art_cache_entries_length) {
+        cache_entry = &(tig_art_cache_entries[id_table_entry->cache_entry_index]);
+        if ((cache_entry->flags & TIG_ART_CACHE_ENTRY_USED) != 0
+            && cache_entry->generation == id_table_entry->generation) {
+            cache_entry->time = tig_ping_timestamp;
+            cache_entry->art_id = art_id;
+            tig_art_cache_touch(id_table_entry->cache_entry_index);
+            dword_604714 = id_table_entry->cache_entry_index;
+            tig_art_cache_stats.id_hits++;
+            return id_table_entry->cache_entry_index;
+        }
+    }
 
     if (tig_art_build_path(art_id, path, sizeof(path)) != TIG_OK) {
         return -1;
     }
 
     if (dword_604714 < tig_art_cache_entries_length
+        && (tig_art_cache_entries[dword_604714].flags & TIG_ART_CACHE_ENTRY_USED) != 0
         && strcmp(path, tig_art_cache_entries[dword_604714].path) == 0) {
         tig_art_cache_entries[dword_604714].time = tig_ping_timestamp;
+        tig_art_cache_entries[dword_604714].art_id = art_id;
+        tig_art_cache_touch(dword_604714);
+        tig_art_cache_stats.path_hits++;
+
+        id_table_entry->art_id = art_id;
+        id_table_entry->cache_entry_index = dword_604714;
+        id_table_entry->generation = tig_art_cache_entries[dword_604714].generation;
+
         return dword_604714;
     }
 
@@ -5308,21 +5844,40 @@ int sub_51AA90(tig_art_id_t art_id)
     tig_art_cache_check_fullness();
     tig_art_cache_check_fullness();
 
-    if (!tig_art_cache_find(path, &cache_entry_index)) {
+    hash = tig_art_cache_hash(path);
+
+    if (!tig_art_cache_find(path, hash, &cache_entry_index)) {
+        cache_entry_index = tig_art_cache_slot_alloc();
+
         if (!tig_art_cache_entry_load(art_id, path, cache_entry_index)) {
             tig_debug_printf("ART LOAD FAILURE!!! Trying to load %s\n", path);
 
             if (!tig_art_cache_entry_load(art_id, "art\\badart.art", cache_entry_index)) {
                 tig_debug_printf("ART LOAD FAILURE!!! Trying to load badart.art\n");
+                tig_art_cache_slot_free(cache_entry_index);
                 return -1;
             }
+
+            // NOTE: The replacement is cached under the requested path, so
+            // that the broken art is not reloaded on every lookup.
+            strcpy(tig_art_cache_entries[cache_entry_index].path, path);
         }
+
+        tig_art_cache_link(cache_entry_index, hash);
+        tig_art_cache_stats.misses++;
+    } else {
+        tig_art_cache_touch(cache_entry_index);
+        tig_art_cache_stats.path_hits++;
     }
 
     tig_art_cache_entries[cache_entry_index].time = tig_ping_timestamp;
     tig_art_cache_entries[cache_entry_index].art_id = art_id;
     dword_604714 = cache_entry_index;
 
+    id_table_entry->art_id = art_id;
+    id_table_entry->cache_entry_index = cache_entry_index;
+    id_table_entry->generation = tig_art_cache_entries[cache_entry_index].generation;
+
     return cache_entry_index;
 }
 
@@ -5344,7 +5899,7 @@ void tig_art_cache_check_fullness(void)
     art_size_t acc = 0;
     art_size_t tgt;
     int index;
-    int cnt;
+    int next;
 
     if (vid_vs_sys) {
         // NOTE: Signed compare.
@@ -5357,20 +5912,6 @@ void tig_art_cache_check_fullness(void)
 
         // Calculate target size we'd like to evict.
         tgt = (art_size_t)((double)tig_art_total_video_memory * tig_art_cache_video_memory_fullness);
-
-        // Sort cache entries by last access time, earliest first.
-        qsort(tig_art_cache_entries,
-            tig_art_cache_entries_length,
-            sizeof(TigArtCacheEntry),
-            tig_art_cache_entry_compare_time);
-
-        // Loop thru cache entries until we reach eviction target.
-        for (index = 0; index < tig_art_cache_entries_length; ++index) {
-            acc += tig_art_cache_entries[index].video_memory_usage;
-            if (acc >= tgt) {
-                break;
-            }
-        }
     } else {
         // NOTE: Signed compare.
         if (tig_art_available_system_memory > 0) {
@@ -5383,71 +5924,36 @@ void tig_art_cache_check_fullness(void)
         // Calculate target size we'd like to evict (30% of total system
         // memory).
         tgt = (art_size_t)((double)tig_art_total_system_memory * 0.3f);
+    }
 
-        // Sort cache entries by last access time, earliest first.
-        qsort(tig_art_cache_entries,
-            tig_art_cache_entries_length,
-            sizeof(TigArtCacheEntry),
-            tig_art_cache_entry_compare_time);
-
-        // Loop thru cache entries until we reach eviction target.
-        for (index = 0; index < tig_art_cache_entries_length; ++index) {
+    // Evict least recently used entries until we reach eviction target.
+    index = tig_art_cache_lru_head;
+    while (index != -1 && acc < tgt) {
+        if (vid_vs_sys) {
+            acc += tig_art_cache_entries[index].video_memory_usage;
+        } else {
             acc += tig_art_cache_entries[index].system_memory_usage;
-            if (acc >= tgt) {
-                break;
-            }
         }
+
+        next = tig_art_cache_entries[index].lru_next;
+        tig_art_cache_entry_unload(index);
+        tig_art_cache_unlink(index);
+        tig_art_cache_slot_free(index);
+        index = next;
     }
 
     // NOTE: Signed compare.
     if (acc < tgt) {
-        // We haven't reached eviction target, flush everything.
+        // We haven't reached eviction target, everything is gone.
         tig_art_flush();
         tig_debug_printf("...\n");
         return;
     }
 
-    cnt = index + 1;
-
-    // Free cache entries.
-    for (; index >= 0; index--) {
-        tig_art_cache_entry_unload(index);
-    }
-
-    tig_art_cache_entries_length -= cnt;
-
-    // Move remaining cache entries on top.
-    memmove(tig_art_cache_entries,
-        &(tig_art_cache_entries[cnt]),
-        sizeof(TigArtCacheEntry) * (tig_art_cache_entries_length));
-
-    // Sort back cache entries by name (as `tig_art_cache_find` uses binary
-    // search by name).
-    qsort(tig_art_cache_entries,
-        tig_art_cache_entries_length,
-        sizeof(TigArtCacheEntry),
-        tig_art_cache_entry_compare_name);
-
     tig_debug_printf("...\n");
     vid_vs_sys = !vid_vs_sys;
 }
 
-// 0x51ADE0
-int tig_art_cache_entry_compare_time(const void* va, const void* vb)
-{
-    const TigArtCacheEntry* a = (const TigArtCacheEntry*)va;
-    const TigArtCacheEntry* b = (const TigArtCacheEntry*)vb;
-    return a->time - b->time;
-}
-
-// 0x51AE00
-int tig_art_cache_entry_compare_name(const void* va, const void* vb)
-{
-    const TigArtCacheEntry* a = (const TigArtCacheEntry*)va;
-    const TigArtCacheEntry* b = (const TigArtCacheEntry*)vb;
-    return strcmp(a->path, b->path);
-}
-
 // 0x51AE50
 int tig_art_build_path(unsigned int art_id, char* path, size_t maxlen)
 {
@@ -5512,29 +6018,210 @@ tig_art_id_t tig_art_id_reset(tig_art_id_t art_id)
     return art_id;
 }
 
+unsigned int tig_art_cache_hash(const char* path)
+{
+    unsigned int hash = 2166136261u;
+
+    while (*path != '\0') {
+        hash ^= (unsigned char)*path++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
 // 0x51B0E0
-bool tig_art_cache_find(const char* path, int* index)
+bool tig_art_cache_find(const char* path, unsigned int hash, int* index)
 {
-    int l = 0;
-    int r = tig_art_cache_entries_length - 1;
+    int curr;
 
-    while (l <= r) {
-        int mid = (l + r) / 2;
-        int cmp = strcmp(tig_art_cache_entries[mid].path, path);
-        if (cmp == 0) {
-            *index = mid;
+    curr = tig_art_cache_buckets[hash & tig_art_cache_buckets_mask];
+    while (curr != -1) {
+        if (tig_art_cache_entries[curr].hash == hash
+            && strcmp(tig_art_cache_entries[curr].path, path) == 0) {
+            *index = curr;
             return true;
         }
+        curr = tig_art_cache_entries[curr].hash_next;
+    }
 
-        if (cmp > 0) {
-            r = mid - 1;
-        } else {
-            l = mid + 1;
+    return false;
+}
+
+// Returns index of unused cache slot.
+int tig_art_cache_slot_alloc(void)
+{
+    int index;
+
+    if (tig_art_cache_free_head != -1) {
+        index = tig_art_cache_free_head;
+        tig_art_cache_free_head = tig_art_cache_entries[index].lru_next;
+        return index;
+    }
+
+    if (tig_art_cache_entries_length == tig_art_cache_entries_capacity) {
+        // NOTE: Slots keep their indexes, only the array is relocated.
+        tig_art_cache_entries_capacity *= 2;
+        tig_art_cache_entries = (TigArtCacheEntry*)REALLOC(tig_art_cache_entries,
+            sizeof(TigArtCacheEntry) * tig_art_cache_entries_capacity);
+        tig_art_cache_buckets_resize();
+    }
+
+    index = tig_art_cache_entries_length++;
+    tig_art_cache_entries[index].flags = 0;
+
+    return index;
+}
+
+void tig_art_cache_slot_free(int cache_entry_index)
+{
+    tig_art_cache_entries[cache_entry_index].flags = 0;
+    tig_art_cache_entries[cache_entry_index].lru_next = tig_art_cache_free_head;
+    tig_art_cache_free_head = cache_entry_index;
+}
+
+// Sizes hash table to the capacity of the cache and rehashes used slots.
+void tig_art_cache_buckets_resize(void)
+{
+    unsigned int buckets_count;
+    unsigned int bucket;
+    int index;
+
+    buckets_count = 1;
+    while (buckets_count < (unsigned int)tig_art_cache_entries_capacity) {
+        buckets_count <<= 1;
+    }
+
+    if (tig_art_cache_buckets != NULL) {
+        FREE(tig_art_cache_buckets);
+    }
+
+    tig_art_cache_buckets = (int*)MALLOC(sizeof(*tig_art_cache_buckets) * buckets_count);
+    tig_art_cache_buckets_mask = buckets_count - 1;
+
+    for (bucket = 0; bucket < buckets_count; bucket++) {
+        tig_art_cache_buckets[bucket] = -1;
+    }
+
+    for (index = 0; index < tig_art_cache_entries_length; index++) {
+        if ((tig_art_cache_entries[index].flags & TIG_ART_CACHE_ENTRY_USED) != 0) {
+            bucket = tig_art_cache_entries[index].hash & tig_art_cache_buckets_mask;
+            tig_art_cache_entries[index].hash_next = tig_art_cache_buckets[bucket];
+            tig_art_cache_buckets[bucket] = index;
         }
     }
+}
 
-    *index = l;
-    return false;
+// Adds loaded entry to the hash index and makes it the most recently used.
+void tig_art_cache_link(int cache_entry_index, unsigned int hash)
+{
+    TigArtCacheEntry* cache_entry;
+    unsigned int bucket;
+
+    cache_entry = &(tig_art_cache_entries[cache_entry_index]);
+    cache_entry->flags |= TIG_ART_CACHE_ENTRY_USED;
+    cache_entry->hash = hash;
+
+    // Invalidates art_id table entries pointing to the previous occupant.
+    // Zero is never used, so zeroed table entries never match.
+    if (++tig_art_cache_generation == 0) {
+        memset(tig_art_cache_id_table, 0, sizeof(tig_art_cache_id_table));
+        tig_art_cache_generation++;
+    }
+    cache_entry->generation = tig_art_cache_generation;
+
+    bucket = hash & tig_art_cache_buckets_mask;
+    cache_entry->hash_next = tig_art_cache_buckets[bucket];
+    tig_art_cache_buckets[bucket] = cache_entry_index;
+
+    cache_entry->lru_prev = tig_art_cache_lru_tail;
+    cache_entry->lru_next = -1;
+    if (tig_art_cache_lru_tail != -1) {
+        tig_art_cache_entries[tig_art_cache_lru_tail].lru_next = cache_entry_index;
+    } else {
+        tig_art_cache_lru_head = cache_entry_index;
+    }
+    tig_art_cache_lru_tail = cache_entry_index;
+}
+
+void tig_art_cache_unlink(int cache_entry_index)
+{
+    TigArtCacheEntry* cache_entry;
+    int* link;
+
+    cache_entry = &(tig_art_cache_entries[cache_entry_index]);
+
+    link = &(tig_art_cache_buckets[cache_entry->hash & tig_art_cache_buckets_mask]);
+    while (*link != cache_entry_index) {
+        link = &(tig_art_cache_entries[*link].hash_next);
+    }
+    *link = cache_entry->hash_next;
+
+    if (cache_entry->lru_prev != -1) {
+        tig_art_cache_entries[cache_entry->lru_prev].lru_next = cache_entry->lru_next;
+    } else {
+        tig_art_cache_lru_head = cache_entry->lru_next;
+    }
+
+    if (cache_entry->lru_next != -1) {
+        tig_art_cache_entries[cache_entry->lru_next].lru_prev = cache_entry->lru_prev;
+    } else {
+        tig_art_cache_lru_tail = cache_entry->lru_prev;
+    }
+
+    cache_entry->flags &= ~TIG_ART_CACHE_ENTRY_USED;
+}
+
+// Makes entry the most recently used.
+void tig_art_cache_touch(int cache_entry_index)
+{
+    TigArtCacheEntry* cache_entry;
+
+    if (cache_entry_index == tig_art_cache_lru_tail) {
+        return;
+    }
+
+    cache_entry = &(tig_art_cache_entries[cache_entry_index]);
+
+    // Detach (the entry is not the tail, so `lru_next` is valid).
+    if (cache_entry->lru_prev != -1) {
+        tig_art_cache_entries[cache_entry->lru_prev].lru_next = cache_entry->lru_next;
+    } else {
+        tig_art_cache_lru_head = cache_entry->lru_next;
+    }
+    tig_art_cache_entries[cache_entry->lru_next].lru_prev = cache_entry->lru_prev;
+
+    // Append.
+    cache_entry->lru_prev = tig_art_cache_lru_tail;
+    cache_entry->lru_next = -1;
+    tig_art_cache_entries[tig_art_cache_lru_tail].lru_next = cache_entry_index;
+    tig_art_cache_lru_tail = cache_entry_index;
+}
+
+TigArtCacheIdTableEntry* tig_art_cache_id_table_entry(tig_art_id_t art_id)
+{
+    // Fibonacci hashing, art_id bits are poorly distributed.
+    return &(tig_art_cache_id_table[(art_id * 2654435761u) >> (32 - TIG_ART_CACHE_ID_TABLE_BITS)]);
+}
+
+void tig_art_cache_get_stats(TigArtCacheStats* stats)
+{
+    *stats = tig_art_cache_stats;
+}
+
+// Marks all slots as free, entries must be unloaded beforehand.
+void tig_art_cache_reset(void)
+{
+    unsigned int bucket;
+
+    tig_art_cache_entries_length = 0;
+    tig_art_cache_free_head = -1;
+    tig_art_cache_lru_head = -1;
+    tig_art_cache_lru_tail = -1;
+
+    for (bucket = 0; bucket <= tig_art_cache_buckets_mask; bucket++) {
+        tig_art_cache_buckets[bucket] = -1;
+    }
 }
 
 // 0x51B170
@@ -5551,16 +6238,6 @@ bool tig_art_cache_entry_load(tig_art_id_t art_id, const char* path, int cache_e
     int frame;
     int offset;
 
-    if (tig_art_cache_entries_length == tig_art_cache_entries_capacity - 1) {
-        tig_art_cache_entries_capacity += 32;
-        tig_art_cache_entries = (TigArtCacheEntry*)REALLOC(tig_art_cache_entries,
-            sizeof(TigArtCacheEntry) * tig_art_cache_entries_capacity);
-    }
-
-    memmove(&(tig_art_cache_entries[cache_entry_index + 1]),
-        &(tig_art_cache_entries[cache_entry_index]),
-        sizeof(TigArtCacheEntry) * (tig_art_cache_entries_length - cache_entry_index));
-
     art = &(tig_art_cache_entries[cache_entry_index]);
 
     memset(art, 0, sizeof(TigArtCacheEntry));
@@ -5573,9 +6250,6 @@ bool tig_art_cache_entry_load(tig_art_id_t art_id, const char* path, int cache_e
         0,
         &size);
     if (rc != TIG_OK) {
-        memmove(&(tig_art_cache_entries[cache_entry_index]),
-            &(tig_art_cache_entries[cache_entry_index + 1]),
-            sizeof(TigArtCacheEntry) * (tig_art_cache_entries_length - cache_entry_index));
         return false;
     }
 
@@ -5616,7 +6290,6 @@ bool tig_art_cache_entry_load(tig_art_id_t art_id, const char* path, int cache_e
         }
     }
 
-    tig_art_cache_entries_length++;
     tig_art_available_system_memory -= art->system_memory_usage;
 
     return true;
@@ -5723,7 +6396,8 @@ void sub_51B650(int cache_entry_index)
 // 0x51B710
 int sub_51B710(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, TigPalette** palette_tbl, int a5, art_size_t* size_ptr)
 {
-    TigFile* stream;
+    TigFileMapping mapping;
+    TigArtReader reader;
     int rotation;
     int palette;
     TigPalette* saved_palette_tbl[MAX_PALETTES];
@@ -5746,26 +6420,31 @@ int sub_51B710(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, Tig
         hdr->pixels_tbl[rotation] = NULL;
     }
 
-    stream = tig_file_fopen(filename, "rb");
-    if (stream == NULL) {
+    // Borrow the whole file at once (zero-copy for stored archive entries)
+    // instead of issuing a read for every RLE run.
+    if (!tig_file_map_contents(filename, &mapping)) {
         return TIG_ERR_GENERIC;
     }
 
-    if (!art_read_header(hdr, stream)) {
-        tig_file_fclose(stream);
+    reader.data = (const uint8_t*)mapping.data;
+    reader.size = mapping.size;
+    reader.pos = 0;
+
+    if (!art_read_header(hdr, &reader)) {
+        tig_file_unmap_contents(&mapping);
         return TIG_ERR_GENERIC;
     }
 
     // Only 8-bpp palette-indexed ART files are supported.
     if (hdr->bpp != 8) {
-        tig_file_fclose(stream);
+        tig_file_unmap_contents(&mapping);
         return TIG_ERR_GENERIC;
     }
 
     if (a5) {
         current_palette_index = tig_art_id_palette_get(art_id);
         if (hdr->palette_tbl[current_palette_index] != NULL) {
-            tig_file_fclose(stream);
+            tig_file_unmap_contents(&mapping);
             return TIG_ERR_GENERIC;
         }
         current_palette = palette_tbl[0];
@@ -5779,8 +6458,8 @@ int sub_51B710(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, Tig
 
     for (palette = 0; palette < MAX_PALETTES; palette++) {
         if (saved_palette_tbl[palette] != NULL) {
-            if (tig_file_fread(temp_palette_entries, sizeof(uint32_t), 256, stream) != 256) {
-                sub_51BE50(stream, hdr, palette_tbl);
+            if (!art_read(&reader, temp_palette_entries, sizeof(temp_palette_entries))) {
+                sub_51BE50(&mapping, hdr, palette_tbl);
                 return TIG_ERR_GENERIC;
             }
 
@@ -5790,7 +6469,7 @@ int sub_51B710(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, Tig
                         ((uint32_t*)current_palette)[index] = temp_palette_entries[index];
                     }
 
-                    tig_file_fclose(stream);
+                    tig_file_unmap_contents(&mapping);
                     return TIG_OK;
                 }
             } else {
@@ -5813,8 +6492,8 @@ int sub_51B710(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, Tig
         hdr->frames_tbl[rotation] = (TigArtFileFrameData*)MALLOC(sizeof(TigArtFileFrameData) * hdr->num_frames);
         *size_ptr += sizeof(TigArtFileFrameData) * hdr->num_frames;
 
-        if (tig_file_fread(hdr->frames_tbl[rotation], sizeof(TigArtFileFrameData), hdr->num_frames, stream) != (size_t)hdr->num_frames) {
-            sub_51BE50(stream, hdr, palette_tbl);
+        if (!art_read(&reader, hdr->frames_tbl[rotation], sizeof(TigArtFileFrameData) * hdr->num_frames)) {
+            sub_51BE50(&mapping, hdr, palette_tbl);
             return TIG_ERR_GENERIC;
         }
     }
@@ -5841,8 +6520,8 @@ int sub_51B710(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, Tig
         for (frame = 0; frame < hdr->num_frames; ++frame) {
             if (hdr->frames_tbl[index][frame].data_size == hdr->frames_tbl[index][frame].width * hdr->frames_tbl[index][frame].height) {
                 // Pixels are not compressed, read everything in one go.
-                if (tig_file_fread(bytes, 1, hdr->frames_tbl[index][frame].data_size, stream) != (size_t)hdr->frames_tbl[index][frame].data_size) {
-                    sub_51BE50(stream, hdr, palette_tbl);
+                if (!art_read(&reader, bytes, hdr->frames_tbl[index][frame].data_size)) {
+                    sub_51BE50(&mapping, hdr, palette_tbl);
                     return TIG_ERR_GENERIC;
                 }
                 bytes += hdr->frames_tbl[index][frame].data_size;
@@ -5854,21 +6533,21 @@ int sub_51B710(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, Tig
                 int cnt = 0;
 
                 while (cnt < hdr->frames_tbl[index][frame].data_size) {
-                    if (tig_file_fread(&value, 1, 1, stream) != 1) {
-                        sub_51BE50(stream, hdr, palette_tbl);
+                    if (!art_read(&reader, &value, 1)) {
+                        sub_51BE50(&mapping, hdr, palette_tbl);
                         return TIG_ERR_GENERIC;
                     }
 
                     len = value & 0x7F;
                     if ((value & 0x80) != 0) {
-                        if (tig_file_fread(bytes, 1, len, stream) != (size_t)len) {
-                            sub_51BE50(stream, hdr, palette_tbl);
+                        if (!art_read(&reader, bytes, len)) {
+                            sub_51BE50(&mapping, hdr, palette_tbl);
                             return TIG_ERR_GENERIC;
                         }
                         cnt += 1 + len;
                     } else {
-                        if (tig_file_fread(&color, 1, 1, stream) != 1) {
-                            sub_51BE50(stream, hdr, palette_tbl);
+                        if (!art_read(&reader, &color, 1)) {
+                            sub_51BE50(&mapping, hdr, palette_tbl);
                             return TIG_ERR_GENERIC;
                         }
 
@@ -5906,7 +6585,7 @@ int sub_51B710(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, Tig
         }
     }
 
-    tig_file_fclose(stream);
+    tig_file_unmap_contents(&mapping);
     return TIG_OK;
 }
 
@@ -5917,12 +6596,12 @@ int sub_51BE30(TigArtHeader* hdr)
 }
 
 // 0x51BE50
-void sub_51BE50(TigFile* stream, TigArtHeader* hdr, TigPalette** palette_tbl)
+void sub_51BE50(TigFileMapping* mapping, TigArtHeader* hdr, TigPalette** palette_tbl)
 {
     int palette;
 
-    if (stream != NULL) {
-        tig_file_fclose(stream);
+    if (mapping != NULL) {
+        tig_file_unmap_contents(mapping);
     }
 
     sub_51BF20(hdr);
@@ -5955,31 +6634,47 @@ void sub_51BF20(TigArtHeader* hdr)
     }
 }
 
-bool art_read_header(TigArtHeader* hdr, TigFile* stream)
+bool art_read_header(TigArtHeader* hdr, TigArtReader* reader)
 {
     int idx;
     int value;
 
-    if (tig_file_fread(&(hdr->flags), sizeof(hdr->flags), 1, stream) != 1) return false;
-    if (tig_file_fread(&(hdr->fps), sizeof(hdr->fps), 1, stream) != 1) return false;
-    if (tig_file_fread(&(hdr->bpp), sizeof(hdr->bpp), 1, stream) != 1) return false;
+    if (!art_read(reader, &(hdr->flags), sizeof(hdr->flags))) return false;
+    if (!art_read(reader, &(hdr->fps), sizeof(hdr->fps))) return false;
+    if (!art_read(reader, &(hdr->bpp), sizeof(hdr->bpp))) return false;
 
     // Read palette table, non-zero value indicates presence of palette entries.
     for (idx = 0; idx < MAX_PALETTES; idx++) {
-        if (tig_file_fread(&(value), sizeof(value), 1, stream) != 1) return false;
+        if (!art_read(reader, &(value), sizeof(value))) return false;
         hdr->palette_tbl[idx] = (TigPalette*)(intptr_t)value;
     }
 
-    if (tig_file_fread(&(hdr->action_frame), sizeof(hdr->action_frame), 1, stream) != 1) return false;
-    if (tig_file_fread(&(hdr->num_frames), sizeof(hdr->num_frames), 1, stream) != 1) return false;
+    if (!art_read(reader, &(hdr->action_frame), sizeof(hdr->action_frame))) return false;
+    if (!art_read(reader, &(hdr->num_frames), sizeof(hdr->num_frames))) return false;
 
     // Skip frames table, actual values are ignored.
-    if (tig_file_fseek(stream, 4 * MAX_ROTATIONS, SEEK_CUR) != 0) return false;
+    if (!art_read(reader, NULL, 4 * MAX_ROTATIONS)) return false;
 
-    if (tig_file_fread(&(hdr->data_size), sizeof(hdr->data_size), 1, stream) != 1) return false;
+    if (!art_read(reader, &(hdr->data_size), sizeof(hdr->data_size))) return false;
 
     // Skip pixels table, actual values are ignored.
-    if (tig_file_fseek(stream, 4 * MAX_ROTATIONS, SEEK_CUR) != 0) return false;
+    if (!art_read(reader, NULL, 4 * MAX_ROTATIONS)) return false;
+
+    return true;
+}
+
+bool art_read(TigArtReader* reader, void* buffer, size_t size)
+{
+    if (size > reader->size - reader->pos) {
+        return false;
+    }
+
+    // `NULL` buffer denotes skipping.
+    if (buffer != NULL) {
+        memcpy(buffer, reader->data + reader->pos, size);
+    }
+
+    reader->pos += size;
 
     return true;
 }
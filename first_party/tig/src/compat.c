@@ -2,8 +2,15 @@
 
 #ifdef _WIN32
 #include <stdlib.h>
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
 #else
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 void compat_windows_path_to_native(char* path)
@@ -256,3 +263,78 @@ void compat_makepath(char* path, const char* drive, const char* dir, const char*
     *path = '\0';
 #endif
 }
+
+void* compat_map_file(const char* path, size_t* size_ptr)
+{
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+    LARGE_INTEGER size;
+    void* data;
+
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0 || (unsigned long long)size.QuadPart > SIZE_MAX) {
+        CloseHandle(file);
+        return NULL;
+    }
+
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+
+    if (mapping == NULL) {
+        return NULL;
+    }
+
+    // The view keeps the mapping object alive.
+    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if (data == NULL) {
+        return NULL;
+    }
+
+    *size_ptr = (size_t)size.QuadPart;
+
+    return data;
+#else
+    int fd;
+    struct stat st;
+    void* data;
+
+    fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        return NULL;
+    }
+
+    if (fstat(fd, &st) != 0 || st.st_size == 0 || (unsigned long long)st.st_size > SIZE_MAX) {
+        close(fd);
+        return NULL;
+    }
+
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        return NULL;
+    }
+
+    *size_ptr = (size_t)st.st_size;
+
+    return data;
+#endif
+}
+
+void compat_unmap_file(void* data, size_t size)
+{
+#ifdef _WIN32
+    (void)size;
+
+    UnmapViewOfFile(data);
+#else
+    munmap(data, size);
+#endif
+}
@@ -1,5 +1,6 @@
 #include "tig/database.h"
 
+#include <limits.h>
 #include <stdarg.h>
 #include <stdio.h>
 
@@ -14,9 +15,32 @@
 #define FOURCC_DAT1 SDL_FOURCC('1', 'T', 'A', 'D')
 #define DECOMPRESSION_BUFFER_SIZE 0x4000
 
+// Total size (in KB) of archives mapped at once. Stock data alone is about
+// 1 GB, which does not fit next to everything else in 32-bit address space,
+// so there archives past the budget are read with stdio.
+#if SIZE_MAX > UINT32_MAX
+#define MAPPING_BUDGET_KB (INT_MAX / 2)
+#else
+#define MAPPING_BUDGET_KB (256 * 1024)
+#endif
+
+// Spacing of inflate checkpoints (in uncompressed bytes) taken while reading
+// legacy compressed entries. The checkpoint table is sized by the entry, so
+// seeking never re-inflates more than one interval.
+#define CHECKPOINT_INTERVAL 0x40000
+
+// Snapshot of the inflate state at some position of the uncompressed stream.
+typedef struct DecompressionCheckpoint {
+    z_stream zstrm;
+    unsigned int pos;
+    unsigned int compressed_pos;
+} DecompressionCheckpoint;
+
 typedef struct DecompressionContext {
     /* 0000 */ z_stream zstrm;
     /* 0038 */ unsigned char buffer[DECOMPRESSION_BUFFER_SIZE];
+    DecompressionCheckpoint* checkpoints;
+    int checkpoints_count;
 } DecompressionContext;
 
 #define TIG_DATABASE_FILE_UNGOTTEN 0x01
@@ -24,11 +48,30 @@ typedef struct DecompressionContext {
 #define TIG_DATABASE_FILE_ERROR 0x04
 #define TIG_DATABASE_FILE_TEXT_MODE 0x08
 
+// Read-only memory block: either a view of the entire archive file, or a heap
+// copy of the uncompressed contents of a single entry (see
+// `tig_database_prefetch`).
+//
+// The mapping is shared between the database, open streams and borrowers
+// obtained via `tig_database_map_contents`, so it outlives the database if
+// someone still holds a pointer into it. The reference count is atomic as
+// prefetched contents are created and dropped on worker threads.
+typedef struct TigDatabaseMapping {
+    unsigned char* data;
+    size_t size;
+    SDL_AtomicInt refcount;
+    bool heap;
+    // Share of `tig_database_mapped_kb` held by the archive view.
+    int budget_kb;
+} TigDatabaseMapping;
+
 typedef struct TigDatabaseFileHandle {
     unsigned int flags;
     TigDatabase* database;
     TigDatabaseEntry* entry;
     FILE* underlying_stream;
+    const unsigned char* data;
+    TigDatabaseMapping* contents;
     int pos;
     int compressed_pos;
     int ungotten;
@@ -42,15 +85,24 @@ static int num_path_segments(const char* path);
 static int tig_database_find_entry_by_path(const void* a1, const void* a2);
 static bool tig_database_fclose_internal(TigDatabaseFileHandle* stream);
 static bool tig_database_fopen_internal(TigDatabase* database, TigDatabaseEntry* entry, const char* mode, TigDatabaseFileHandle* stream);
+static bool tig_database_stream_init(TigDatabase* database, TigDatabaseEntry* entry, const char* mode, TigDatabaseMapping* contents, TigDatabaseFileHandle* stream);
+static void tig_database_stream_cleanup(TigDatabaseFileHandle* stream);
+static bool tig_database_stream_is_plain(TigDatabaseFileHandle* stream);
 static int tig_database_fgetc_internal(TigDatabaseFileHandle* stream);
 static bool tig_database_fread_internal(void* buffer, size_t size, TigDatabaseFileHandle* stream);
-
-// 0x638BBC
-static unsigned char tig_database_decompression_buffer[DECOMPRESSION_BUFFER_SIZE];
+static TigDatabaseMapping* tig_database_mapping_create(const char* path, size_t size);
+static bool tig_database_inflate_reset(TigDatabaseFileHandle* stream);
+static void tig_database_checkpoint_add(TigDatabaseFileHandle* stream);
+static bool tig_database_checkpoint_restore(TigDatabaseFileHandle* stream, unsigned int pos);
+static void tig_database_checkpoints_clear(DecompressionContext* ctx);
+static void tig_database_mapping_release(TigDatabaseMapping* mapping);
 
 // 0x63CBC0
 static TigDatabase* tig_database_open_databases_head;
 
+// Total size (in KB) of mapped archives, see `MAPPING_BUDGET_KB`.
+static SDL_AtomicInt tig_database_mapped_kb;
+
 // 0x53BC50
 TigDatabase* tig_database_open(const char* path)
 {
@@ -197,6 +249,11 @@ TigDatabase* tig_database_open(const char* path)
         return false;
     }
 
+    // Map the whole archive once. When mapping is not available (address space
+    // is exhausted, or the mapping budget is used up) entries are read with
+    // stdio.
+    database->mapping = tig_database_mapping_create(path, (size_t)size);
+
     database->next = tig_database_open_databases_head;
     tig_database_open_databases_head = database;
 
@@ -237,6 +294,10 @@ bool tig_database_close(TigDatabase* database)
         curr_file_handle = next_file_handle;
     }
 
+    if (database->mapping != NULL) {
+        tig_database_mapping_release(database->mapping);
+    }
+
     FREE(database->name_table);
     FREE(database->entries);
     FREE(database->path);
@@ -439,6 +500,28 @@ TigDatabaseFileHandle* tig_database_fopen_entry(TigDatabase* database, TigDataba
     return stream;
 }
 
+// Opens a stream for `entry` which reads from `contents` previously obtained
+// with `tig_database_prefetch`. The stream holds its own reference.
+TigDatabaseFileHandle* tig_database_fopen_contents(TigDatabase* database, TigDatabaseEntry* entry, const char* mode, TigDatabaseMapping* contents)
+{
+    TigDatabaseFileHandle* stream;
+
+    if (mode[0] == 'w' || contents->size != entry->size) {
+        return NULL;
+    }
+
+    stream = (TigDatabaseFileHandle*)MALLOC(sizeof(*stream));
+    if (!tig_database_stream_init(database, entry, mode, contents, stream)) {
+        FREE(stream);
+        return NULL;
+    }
+
+    stream->next = database->open_file_handles_head;
+    database->open_file_handles_head = stream;
+
+    return stream;
+}
+
 // 0x53C340
 int tig_database_setbuf(TigDatabaseFileHandle* stream, char* buffer)
 {
@@ -611,6 +694,7 @@ int tig_database_fgetpos(TigDatabaseFileHandle* stream, int* off)
 int tig_database_fseek(TigDatabaseFileHandle* stream, int offset, int origin)
 {
     int pos;
+    unsigned char buffer[DECOMPRESSION_BUFFER_SIZE];
 
     if ((stream->flags & TIG_DATABASE_FILE_ERROR) != 0) {
         return 1;
@@ -643,38 +727,30 @@ int tig_database_fseek(TigDatabaseFileHandle* stream, int offset, int origin)
         return 1;
     }
 
-    if ((stream->entry->flags & TIG_DATABASE_ENTRY_PLAIN) != 0) {
-        if (fseek(stream->underlying_stream, stream->entry->offset + pos, SEEK_SET) != 0) {
+    if (tig_database_stream_is_plain(stream)) {
+        // Mapped entries are read at `pos`, there is nothing to reposition.
+        if (stream->data == NULL
+            && fseek(stream->underlying_stream, stream->entry->offset + pos, SEEK_SET) != 0) {
             stream->flags |= TIG_DATABASE_FILE_ERROR;
             return 1;
         }
     } else if ((stream->entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) != 0) {
         unsigned int bytes_to_skip;
 
-        if (pos < stream->pos) {
-            if (fseek(stream->underlying_stream, stream->entry->offset, SEEK_SET) != 0) {
-                stream->flags |= TIG_DATABASE_FILE_ERROR;
-                return 1;
-            }
-
-            stream->compressed_pos = 0;
-            stream->pos = 0;
-            inflateEnd(&(stream->decompression_context->zstrm));
-
-            stream->decompression_context->zstrm.next_in = NULL;
-            stream->decompression_context->zstrm.avail_in = 0;
-            stream->decompression_context->zstrm.next_out = NULL;
-            stream->decompression_context->zstrm.avail_out = 0;
-
-            if (inflateInit(&(stream->decompression_context->zstrm)) != Z_OK) {
-                stream->flags |= TIG_DATABASE_FILE_ERROR;
-                return 1;
+        // Jump to the nearest checkpoint preceding target position (if it's
+        // better than where we are), or start over when seeking backwards.
+        if (!tig_database_checkpoint_restore(stream, (unsigned int)pos)) {
+            if (pos < stream->pos) {
+                if (!tig_database_inflate_reset(stream)) {
+                    stream->flags |= TIG_DATABASE_FILE_ERROR;
+                    return 1;
+                }
             }
         }
 
         bytes_to_skip = pos - stream->pos;
         while (bytes_to_skip >= DECOMPRESSION_BUFFER_SIZE) {
-            if (!tig_database_fread_internal(tig_database_decompression_buffer, DECOMPRESSION_BUFFER_SIZE, stream)) {
+            if (!tig_database_fread_internal(buffer, DECOMPRESSION_BUFFER_SIZE, stream)) {
                 return 1;
             }
 
@@ -682,7 +758,7 @@ int tig_database_fseek(TigDatabaseFileHandle* stream, int offset, int origin)
         }
 
         if (bytes_to_skip > 0) {
-            if (!tig_database_fread_internal(tig_database_decompression_buffer, bytes_to_skip, stream)) {
+            if (!tig_database_fread_internal(buffer, bytes_to_skip, stream)) {
                 return 1;
             }
         }
@@ -730,6 +806,84 @@ int tig_database_ferror(TigDatabaseFileHandle* stream)
     return stream->flags & TIG_DATABASE_FILE_ERROR;
 }
 
+// Returns a pointer to the contents of the stored (uncompressed) entry backing
+// `stream` right inside the archive mapping, or `NULL` when the entry is
+// compressed or the archive is not mapped. On success the caller receives a
+// reference to the mapping which must be returned with
+// `tig_database_unmap_contents`.
+const void* tig_database_map_contents(TigDatabaseFileHandle* stream, TigDatabaseMapping** mapping_ptr)
+{
+    TigDatabaseMapping* mapping;
+
+    if (stream->data == NULL
+        || !tig_database_stream_is_plain(stream)) {
+        return NULL;
+    }
+
+    mapping = stream->contents != NULL ? stream->contents : stream->database->mapping;
+    SDL_AtomicIncRef(&(mapping->refcount));
+    *mapping_ptr = mapping;
+
+    return stream->data;
+}
+
+void tig_database_unmap_contents(TigDatabaseMapping* mapping)
+{
+    tig_database_mapping_release(mapping);
+}
+
+// Reads and inflates the entire `entry` into memory, to be served later with
+// `tig_database_fopen_contents`. Stored entries of the mapped archive are not
+// copied: their pages are touched to fault them in, and `contents_ptr` is set
+// to `NULL`.
+//
+// This function only reads the database, so it can be called on a worker
+// thread as long as the database is not closed meanwhile.
+bool tig_database_prefetch(TigDatabase* database, TigDatabaseEntry* entry, TigDatabaseMapping** contents_ptr)
+{
+    TigDatabaseFileHandle stream;
+    TigDatabaseMapping* contents;
+    volatile unsigned char sum;
+    unsigned int pos;
+
+    *contents_ptr = NULL;
+
+    if (!tig_database_stream_init(database, entry, "rb", NULL, &stream)) {
+        return false;
+    }
+
+    if (stream.data != NULL && (entry->flags & TIG_DATABASE_ENTRY_PLAIN) != 0) {
+        sum = 0;
+        for (pos = 0; pos < entry->size; pos += 4096) {
+            sum += stream.data[pos];
+        }
+        (void)sum;
+
+        tig_database_stream_cleanup(&stream);
+        return true;
+    }
+
+    contents = (TigDatabaseMapping*)MALLOC(sizeof(*contents));
+    contents->size = entry->size;
+    contents->data = (unsigned char*)MALLOC(entry->size != 0 ? entry->size : 1);
+    contents->heap = true;
+    contents->budget_kb = 0;
+    SDL_SetAtomicInt(&(contents->refcount), 1);
+
+    if (entry->size != 0
+        && !tig_database_fread_internal(contents->data, entry->size, &stream)) {
+        tig_database_stream_cleanup(&stream);
+        tig_database_mapping_release(contents);
+        return false;
+    }
+
+    tig_database_stream_cleanup(&stream);
+
+    *contents_ptr = contents;
+
+    return true;
+}
+
 // 0x53CCE0
 void tig_database_load_ignored(TigDatabase* database)
 {
@@ -826,16 +980,30 @@ bool tig_database_fclose_internal(TigDatabaseFileHandle* stream)
         stream->database->open_file_handles_head = curr->next;
     }
 
-    fclose(stream->underlying_stream);
+    tig_database_stream_cleanup(stream);
 
-    if ((stream->entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) != 0) {
+    return true;
+}
+
+// Releases resources owned by the stream, which must be already unlinked from
+// the database.
+void tig_database_stream_cleanup(TigDatabaseFileHandle* stream)
+{
+    if (stream->underlying_stream != NULL) {
+        fclose(stream->underlying_stream);
+    }
+
+    if (stream->contents != NULL) {
+        tig_database_mapping_release(stream->contents);
+    }
+
+    if (stream->decompression_context != NULL) {
+        tig_database_checkpoints_clear(stream->decompression_context);
         inflateEnd(&(stream->decompression_context->zstrm));
         FREE(stream->decompression_context);
     }
 
     memset(stream, 0, sizeof(*stream));
-
-    return true;
 }
 
 // 0x53CF50
@@ -845,25 +1013,62 @@ bool tig_database_fopen_internal(TigDatabase* database, TigDatabaseEntry* entry,
         return false;
     }
 
-    memset(stream, 0, sizeof(*stream));
-
-    stream->underlying_stream = fopen(database->path, "rb");
-    if (stream->underlying_stream == NULL) {
+    if (!tig_database_stream_init(database, entry, mode, NULL, stream)) {
         return false;
     }
 
-    if (fseek(stream->underlying_stream, entry->offset, SEEK_SET) != 0) {
-        return false;
-    }
+    stream->next = database->open_file_handles_head;
+    database->open_file_handles_head = stream;
+
+    return true;
+}
+
+// Prepares stream for reading `entry` (either from the archive, or from the
+// given `contents`) without registering it in the database.
+bool tig_database_stream_init(TigDatabase* database, TigDatabaseEntry* entry, const char* mode, TigDatabaseMapping* contents, TigDatabaseFileHandle* stream)
+{
+    memset(stream, 0, sizeof(*stream));
 
+    stream->database = database;
     stream->entry = entry;
 
     if (mode[1] == 't') {
         stream->flags |= TIG_DATABASE_FILE_TEXT_MODE;
     }
 
+    if (contents != NULL) {
+        SDL_AtomicIncRef(&(contents->refcount));
+        stream->contents = contents;
+        stream->data = contents->data;
+        return true;
+    }
+
+    if (database->mapping != NULL) {
+        // Reject entries pointing outside of the archive.
+        if (entry->offset < 0
+            || (size_t)entry->offset > database->mapping->size
+            || database->mapping->size - (size_t)entry->offset < ((entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) != 0 ? entry->compressed_size : entry->size)) {
+            return false;
+        }
+
+        stream->data = database->mapping->data + entry->offset;
+    } else {
+        stream->underlying_stream = fopen(database->path, "rb");
+        if (stream->underlying_stream == NULL) {
+            return false;
+        }
+
+        if (fseek(stream->underlying_stream, entry->offset, SEEK_SET) != 0) {
+            // FIX: Leaks `underlying_stream`.
+            fclose(stream->underlying_stream);
+            return false;
+        }
+    }
+
     if ((entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) != 0) {
         stream->decompression_context = (DecompressionContext*)MALLOC(sizeof(DecompressionContext));
+        stream->decompression_context->checkpoints = NULL;
+        stream->decompression_context->checkpoints_count = 0;
         stream->decompression_context->zstrm.next_in = stream->decompression_context->buffer;
         stream->decompression_context->zstrm.avail_in = 0;
         stream->decompression_context->zstrm.zalloc = Z_NULL;
@@ -872,18 +1077,30 @@ bool tig_database_fopen_internal(TigDatabase* database, TigDatabaseEntry* entry,
 
         if (inflateInit(&(stream->decompression_context->zstrm)) != Z_OK) {
             FREE(stream->decompression_context);
-            fclose(stream->underlying_stream);
+            stream->decompression_context = NULL;
+            if (stream->underlying_stream != NULL) {
+                fclose(stream->underlying_stream);
+            }
             return false;
         }
-    }
 
-    stream->database = database;
-    stream->next = database->open_file_handles_head;
-    database->open_file_handles_head = stream;
+        if (stream->data != NULL) {
+            // The entire compressed stream is available up front.
+            stream->decompression_context->zstrm.next_in = (Bytef*)stream->data;
+            stream->decompression_context->zstrm.avail_in = entry->compressed_size;
+            stream->compressed_pos = entry->compressed_size;
+        }
+    }
 
     return true;
 }
 
+bool tig_database_stream_is_plain(TigDatabaseFileHandle* stream)
+{
+    return stream->contents != NULL
+        || (stream->entry->flags & TIG_DATABASE_ENTRY_PLAIN) != 0;
+}
+
 // 0x53D040
 int tig_database_fgetc_internal(TigDatabaseFileHandle* stream)
 {
@@ -916,42 +1133,266 @@ bool tig_database_fread_internal(void* buffer, size_t size, TigDatabaseFileHandl
     size_t bytes_to_read;
     int rc;
 
-    if ((stream->entry->flags & TIG_DATABASE_ENTRY_PLAIN) != 0) {
-        if (fread(buffer, size, 1, stream->underlying_stream) != 1) {
+    if (tig_database_stream_is_plain(stream)) {
+        if (stream->data != NULL) {
+            memcpy(buffer, stream->data + stream->pos, size);
+        } else if (fread(buffer, size, 1, stream->underlying_stream) != 1) {
             stream->flags |= TIG_DATABASE_FILE_ERROR;
             return false;
         }
     } else if ((stream->entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) != 0) {
-        stream->decompression_context->zstrm.next_out = (Bytef*)buffer;
-        stream->decompression_context->zstrm.avail_out = (uInt)size;
-
-        while (stream->decompression_context->zstrm.avail_out != 0) {
-            if (stream->decompression_context->zstrm.avail_in == 0) {
-                // No more unprocessed data, request next chunk.
-                bytes_to_read = stream->entry->compressed_size - stream->compressed_pos;
-                if (bytes_to_read > DECOMPRESSION_BUFFER_SIZE) {
-                    bytes_to_read = DECOMPRESSION_BUFFER_SIZE;
+        DecompressionContext* ctx = stream->decompression_context;
+        unsigned int out_pos = (unsigned int)stream->pos;
+        unsigned int next_checkpoint;
+        size_t chunk_size;
+
+        ctx->zstrm.next_out = (Bytef*)buffer;
+
+        while (size > 0) {
+            // Stop at checkpoint boundaries so that inflate state can be
+            // captured at the exact position.
+            chunk_size = size;
+            next_checkpoint = (out_pos / CHECKPOINT_INTERVAL + 1) * CHECKPOINT_INTERVAL;
+            if (chunk_size > next_checkpoint - out_pos) {
+                chunk_size = next_checkpoint - out_pos;
+            }
+
+            ctx->zstrm.avail_out = (uInt)chunk_size;
+
+            while (ctx->zstrm.avail_out != 0) {
+                if (ctx->zstrm.avail_in == 0) {
+                    // Mapped streams are given all compressed data at once,
+                    // running out of input means the entry is corrupted.
+                    if (stream->data != NULL) {
+                        stream->flags |= TIG_DATABASE_FILE_ERROR;
+                        return false;
+                    }
+
+                    // No more unprocessed data, request next chunk.
+                    bytes_to_read = stream->entry->compressed_size - stream->compressed_pos;
+                    if (bytes_to_read > DECOMPRESSION_BUFFER_SIZE) {
+                        bytes_to_read = DECOMPRESSION_BUFFER_SIZE;
+                    }
+
+                    if (fread(ctx->buffer, bytes_to_read, 1, stream->underlying_stream) != 1) {
+                        stream->flags |= TIG_DATABASE_FILE_ERROR;
+                        return false;
+                    }
+
+                    stream->compressed_pos += bytes_to_read;
+                    ctx->zstrm.avail_in = (uInt)bytes_to_read;
+                    ctx->zstrm.next_in = (Bytef*)ctx->buffer;
                 }
 
-                if (fread(stream->decompression_context->buffer, bytes_to_read, 1, stream->underlying_stream) != 1) {
+                rc = inflate(&(ctx->zstrm), Z_NO_FLUSH);
+                if (rc != Z_OK && rc != Z_STREAM_END) {
                     stream->flags |= TIG_DATABASE_FILE_ERROR;
                     return false;
                 }
 
-                stream->compressed_pos += bytes_to_read;
-                stream->decompression_context->zstrm.avail_in = (uInt)bytes_to_read;
-                stream->decompression_context->zstrm.next_in = (Bytef*)stream->decompression_context->buffer;
+                // FIX: Guard against truncated entries, otherwise this loop
+                // never ends.
+                if (rc == Z_STREAM_END && ctx->zstrm.avail_out != 0) {
+                    stream->flags |= TIG_DATABASE_FILE_ERROR;
+                    return false;
+                }
             }
 
-            rc = inflate(&(stream->decompression_context->zstrm), Z_NO_FLUSH);
-            if (rc != Z_OK && rc != Z_STREAM_END) {
-                stream->flags |= TIG_DATABASE_FILE_ERROR;
-                return false;
+            out_pos += (unsigned int)chunk_size;
+            size -= chunk_size;
+            stream->pos += (int)chunk_size;
+
+            if (out_pos == next_checkpoint && out_pos < stream->entry->size) {
+                tig_database_checkpoint_add(stream);
             }
         }
+
+        return true;
     }
 
     stream->pos += size;
 
     return true;
 }
+
+TigDatabaseMapping* tig_database_mapping_create(const char* path, size_t size)
+{
+    TigDatabaseMapping* mapping;
+    int kb;
+    void* data;
+
+    kb = (int)((size + 1023) / 1024);
+    if (SDL_AddAtomicInt(&tig_database_mapped_kb, kb) + kb > MAPPING_BUDGET_KB) {
+        SDL_AddAtomicInt(&tig_database_mapped_kb, -kb);
+        return NULL;
+    }
+
+    data = compat_map_file(path, &size);
+    if (data == NULL) {
+        SDL_AddAtomicInt(&tig_database_mapped_kb, -kb);
+        return NULL;
+    }
+
+    mapping = (TigDatabaseMapping*)MALLOC(sizeof(*mapping));
+    mapping->data = (unsigned char*)data;
+    mapping->size = size;
+    mapping->heap = false;
+    mapping->budget_kb = kb;
+    SDL_SetAtomicInt(&(mapping->refcount), 1);
+
+    return mapping;
+}
+
+void tig_database_mapping_release(TigDatabaseMapping* mapping)
+{
+    if (SDL_AtomicDecRef(&(mapping->refcount))) {
+        if (mapping->heap) {
+            FREE(mapping->data);
+        } else {
+            compat_unmap_file(mapping->data, mapping->size);
+            SDL_AddAtomicInt(&tig_database_mapped_kb, -mapping->budget_kb);
+        }
+        FREE(mapping);
+    }
+}
+
+// Resets inflate state to the beginning of the compressed entry.
+bool tig_database_inflate_reset(TigDatabaseFileHandle* stream)
+{
+    DecompressionContext* ctx = stream->decompression_context;
+
+    if (stream->data == NULL
+        && fseek(stream->underlying_stream, stream->entry->offset, SEEK_SET) != 0) {
+        return false;
+    }
+
+    stream->compressed_pos = 0;
+    stream->pos = 0;
+    inflateEnd(&(ctx->zstrm));
+
+    ctx->zstrm.next_in = NULL;
+    ctx->zstrm.avail_in = 0;
+    ctx->zstrm.next_out = NULL;
+    ctx->zstrm.avail_out = 0;
+
+    if (inflateInit(&(ctx->zstrm)) != Z_OK) {
+        return false;
+    }
+
+    if (stream->data != NULL) {
+        ctx->zstrm.next_in = (Bytef*)stream->data;
+        ctx->zstrm.avail_in = stream->entry->compressed_size;
+        stream->compressed_pos = stream->entry->compressed_size;
+    }
+
+    return true;
+}
+
+// Captures inflate state at the current position of the stream.
+void tig_database_checkpoint_add(TigDatabaseFileHandle* stream)
+{
+    DecompressionContext* ctx = stream->decompression_context;
+    DecompressionCheckpoint* checkpoint;
+
+    // Checkpoints are taken in order as the stream is read for the first
+    // time, revisiting known positions adds nothing.
+    if (ctx->checkpoints_count > 0
+        && ctx->checkpoints[ctx->checkpoints_count - 1].pos >= (unsigned int)stream->pos) {
+        return;
+    }
+
+    // Allocate room for every interval boundary inside the entry up front,
+    // since the number of checkpoints is known from its size.
+    if (ctx->checkpoints == NULL) {
+        ctx->checkpoints = (DecompressionCheckpoint*)MALLOC(sizeof(*ctx->checkpoints) * ((stream->entry->size - 1) / CHECKPOINT_INTERVAL));
+    }
+
+    checkpoint = &(ctx->checkpoints[ctx->checkpoints_count]);
+    if (inflateCopy(&(checkpoint->zstrm), &(ctx->zstrm)) != Z_OK) {
+        return;
+    }
+
+    checkpoint->pos = (unsigned int)stream->pos;
+    if (stream->data != NULL) {
+        checkpoint->compressed_pos = (unsigned int)(ctx->zstrm.next_in - stream->data);
+    } else {
+        checkpoint->compressed_pos = (unsigned int)stream->compressed_pos - ctx->zstrm.avail_in;
+    }
+
+    ctx->checkpoints_count++;
+}
+
+// Moves inflate state to the closest checkpoint at or before `pos`, provided
+// it's closer than the current position. Returns `false` if there is no such
+// checkpoint (the state is left intact).
+bool tig_database_checkpoint_restore(TigDatabaseFileHandle* stream, unsigned int pos)
+{
+    DecompressionContext* ctx = stream->decompression_context;
+    DecompressionCheckpoint* checkpoint;
+    int lo;
+    int hi;
+    int mid;
+
+    lo = 0;
+    hi = ctx->checkpoints_count - 1;
+    checkpoint = NULL;
+    while (lo <= hi) {
+        mid = (lo + hi) / 2;
+        if (ctx->checkpoints[mid].pos <= pos) {
+            checkpoint = &(ctx->checkpoints[mid]);
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    if (checkpoint == NULL) {
+        return false;
+    }
+
+    // Reading forward from the current position is cheaper.
+    if ((unsigned int)stream->pos <= pos && (unsigned int)stream->pos >= checkpoint->pos) {
+        return false;
+    }
+
+    if (stream->data == NULL
+        && fseek(stream->underlying_stream, stream->entry->offset + (int)checkpoint->compressed_pos, SEEK_SET) != 0) {
+        return false;
+    }
+
+    inflateEnd(&(ctx->zstrm));
+    if (inflateCopy(&(ctx->zstrm), &(checkpoint->zstrm)) != Z_OK) {
+        // The stream is unusable at this point, start over.
+        memset(&(ctx->zstrm), 0, sizeof(ctx->zstrm));
+        return tig_database_inflate_reset(stream);
+    }
+
+    if (stream->data != NULL) {
+        ctx->zstrm.next_in = (Bytef*)stream->data + checkpoint->compressed_pos;
+        ctx->zstrm.avail_in = stream->entry->compressed_size - checkpoint->compressed_pos;
+    } else {
+        ctx->zstrm.next_in = ctx->buffer;
+        ctx->zstrm.avail_in = 0;
+        stream->compressed_pos = (int)checkpoint->compressed_pos;
+    }
+
+    stream->pos = (int)checkpoint->pos;
+
+    return true;
+}
+
+void tig_database_checkpoints_clear(DecompressionContext* ctx)
+{
+    int index;
+
+    for (index = 0; index < ctx->checkpoints_count; index++) {
+        inflateEnd(&(ctx->checkpoints[index].zstrm));
+    }
+
+    if (ctx->checkpoints != NULL) {
+        FREE(ctx->checkpoints);
+        ctx->checkpoints = NULL;
+    }
+
+    ctx->checkpoints_count = 0;
+}
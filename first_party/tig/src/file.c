@@ -7,6 +7,7 @@
 #include <string.h>
 
 #include <fpattern/fpattern.h>
+#include <zlib.h>
 
 #include "tig/compat.h"
 #include "tig/core.h"
@@ -50,6 +51,130 @@ typedef struct TigFileIgnore {
     /* 0008 */ struct TigFileIgnore* next;
 } TigFileIgnore;
 
+// Maximum number of paths remembered as missing from every directory
+// repository. The set is simply dropped when it overflows.
+#define TIG_FILE_MISS_MAX 8192
+#define TIG_FILE_MISS_BUCKETS 1024
+
+// An entry of the archive index.
+//
+// Nodes with the same path are chained in repository order, so the first
+// match is the entry which wins the lookup.
+typedef struct TigFileIndexNode {
+    unsigned int hash;
+    int next;
+    TigFileRepository* repo;
+    TigDatabaseEntry* entry;
+} TigFileIndexNode;
+
+// A path known to be absent from every directory repository.
+typedef struct TigFileMissNode {
+    unsigned int hash;
+    char* path;
+    struct TigFileMissNode* next;
+} TigFileMissNode;
+
+#define TIG_FILE_PREFETCH_MAX_WORKERS 4
+
+// Maximum amount of prefetched contents waiting to be opened. The oldest
+// contents are dropped when the limit is exceeded.
+#define TIG_FILE_PREFETCH_BUDGET (32 * 1024 * 1024)
+
+#define TIG_FILE_PREFETCH_QUEUED 0
+#define TIG_FILE_PREFETCH_RUNNING 1
+#define TIG_FILE_PREFETCH_DONE 2
+#define TIG_FILE_PREFETCH_FAILED 3
+
+// Request to read an archive entry into memory on a worker thread.
+//
+// Requests are created and destroyed on the main thread only, workers merely
+// change `state` and `contents` (under `tig_file_prefetch_mutex`).
+typedef struct TigFilePrefetchRequest {
+    unsigned int handle;
+    int priority;
+    int state;
+    TigDatabase* database;
+    TigDatabaseEntry* entry;
+    TigDatabaseMapping* contents;
+    struct TigFilePrefetchRequest* next;
+} TigFilePrefetchRequest;
+
+// Index of the save archive (.tfai) starts with this record type, archives
+// without it are in the original format (a tree of enter/leave directory and
+// file records, with contents laid out back to back in the data file).
+#define TIG_FILE_ARCHIVE_HEADER 4
+#define TIG_FILE_ARCHIVE_END 3
+#define TIG_FILE_ARCHIVE_VERSION 2
+
+#define TIG_FILE_ARCHIVE_ENTRY_DIRECTORY 0x1
+#define TIG_FILE_ARCHIVE_ENTRY_COMPRESSED 0x2
+
+// Maximum amount of file contents processed by workers at once.
+#define TIG_FILE_ARCHIVE_BATCH_SIZE (32 * 1024 * 1024)
+#define TIG_FILE_ARCHIVE_MAX_WORKERS 8
+
+// An entry of the save archive index. Contents of the entry lives at `offset`
+// in the data file (.tfaf), compressed with zlib if the respective flag is set.
+//
+// `data`, `stored_data`, `unchanged` and `failed` are only used while the
+// archive is being written or extracted.
+typedef struct TigFileArchiveEntry {
+    char* path;
+    unsigned int flags;
+    unsigned int size;
+    unsigned int stored_size;
+    unsigned int offset;
+    unsigned int crc;
+    unsigned int adler;
+    unsigned char* data;
+    unsigned char* stored_data;
+    bool unchanged;
+    bool failed;
+} TigFileArchiveEntry;
+
+typedef struct TigFileArchiveIndex {
+    TigFileArchiveEntry* entries;
+    int count;
+    int capacity;
+} TigFileArchiveIndex;
+
+// Size of the read buffer of streams opened with `tig_file_io_open`.
+#define TIG_FILE_IO_BUFFER_SIZE 0x10000
+
+// Amount of already consumed data kept at the beginning of the read buffer when
+// it's refilled, so that short backward seeks (which decoders do a lot) are
+// served from memory rather than rewinding compressed archive entries.
+#define TIG_FILE_IO_KEEP_SIZE 0x2000
+
+// State of the `SDL_IOStream` over `TigFile` (see `tig_file_io_open`).
+//
+// Streams opened for reading are buffered, `buffer` holds `buffer_len` bytes
+// of the file starting at `buffer_pos`, `pos` is the logical position and
+// `stream_pos` is the position of the underlying `stream`. Streams opened for
+// writing are passed through (`buffer` is `NULL`).
+typedef struct TigFileIo {
+    TigFile* stream;
+    unsigned char* buffer;
+    size_t buffer_len;
+    Sint64 buffer_pos;
+    Sint64 stream_pos;
+    Sint64 pos;
+} TigFileIo;
+
+typedef struct TigFileArchiveBatch TigFileArchiveBatch;
+
+typedef void(TigFileArchiveJobFunc)(TigFileArchiveBatch* batch, TigFileArchiveEntry* entry);
+
+// Set of entries processed by worker threads, every entry is handed to exactly
+// one of them.
+typedef struct TigFileArchiveBatch {
+    TigFileArchiveEntry** entries;
+    int count;
+    SDL_AtomicInt next;
+    TigFileArchiveJobFunc* func;
+    TigFileArchiveIndex* reuse_index;
+} TigFileArchiveBatch;
+
 static bool tig_file_mkdir_native(const char* path);
 static bool tig_file_rmdir_native(const char* path);
 static bool tig_file_empty_directory_native(const char* path);
@@ -60,7 +185,25 @@ static bool tig_file_unarchive_native(const char* src, const char* dst);
 static bool copy_file_path(const char* dst, const char* src);
 static bool copy_file_stream(TigFile* dst_stream, TigFile* src_stream);
 static bool copy_file_stream_size(TigFile* dst_stream, TigFile* src_stream, size_t size);
-static bool tig_file_archive_worker_native(const char* path, TigFile* stream1, TigFile* stream2);
+static bool tig_file_unarchive_sync_native(const char* src, const char* dst);
+static void tig_file_archive_entry_path(char* path, size_t size, const char* root, const char* rel_path);
+static void tig_file_archive_index_add(TigFileArchiveIndex* index, const char* rel_path, unsigned int flags, unsigned int size);
+static bool tig_file_archive_collect(TigFileArchiveIndex* index, const char* path, const char* rel_path);
+static int tig_file_archive_entry_compare(const void* a, const void* b);
+static void tig_file_archive_index_sort(TigFileArchiveIndex* index);
+static TigFileArchiveEntry* tig_file_archive_index_find(TigFileArchiveIndex* index, const char* rel_path);
+static bool tig_file_archive_index_read(TigFile* stream, TigFileArchiveIndex* index);
+static bool tig_file_archive_index_write(TigFile* stream, TigFileArchiveIndex* index);
+static void tig_file_archive_index_free(TigFileArchiveIndex* index);
+static void tig_file_archive_entry_release(TigFileArchiveEntry* entry);
+static int tig_file_archive_worker(void* userdata);
+static void tig_file_archive_run(TigFileArchiveBatch* batch, TigFileArchiveJobFunc* func);
+static void tig_file_archive_pack(TigFileArchiveBatch* batch, TigFileArchiveEntry* entry);
+static bool tig_file_archive_pack_entries(TigFileArchiveIndex* index, TigFileArchiveIndex* reuse_index, const char* src, TigFile* data_stream);
+static void tig_file_archive_verify(TigFileArchiveBatch* batch, TigFileArchiveEntry* entry);
+static void tig_file_archive_unpack(TigFileArchiveBatch* batch, TigFileArchiveEntry* entry);
+static bool tig_file_archive_prune(TigFileArchiveIndex* index, const char* path, const char* rel_path);
+static bool tig_file_unarchive_entries(TigFileArchiveIndex* index, TigFile* data_stream, const char* dst, bool sync);
 static bool tig_file_repository_add_native(const char* path);
 static bool tig_file_repository_remove_native(const char* file_name);
 static int tig_file_mkdir_ex_native(const char* path);
@@ -84,6 +227,25 @@ static unsigned int tig_file_ignored(const char* path);
 static bool tig_file_copy_native(const char* src, const char* dst);
 static bool tig_file_copy_internal(TigFile* dst, TigFile* src);
 static int tig_file_rmdir_recursively_native(const char* path);
+static bool tig_file_map_contents_native(const char* path, TigFileMapping* mapping);
+static unsigned int tig_file_index_hash(const char* path);
+static void tig_file_index_rebuild(void);
+static void tig_file_index_free(void);
+static TigFileIndexNode* tig_file_index_find(const char* path, unsigned int hash);
+static bool tig_file_miss_contains(const char* path, unsigned int hash);
+static void tig_file_miss_add(const char* path, unsigned int hash);
+static void tig_file_miss_clear(void);
+static void tig_file_prefetch_init(void);
+static void tig_file_prefetch_exit(void);
+static unsigned int tig_file_prefetch_native(const char* path, int priority);
+static bool tig_file_locate_native(const char* path, TigFileLocation* location);
+static int tig_file_prefetch_worker(void* userdata);
+static TigFilePrefetchRequest* tig_file_prefetch_next_queued(void);
+static void tig_file_prefetch_run(TigFilePrefetchRequest* request);
+static void tig_file_prefetch_complete(TigFilePrefetchRequest* request);
+static void tig_file_prefetch_discard(TigFilePrefetchRequest* request);
+static void tig_file_prefetch_flush(void);
+static TigDatabaseMapping* tig_file_prefetch_take(TigDatabase* database, TigDatabaseEntry* entry);
 
 // 0x62B2A8
 static TigFileIgnore* off_62B2A8;
@@ -94,6 +256,31 @@ static TigFileRepository* tig_file_repositories_head;
 // 0x62B2B0
 static TigFileIgnore* tig_file_ignore_head;
 
+// Hash index of entries of every archive repository, rebuilt whenever the set
+// or the order of repositories changes.
+static TigFileIndexNode* tig_file_index_nodes;
+static int* tig_file_index_buckets;
+static unsigned int tig_file_index_mask;
+
+// Negative lookup cache for directory repositories. Any operation which can
+// create files through this module drops it.
+static TigFileMissNode* tig_file_miss_buckets[TIG_FILE_MISS_BUCKETS];
+static int tig_file_miss_count;
+
+// Prefetch worker pool.
+static SDL_Mutex* tig_file_prefetch_mutex;
+static SDL_Condition* tig_file_prefetch_queued_cond;
+static SDL_Condition* tig_file_prefetch_done_cond;
+static SDL_Thread* tig_file_prefetch_workers[TIG_FILE_PREFETCH_MAX_WORKERS];
+static int tig_file_prefetch_workers_count;
+static bool tig_file_prefetch_quit;
+
+// Outstanding requests in submission order.
+static TigFilePrefetchRequest* tig_file_prefetch_requests_head;
+static int tig_file_prefetch_requests_count;
+static size_t tig_file_prefetch_contents_size;
+static unsigned int tig_file_prefetch_next_handle;
+
 // 0x52DFE0
 bool tig_file_mkdir_native(const char* path)
 {
@@ -239,36 +426,95 @@ bool tig_file_archive_native(const char* dst, const char* src)
     char data_path[TIG_MAX_PATH];
     TigFile* index_stream;
     TigFile* data_stream;
+    TigFileArchiveIndex index;
+    TigFileArchiveIndex prev_index;
+    TigFileArchiveIndex* reuse_index;
     bool success;
-    int type;
+    int data_size;
+    unsigned int live_size;
+    int entry_index;
+    TigFileArchiveEntry* prev;
 
     if (!tig_file_is_directory(src)) {
         return false;
     }
 
-    SDL_snprintf(index_path, sizeof(index_path), "%s.tfai", dst);
-    index_stream = tig_file_fopen_native(index_path, "wb");
-    if (index_stream == NULL) {
+    memset(&index, 0, sizeof(index));
+    if (!tig_file_archive_collect(&index, src, "")) {
+        tig_file_archive_index_free(&index);
         return false;
     }
+    tig_file_archive_index_sort(&index);
 
+    SDL_snprintf(index_path, sizeof(index_path), "%s.tfai", dst);
     SDL_snprintf(data_path, sizeof(data_path), "%s.tfaf", dst);
-    data_stream = tig_file_fopen_native(data_path, "wb");
-    if (data_stream == NULL) {
+
+    // Try to append changed entries to the data file of the previous archive
+    // at the same location.
+    memset(&prev_index, 0, sizeof(prev_index));
+    reuse_index = NULL;
+    data_stream = NULL;
+
+    index_stream = tig_file_fopen_native(index_path, "rb");
+    if (index_stream != NULL) {
+        if (tig_file_archive_index_read(index_stream, &prev_index)) {
+            data_stream = tig_file_fopen_native(data_path, "r+b");
+        }
         tig_file_fclose(index_stream);
-        return false;
     }
 
-    success = tig_file_archive_worker_native(src, index_stream, data_stream);
+    if (data_stream != NULL) {
+        if (tig_file_fseek(data_stream, 0, SEEK_END) == 0
+            && (data_size = tig_file_ftell(data_stream)) >= 0) {
+            live_size = 0;
+            for (entry_index = 0; entry_index < index.count; entry_index++) {
+                prev = tig_file_archive_index_find(&prev_index, index.entries[entry_index].path);
+                if (prev != NULL) {
+                    live_size += prev->stored_size;
+                }
+            }
+
+            // Compact the data file once unreferenced contents start to
+            // dominate it (this is approximate, entries which are going to be
+            // replaced are counted as live).
+            if (live_size >= (unsigned int)data_size / 2) {
+                reuse_index = &prev_index;
+            }
+        }
+
+        if (reuse_index == NULL) {
+            tig_file_fclose(data_stream);
+            data_stream = NULL;
+        }
+    }
+
+    if (data_stream == NULL) {
+        data_stream = tig_file_fopen_native(data_path, "wb");
+        if (data_stream == NULL) {
+            tig_file_archive_index_free(&prev_index);
+            tig_file_archive_index_free(&index);
+            return false;
+        }
+    }
+
+    success = tig_file_archive_pack_entries(&index, reuse_index, src, data_stream);
+
+    if (tig_file_fclose(data_stream) != 0) {
+        success = false;
+    }
+
     if (success) {
-        type = 3;
-        if (tig_file_fwrite(&type, sizeof(type), 1, index_stream) != 1) {
+        index_stream = tig_file_fopen_native(index_path, "wb");
+        if (index_stream != NULL) {
+            success = tig_file_archive_index_write(index_stream, &index);
+            tig_file_fclose(index_stream);
+        } else {
             success = false;
         }
     }
 
-    tig_file_fclose(data_stream);
-    tig_file_fclose(index_stream);
+    tig_file_archive_index_free(&prev_index);
+    tig_file_archive_index_free(&index);
 
     if (!success) {
         tig_file_remove_native(data_path);
@@ -290,6 +536,8 @@ bool tig_file_unarchive_native(const char* src, const char* dst)
     int size;
     char* pch;
     TigFile* tmp_stream;
+    TigFileArchiveIndex index;
+    bool success;
 
     tig_file_mkdir(dst);
 
@@ -306,6 +554,19 @@ bool tig_file_unarchive_native(const char* src, const char* dst)
         return false;
     }
 
+    // Archives written by the current version have index up front.
+    memset(&index, 0, sizeof(index));
+    if (tig_file_archive_index_read(index_stream, &index)) {
+        success = tig_file_unarchive_entries(&index, data_stream, dst, false);
+        tig_file_archive_index_free(&index);
+        tig_file_fclose(data_stream);
+        tig_file_fclose(index_stream);
+        return success;
+    }
+
+    tig_file_archive_index_free(&index);
+    tig_file_rewind(index_stream);
+
     strcpy(path2, dst);
 
     while (tig_file_fread(&type, sizeof(type), 1, index_stream) == 1) {
@@ -366,6 +627,60 @@ bool tig_file_unarchive_native(const char* src, const char* dst)
     return false;
 }
 
+// Makes `dst` mirror contents of the archive. Files which are already the same
+// as in the archive are not rewritten, files which are not in the archive are
+// removed.
+bool tig_file_unarchive_sync_native(const char* src, const char* dst)
+{
+    char path[TIG_MAX_PATH];
+    TigFile* index_stream;
+    TigFile* data_stream;
+    TigFileArchiveIndex index;
+    bool success;
+
+    SDL_snprintf(path, sizeof(path), "%s.tfai", src);
+    index_stream = tig_file_fopen_native(path, "rb");
+    if (index_stream == NULL) {
+        return false;
+    }
+
+    memset(&index, 0, sizeof(index));
+    if (!tig_file_archive_index_read(index_stream, &index)) {
+        tig_file_archive_index_free(&index);
+        tig_file_fclose(index_stream);
+
+        // Archive in the original format has no checksums to compare files
+        // against, start from scratch.
+        if (tig_file_is_directory_native(dst)
+            && !tig_file_empty_directory_native(dst)) {
+            return false;
+        }
+
+        return tig_file_unarchive_native(src, dst);
+    }
+
+    tig_file_fclose(index_stream);
+
+    SDL_snprintf(path, sizeof(path), "%s.tfaf", src);
+    data_stream = tig_file_fopen_native(path, "rb");
+    if (data_stream == NULL) {
+        tig_file_archive_index_free(&index);
+        return false;
+    }
+
+    if (!tig_file_is_directory_native(dst)) {
+        tig_file_mkdir_native(dst);
+    }
+
+    success = tig_file_archive_prune(&index, dst, "")
+        && tig_file_unarchive_entries(&index, data_stream, dst, true);
+
+    tig_file_fclose(data_stream);
+    tig_file_archive_index_free(&index);
+
+    return success;
+}
+
 // 0x52E840
 bool copy_file_path(const char* dst, const char* src)
 {
@@ -438,92 +753,72 @@ bool copy_file_stream_size(TigFile* dst_stream, TigFile* src_stream, size_t size
     return true;
 }
 
-// 0x52E9C0
-bool tig_file_archive_worker_native(const char* path, TigFile* index_stream, TigFile* data_stream)
+// Builds native path of the archive entry (entry paths always use backslashes).
+void tig_file_archive_entry_path(char* path, size_t size, const char* root, const char* rel_path)
 {
-    char pattern[TIG_MAX_PATH];
-    TigFileList list;
-    unsigned int index;
-    int type;
-    int size;
-    TigFile* tmp_stream;
-
-    compat_join_path(pattern, sizeof(pattern), path, "*.*");
-    tig_file_list_create_native(&list, pattern);
-
-    for (index = 0; index < list.count; index++) {
-        if ((list.entries[index].attributes & TIG_FILE_ATTRIBUTE_SUBDIR) != 0) {
-            if (strcmp(list.entries[index].path, ".") != 0
-                && strcmp(list.entries[index].path, "..") != 0) {
-                type = 1;
-                if (tig_file_fwrite(&type, sizeof(type), 1, index_stream) != 1) {
-                    // FIXME: Leaks `list`.
-                    return false;
-                }
+    char* pch;
 
-                size = (int)strlen(list.entries[index].path);
-                if (tig_file_fwrite(&size, sizeof(size), 1, index_stream) != 1) {
-                    // FIXME: Leaks `list`.
-                    return false;
-                }
+    compat_join_path(path, size, root, rel_path);
 
-                if (tig_file_fputs(list.entries[index].path, index_stream) < 0) {
-                    // FIXME: Leaks `list`.
-                    return false;
-                }
+    pch = path + strlen(root);
+    while (*pch != '\0') {
+        if (*pch == '\\') {
+            *pch = PATH_SEPARATOR;
+        }
+        pch++;
+    }
+}
 
-                compat_join_path(pattern, sizeof(pattern), path, list.entries[index].path);
+void tig_file_archive_index_add(TigFileArchiveIndex* index, const char* rel_path, unsigned int flags, unsigned int size)
+{
+    TigFileArchiveEntry* entry;
 
-                if (!tig_file_archive_worker_native(pattern, index_stream, data_stream)) {
-                    // FIXME: Leaks `list`.
-                    return false;
-                }
+    if (index->count == index->capacity) {
+        index->capacity = index->capacity != 0 ? index->capacity * 2 : 64;
+        index->entries = (TigFileArchiveEntry*)REALLOC(index->entries, sizeof(*index->entries) * index->capacity);
+    }
 
-                type = 2;
-                if (tig_file_fwrite(&type, sizeof(type), 1, index_stream) != 1) {
-                    // FIXME: Leaks `list`.
-                    return false;
-                }
-            }
-        } else {
-            type = 0;
-            if (tig_file_fwrite(&type, sizeof(type), 1, index_stream) != 1) {
-                // FIXME: Leaks `list`.
-                return false;
-            }
+    entry = &(index->entries[index->count++]);
+    memset(entry, 0, sizeof(*entry));
+    entry->path = STRDUP(rel_path);
+    entry->flags = flags;
+    entry->size = size;
+}
 
-            size = (int)strlen(list.entries[index].path);
-            if (tig_file_fwrite(&size, sizeof(size), 1, index_stream) != 1) {
-                // FIXME: Leaks `list`.
-                return false;
-            }
+// Adds every file and subdirectory of `path` (recursively) to the index.
+bool tig_file_archive_collect(TigFileArchiveIndex* index, const char* path, const char* rel_path)
+{
+    char pattern[TIG_MAX_PATH];
+    char child_rel_path[TIG_MAX_PATH];
+    TigFileList list;
+    unsigned int entry_index;
+    const char* name;
 
-            if (tig_file_fputs(list.entries[index].path, index_stream) < 0) {
-                // FIXME: Leaks `list`.
-                return false;
-            }
+    compat_join_path(pattern, sizeof(pattern), path, "*.*");
+    tig_file_list_create_native(&list, pattern);
 
-            size = (int)list.entries[index].size;
-            if (tig_file_fwrite(&size, sizeof(size), 1, index_stream) != 1) {
-                // FIXME: Leaks `list`.
-                return false;
-            }
+    for (entry_index = 0; entry_index < list.count; entry_index++) {
+        name = list.entries[entry_index].path;
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) {
+            continue;
+        }
 
-            compat_join_path(pattern, sizeof(pattern), path, list.entries[index].path);
+        if (rel_path[0] != '\0') {
+            SDL_snprintf(child_rel_path, sizeof(child_rel_path), "%s\\%s", rel_path, name);
+        } else {
+            SDL_strlcpy(child_rel_path, name, sizeof(child_rel_path));
+        }
 
-            tmp_stream = tig_file_fopen(pattern, "rb");
-            if (tmp_stream == NULL) {
-                // FIXME: Leaks `list`.
-                return false;
-            }
+        if ((list.entries[entry_index].attributes & TIG_FILE_ATTRIBUTE_SUBDIR) != 0) {
+            tig_file_archive_index_add(index, child_rel_path, TIG_FILE_ARCHIVE_ENTRY_DIRECTORY, 0);
 
-            if (!copy_file_stream(data_stream, tmp_stream)) {
-                // FIXME: Leaks `tmp_stream`.
-                // FIXME: Leaks `list`.
+            compat_join_path(pattern, sizeof(pattern), path, name);
+            if (!tig_file_archive_collect(index, pattern, child_rel_path)) {
+                tig_file_list_destroy(&list);
                 return false;
             }
-
-            tig_file_fclose(tmp_stream);
+        } else {
+            tig_file_archive_index_add(index, child_rel_path, 0, (unsigned int)list.entries[entry_index].size);
         }
     }
 
@@ -531,1482 +826,2882 @@ bool tig_file_archive_worker_native(const char* path, TigFile* index_stream, Tig
     return true;
 }
 
-// 0x52ECA0
-int tig_file_init(TigInitInfo* init_info)
+int tig_file_archive_entry_compare(const void* a, const void* b)
 {
-    (void)init_info;
-
-    // FIX: Make `tig.dat` mandatory.
-    //
-    // When `tig.dat` is not present in the current working directory, the
-    // original code attempts to add a repository at the path provided by
-    // `GetModuleFileNameA`, which is the full path to `Arcanum.exe`. Obviously,
-    // this is not a valid asset bundle.
-    if (!tig_file_repository_add("tig.dat")) {
-        return TIG_ERR_GENERIC;
-    }
+    const TigFileArchiveEntry* entry1 = (const TigFileArchiveEntry*)a;
+    const TigFileArchiveEntry* entry2 = (const TigFileArchiveEntry*)b;
 
-    // Current working directory.
-    tig_file_repository_add(".");
+    return SDL_strcasecmp(entry1->path, entry2->path);
+}
 
-    return TIG_OK;
+// Sorts entries by path. Subdirectories go after their parents.
+void tig_file_archive_index_sort(TigFileArchiveIndex* index)
+{
+    if (index->count > 1) {
+        qsort(index->entries, index->count, sizeof(*index->entries), tig_file_archive_entry_compare);
+    }
 }
 
-// 0x52ED00
-void tig_file_exit(void)
+// Finds entry by path in the sorted index.
+TigFileArchiveEntry* tig_file_archive_index_find(TigFileArchiveIndex* index, const char* rel_path)
 {
-    TigFileIgnore* next;
+    TigFileArchiveEntry key;
 
-    while (tig_file_ignore_head != NULL) {
-        next = tig_file_ignore_head->next;
-        if (tig_file_ignore_head->path != NULL) {
-            FREE(tig_file_ignore_head->path);
-        }
-        FREE(tig_file_ignore_head);
-        tig_file_ignore_head = next;
+    if (index->count == 0) {
+        return NULL;
     }
 
-    tig_file_repository_remove_all();
+    key.path = (char*)rel_path;
+    return (TigFileArchiveEntry*)bsearch(&key, index->entries, index->count, sizeof(*index->entries), tig_file_archive_entry_compare);
 }
 
-// 0x52ED40
-bool tig_file_repository_add_native(const char* path)
+// Reads index of the version 2 archive. Fails on the original archives.
+bool tig_file_archive_index_read(TigFile* stream, TigFileArchiveIndex* index)
 {
-    TigFileRepository* curr;
-    TigFileRepository* prev;
-    TigFileRepository* next;
-    TigFileRepository* repo;
-    SDL_PathInfo path_info;
-    TigDatabase* database;
-    char cache_path[TIG_MAX_PATH];
+    int type;
+    int version;
+    int count;
+    int length;
+    unsigned int fields[6];
+    char path[TIG_MAX_PATH];
 
-    prev = NULL;
-    curr = tig_file_repositories_head;
-    while (curr != NULL && SDL_strcasecmp(curr->path, path) != 0) {
-        prev = curr;
-        curr = curr->next;
+    if (tig_file_fread(&type, sizeof(type), 1, stream) != 1
+        || type != TIG_FILE_ARCHIVE_HEADER) {
+        return false;
     }
 
-    if (curr != NULL) {
-        if (prev != NULL) {
-            if ((curr->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0
-                && curr->next != NULL
-                && SDL_strcasecmp(curr->next->path, path) == 0) {
-                // Move repo on top of the list.
-                next = curr->next;
-                curr->next = next->next;
-                next->next = tig_file_repositories_head;
-                tig_file_repositories_head = next;
-            }
+    if (tig_file_fread(&version, sizeof(version), 1, stream) != 1
+        || version != TIG_FILE_ARCHIVE_VERSION) {
+        return false;
+    }
 
-            prev->next = curr->next;
-            curr->next = tig_file_repositories_head;
-            tig_file_repositories_head = curr;
-        }
-        return true;
+    if (tig_file_fread(&count, sizeof(count), 1, stream) != 1
+        || count < 0) {
+        return false;
     }
 
-    // NOTE: Original code is slightly different. For unknown reason (likely a
-    // bug) it treats `path` as a pattern and loops over it using
-    // `tig_find_first_file` and `tig_find_next_file`. However, it does not use
-    // the resolved file name, only the provided `path`. This means that the
-    // same repository can be added multiple times if the pattern given to this
-    // function has several matches.
-    if (SDL_GetPathInfo(path, &path_info)) {
-        if (path_info.type == SDL_PATHTYPE_DIRECTORY) {
-            repo = (TigFileRepository*)MALLOC(sizeof(TigFileRepository));
-            repo->type = 0;
-            repo->path = NULL;
-            repo->database = NULL;
-            repo->next = NULL;
+    while (count-- > 0) {
+        if (tig_file_fread(&length, sizeof(length), 1, stream) != 1
+            || length <= 0
+            || length >= TIG_MAX_PATH) {
+            return false;
+        }
 
-            repo->path = STRDUP(path);
-            repo->type = TIG_FILE_REPOSITORY_DIRECTORY;
-            repo->next = tig_file_repositories_head;
-            tig_file_repositories_head = repo;
+        if (tig_file_fread(path, length, 1, stream) != 1) {
+            return false;
+        }
+        path[length] = '\0';
 
-            tig_debug_printf("TIG File: Added path \"%s\"\n", path);
+        if (tig_file_fread(fields, sizeof(fields), 1, stream) != 1) {
+            return false;
+        }
 
-            compat_join_path(cache_path, sizeof(cache_path), tig_file_repositories_head->path, CACHE_DIR_NAME);
-            tig_file_rmdir_recursively_native(cache_path);
+        tig_file_archive_index_add(index, path, fields[0], fields[1]);
+        index->entries[index->count - 1].stored_size = fields[2];
+        index->entries[index->count - 1].offset = fields[3];
+        index->entries[index->count - 1].crc = fields[4];
+        index->entries[index->count - 1].adler = fields[5];
+    }
 
-            return true;
-        } else {
-            database = tig_database_open(path);
-            if (database != NULL) {
-                repo = (TigFileRepository*)MALLOC(sizeof(TigFileRepository));
-                repo->type = 0;
-                repo->path = NULL;
-                repo->database = NULL;
-                repo->next = NULL;
+    if (tig_file_fread(&type, sizeof(type), 1, stream) != 1
+        || type != TIG_FILE_ARCHIVE_END) {
+        return false;
+    }
 
-                repo->path = STRDUP(path);
-                repo->type = TIG_FILE_REPOSITORY_DATABASE;
-                repo->database = database;
+    tig_file_archive_index_sort(index);
 
-                repo->next = tig_file_repositories_head;
-                tig_file_repositories_head = repo;
+    return true;
+}
 
-                tig_debug_printf("TIG File: Added database \"%s\"\n", path);
+bool tig_file_archive_index_write(TigFile* stream, TigFileArchiveIndex* index)
+{
+    int type;
+    int version;
+    int length;
+    int entry_index;
+    unsigned int fields[6];
+    TigFileArchiveEntry* entry;
+
+    type = TIG_FILE_ARCHIVE_HEADER;
+    version = TIG_FILE_ARCHIVE_VERSION;
+    if (tig_file_fwrite(&type, sizeof(type), 1, stream) != 1
+        || tig_file_fwrite(&version, sizeof(version), 1, stream) != 1
+        || tig_file_fwrite(&(index->count), sizeof(index->count), 1, stream) != 1) {
+        return false;
+    }
 
-                return true;
-            }
+    for (entry_index = 0; entry_index < index->count; entry_index++) {
+        entry = &(index->entries[entry_index]);
+
+        length = (int)strlen(entry->path);
+        if (tig_file_fwrite(&length, sizeof(length), 1, stream) != 1
+            || tig_file_fwrite(entry->path, length, 1, stream) != 1) {
+            return false;
+        }
+
+        fields[0] = entry->flags;
+        fields[1] = entry->size;
+        fields[2] = entry->stored_size;
+        fields[3] = entry->offset;
+        fields[4] = entry->crc;
+        fields[5] = entry->adler;
+        if (tig_file_fwrite(fields, sizeof(fields), 1, stream) != 1) {
+            return false;
         }
     }
 
-    tig_debug_printf("TIG File: Error - Invalid path \"%s\"\n", path);
-    return false;
+    type = TIG_FILE_ARCHIVE_END;
+    if (tig_file_fwrite(&type, sizeof(type), 1, stream) != 1) {
+        return false;
+    }
+
+    return true;
 }
 
-// 0x52EF30
-bool tig_file_repository_remove_native(const char* file_name)
+void tig_file_archive_index_free(TigFileArchiveIndex* index)
 {
-    TigFileRepository* repo;
-    TigFileRepository* prev;
-    TigFileRepository* next;
-    bool removed = false;
-    char path[TIG_MAX_PATH];
-
-    prev = NULL;
-    repo = tig_file_repositories_head;
-    while (repo != NULL) {
-        if (SDL_strcasecmp(file_name, repo->path) == 0) {
-            next = repo->next;
-            if ((repo->type & TIG_FILE_DATABASE) != 0) {
-                tig_database_close(repo->database);
-            } else {
-                compat_join_path(path, sizeof(path), repo->path, CACHE_DIR_NAME);
-                tig_file_rmdir_recursively_native(path);
-            }
+    int entry_index;
 
-            if (prev != NULL) {
-                prev->next = next;
-            } else {
-                tig_file_repositories_head = next;
-            }
-
-            FREE(repo->path);
-            FREE(repo);
+    for (entry_index = 0; entry_index < index->count; entry_index++) {
+        FREE(index->entries[entry_index].path);
+    }
 
-            repo = next;
-            removed = true;
-        } else {
-            prev = repo;
-            repo = repo->next;
-        }
+    if (index->entries != NULL) {
+        FREE(index->entries);
     }
 
-    return removed;
+    memset(index, 0, sizeof(*index));
 }
 
-// 0x52F000
-bool tig_file_repository_remove_all(void)
+// Releases contents of the entry held while (un)packing it.
+void tig_file_archive_entry_release(TigFileArchiveEntry* entry)
 {
-    TigFileRepository* curr;
-    TigFileRepository* next;
-    char path[TIG_MAX_PATH];
-
-    curr = tig_file_repositories_head;
-    while (curr != NULL) {
-        next = curr->next;
-        if ((curr->type & 1) != 0) {
-            tig_database_close(curr->database);
-        } else {
-            compat_join_path(path, sizeof(path), curr->path, CACHE_DIR_NAME);
-            tig_file_rmdir_recursively_native(path);
-        }
-
-        FREE(curr->path);
-        FREE(curr);
-
-        curr = next;
+    if (entry->stored_data != NULL && entry->stored_data != entry->data) {
+        FREE(entry->stored_data);
     }
 
-    tig_file_repositories_head = NULL;
+    if (entry->data != NULL) {
+        FREE(entry->data);
+    }
 
-    return true;
+    entry->data = NULL;
+    entry->stored_data = NULL;
 }
 
-// 0x52F0A0
-bool tig_file_repository_guid(const char* path, TigGuid* guid)
+int tig_file_archive_worker(void* userdata)
 {
-    TigFileRepository* curr = tig_file_repositories_head;
-    while (curr != NULL) {
-        if ((curr->type & TIG_FILE_DATABASE) != 0) {
-            if (SDL_strcasecmp(curr->database->path, path) == 0) {
-                *guid = curr->database->guid;
-                return true;
-            }
-        }
-        curr = curr->next;
+    TigFileArchiveBatch* batch = (TigFileArchiveBatch*)userdata;
+    int index;
+
+    while ((index = SDL_AddAtomicInt(&(batch->next), 1)) < batch->count) {
+        batch->func(batch, batch->entries[index]);
     }
 
-    return false;
+    return 0;
 }
 
-// 0x52F100
-int tig_file_mkdir_ex_native(const char* path)
+// Runs `func` for every entry of the batch on worker threads (and the calling
+// thread), returns when all of them are processed.
+void tig_file_archive_run(TigFileArchiveBatch* batch, TigFileArchiveJobFunc* func)
 {
-    char temp_path[TIG_MAX_PATH];
-    size_t temp_path_length;
-    TigFileRepository* repo;
-
-    temp_path[0] = '\0';
+    SDL_Thread* threads[TIG_FILE_ARCHIVE_MAX_WORKERS];
+    int threads_count;
+    int count;
+    int index;
 
-    if (path[0] != '.' && path[0] != '\\' && path[1] != ':' && path[0] != '/') {
-        repo = tig_file_repositories_head;
-        while (repo != NULL) {
-            if ((repo->type & TIG_FILE_PLAIN) != 0) {
-                strcpy(temp_path, repo->path);
-                break;
-            }
-            repo = repo->next;
-        }
+    if (batch->count == 0) {
+        return;
     }
 
-    compat_append_path(temp_path, sizeof(temp_path), path);
+    batch->func = func;
+    SDL_SetAtomicInt(&(batch->next), 0);
 
-    temp_path_length = strlen(temp_path);
-    if (temp_path[temp_path_length] == PATH_SEPARATOR) {
-        temp_path[temp_path_length] = '\0';
+    count = SDL_GetNumLogicalCPUCores();
+    if (count > TIG_FILE_ARCHIVE_MAX_WORKERS) {
+        count = TIG_FILE_ARCHIVE_MAX_WORKERS;
     }
-
-    if (!SDL_CreateDirectory(temp_path)) {
-        return -1;
+    if (count > batch->count) {
+        count = batch->count;
     }
 
-    return 0;
-}
-
-// 0x52F230
-int tig_file_rmdir_ex_native(const char* path)
-{
-    char temp_path[TIG_MAX_PATH];
-    TigFileRepository* repo;
-
-    temp_path[0] = '\0';
-
-    if (path[0] != '.' && path[0] != '\\' && path[1] != ':' && path[0] != '/') {
-        repo = tig_file_repositories_head;
-        while (repo != NULL) {
-            if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
-                strcpy(temp_path, repo->path);
-                break;
-            }
-            repo = repo->next;
+    // NOTE: Failing to start workers is not fatal, the calling thread does the
+    // rest.
+    threads_count = 0;
+    for (index = 1; index < count; index++) {
+        threads[threads_count] = SDL_CreateThread(tig_file_archive_worker, "TIG File Archive", batch);
+        if (threads[threads_count] != NULL) {
+            threads_count++;
         }
     }
 
-    compat_append_path(temp_path, sizeof(temp_path), path);
+    tig_file_archive_worker(batch);
 
-    if (!SDL_RemovePath(temp_path)) {
-        return -1;
+    for (index = 0; index < threads_count; index++) {
+        SDL_WaitThread(threads[index], NULL);
     }
-
-    return 0;
 }
 
-// 0x52F370
-void tig_file_ignore(const char* path, unsigned int flags)
+// Checksums the contents and compresses it unless the same contents are already
+// stored in the archive being updated.
+void tig_file_archive_pack(TigFileArchiveBatch* batch, TigFileArchiveEntry* entry)
 {
-    TigFileIgnore* ignore;
-    size_t path_length;
-    char* pch;
+    TigFileArchiveEntry* prev;
+    uLongf stored_size;
+    unsigned char* stored_data;
+
+    entry->crc = (unsigned int)crc32(crc32(0, NULL, 0), entry->data, entry->size);
+    entry->adler = (unsigned int)adler32(adler32(0, NULL, 0), entry->data, entry->size);
+
+    if (batch->reuse_index != NULL) {
+        prev = tig_file_archive_index_find(batch->reuse_index, entry->path);
+        if (prev != NULL
+            && (prev->flags & TIG_FILE_ARCHIVE_ENTRY_DIRECTORY) == 0
+            && prev->size == entry->size
+            && prev->crc == entry->crc
+            && prev->adler == entry->adler) {
+            entry->flags = prev->flags;
+            entry->stored_size = prev->stored_size;
+            entry->offset = prev->offset;
+            entry->unchanged = true;
+            return;
+        }
+    }
 
-    if ((flags & (TIG_FILE_DATABASE | TIG_FILE_PLAIN)) != 0) {
-        if (fpattern_isvalid(path)) {
-            ignore = (TigFileIgnore*)MALLOC(sizeof(*ignore));
-            ignore->flags = flags;
-            ignore->path = strdup(path);
-            ignore->next = tig_file_ignore_head;
-            tig_file_ignore_head = ignore;
+    entry->stored_data = entry->data;
+    entry->stored_size = entry->size;
 
-            // Trim *.* pattern from the end of string.
-            path_length = strlen(ignore->path);
-            if (path_length > 3) {
-                pch = &(ignore->path[path_length - 3]);
-                if (strcmp(pch, "*.*") == 0) {
-                    *pch = '\0';
-                }
-            }
-        }
+    if (entry->size == 0) {
+        return;
+    }
+
+    stored_size = compressBound(entry->size);
+    stored_data = (unsigned char*)MALLOC(stored_size);
+    if (compress2(stored_data, &stored_size, entry->data, entry->size, Z_BEST_SPEED) == Z_OK
+        && stored_size < entry->size) {
+        entry->flags |= TIG_FILE_ARCHIVE_ENTRY_COMPRESSED;
+        entry->stored_data = stored_data;
+        entry->stored_size = (unsigned int)stored_size;
+    } else {
+        // Incompressible, keep it as is.
+        FREE(stored_data);
     }
 }
 
-// 0x52F410
-bool tig_file_extract_native(const char* filename, char* path)
+// Appends contents of file entries of the sorted index to the data file.
+// Entries which has not changed since `reuse_index` keep their contents where
+// they are.
+bool tig_file_archive_pack_entries(TigFileArchiveIndex* index, TigFileArchiveIndex* reuse_index, const char* src, TigFile* data_stream)
 {
-    TigDatabaseEntry* database_entry;
-    TigFile* in;
-    TigFile* out;
-    TigFileRepository* first_directory_repo;
-    TigFileRepository* repo;
-    TigFindFileData ffd;
-    char tmp[TIG_MAX_PATH];
-    unsigned int ignored;
+    TigFileArchiveBatch batch;
+    TigFileArchiveEntry* entry;
+    char path[TIG_MAX_PATH];
+    TigFile* stream;
+    int start;
+    int end;
+    int batch_index;
+    size_t batch_size;
+    int offset;
+    bool success = true;
+
+    if (tig_file_fseek(data_stream, 0, SEEK_END) != 0) {
+        return false;
+    }
 
-    first_directory_repo = NULL;
-    if (filename[0] == '.' || filename[0] == '\\' || filename[1] == ':' || filename[0] == '/') {
-        strcpy(path, filename);
-        return true;
+    offset = tig_file_ftell(data_stream);
+    if (offset < 0) {
+        return false;
     }
 
-    compat_join_path(path, TIG_MAX_PATH, CACHE_DIR_NAME, filename);
+    batch.entries = (TigFileArchiveEntry**)MALLOC(sizeof(*batch.entries) * (index->count + 1));
+    batch.reuse_index = reuse_index;
+
+    start = 0;
+    while (success && start < index->count) {
+        // Read the next batch of files on this thread, the file layer is not
+        // thread-safe.
+        batch.count = 0;
+        batch_size = 0;
+        end = start;
+        while (success && end < index->count && batch_size < TIG_FILE_ARCHIVE_BATCH_SIZE) {
+            entry = &(index->entries[end++]);
+            if ((entry->flags & TIG_FILE_ARCHIVE_ENTRY_DIRECTORY) != 0) {
+                continue;
+            }
 
-    ignored = tig_file_ignored(filename);
+            batch.entries[batch.count++] = entry;
 
-    repo = tig_file_repositories_head;
-    while (repo != NULL) {
-        if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
-            if (first_directory_repo == NULL) {
-                first_directory_repo = repo;
+            tig_file_archive_entry_path(path, sizeof(path), src, entry->path);
+            stream = tig_file_fopen(path, "rb");
+            if (stream == NULL) {
+                success = false;
+                break;
             }
 
-            if ((ignored & TIG_FILE_IGNORE_DIRECTORY) == 0) {
-                // Check if file exists in a directory bundle.
-                compat_join_path(tmp, sizeof(tmp), repo->path, filename);
-                compat_resolve_path(tmp);
-                if (tig_find_first_file(tmp, &ffd)) {
-                    strcpy(path, tmp);
-                    tig_find_close(&ffd);
-                    return true;
+            entry->size = (unsigned int)tig_file_filelength(stream);
+            if (entry->size != 0) {
+                entry->data = (unsigned char*)MALLOC(entry->size);
+                if (tig_file_fread(entry->data, entry->size, 1, stream) != 1) {
+                    success = false;
                 }
-                tig_find_close(&ffd);
+            }
 
-                // Check if file is already expanded.
-                compat_join_path(tmp, sizeof(tmp), repo->path, path);
-                compat_resolve_path(tmp);
-                if (tig_find_first_file(tmp, &ffd)) {
-                    strcpy(path, tmp);
-                    tig_find_close(&ffd);
-                    return true;
+            tig_file_fclose(stream);
+
+            batch_size += entry->size;
+        }
+
+        if (success) {
+            tig_file_archive_run(&batch, tig_file_archive_pack);
+        }
+
+        for (batch_index = 0; batch_index < batch.count; batch_index++) {
+            entry = batch.entries[batch_index];
+            if (success && !entry->unchanged) {
+                entry->offset = (unsigned int)offset;
+                if (entry->stored_size != 0
+                    && tig_file_fwrite(entry->stored_data, entry->stored_size, 1, data_stream) != 1) {
+                    success = false;
                 }
-                tig_find_close(&ffd);
+                offset += entry->stored_size;
             }
-        } else if ((repo->type & TIG_FILE_REPOSITORY_DATABASE) != 0) {
-            if ((ignored & TIG_FILE_IGNORE_DATABASE) == 0) {
-                if (tig_database_get_entry(repo->database, filename, &database_entry)) {
-                    compat_splitpath(path, NULL, tmp, NULL, NULL);
-                    tig_file_mkdir_ex_native(tmp);
 
-                    out = tig_file_fopen_native(path, "wb");
-                    if (out == NULL) {
-                        return false;
-                    }
+            tig_file_archive_entry_release(entry);
+        }
 
-                    in = tig_file_create();
-                    in->impl.database_file_stream = tig_database_fopen_entry(repo->database, database_entry, "rb");
-                    in->flags |= TIG_FILE_DATABASE;
+        start = end;
+    }
 
-                    if (!tig_file_copy_internal(out, in)) {
-                        tig_file_fclose(out);
-                        tig_file_fclose(in);
-                        return false;
-                    }
+    FREE(batch.entries);
 
-                    tig_file_fclose(out);
-                    tig_file_fclose(in);
+    return success;
+}
 
-                    if (first_directory_repo == NULL) {
-                        // If we're here it means out file was sucessfully
-                        // created in the first directory repo, we just need it
-                        // to look deeper.
-                        while (repo != NULL) {
-                            if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
-                                first_directory_repo = repo;
-                                break;
-                            }
-                            repo = repo->next;
-                        }
-                    }
+// Checks whether the file at the destination already has entry contents.
+void tig_file_archive_verify(TigFileArchiveBatch* batch, TigFileArchiveEntry* entry)
+{
+    (void)batch;
 
-                    compat_join_path(tmp, sizeof(tmp), first_directory_repo->path, path);
-                    strcpy(path, tmp);
+    entry->unchanged = (unsigned int)crc32(crc32(0, NULL, 0), entry->data, entry->size) == entry->crc
+        && (unsigned int)adler32(adler32(0, NULL, 0), entry->data, entry->size) == entry->adler;
+}
 
-                    return true;
-                }
-            }
+void tig_file_archive_unpack(TigFileArchiveBatch* batch, TigFileArchiveEntry* entry)
+{
+    uLongf size;
+
+    (void)batch;
+
+    if ((entry->flags & TIG_FILE_ARCHIVE_ENTRY_COMPRESSED) != 0) {
+        size = entry->size;
+        entry->data = (unsigned char*)MALLOC(entry->size);
+        if (uncompress(entry->data, &size, entry->stored_data, entry->stored_size) != Z_OK
+            || size != entry->size) {
+            entry->failed = true;
+            return;
         }
-        repo = repo->next;
+    } else {
+        entry->data = entry->stored_data;
     }
 
-    return false;
+    if ((unsigned int)crc32(crc32(0, NULL, 0), entry->data, entry->size) != entry->crc
+        || (unsigned int)adler32(adler32(0, NULL, 0), entry->data, entry->size) != entry->adler) {
+        entry->failed = true;
+    }
 }
 
-// 0x52F760
-void tig_file_list_create_native(TigFileList* list, const char* pattern)
+// Removes files and directories of `path` which are not in the index (or have
+// different type).
+bool tig_file_archive_prune(TigFileArchiveIndex* index, const char* path, const char* rel_path)
 {
-    char mutable_pattern[TIG_MAX_PATH];
-    size_t pattern_length;
+    char pattern[TIG_MAX_PATH];
+    char child_rel_path[TIG_MAX_PATH];
+    TigFileList list;
+    unsigned int entry_index;
+    const char* name;
+    TigFileArchiveEntry* entry;
+    bool is_directory;
+    bool success = true;
+
+    compat_join_path(pattern, sizeof(pattern), path, "*.*");
+    tig_file_list_create_native(&list, pattern);
+
+    for (entry_index = 0; entry_index < list.count; entry_index++) {
+        name = list.entries[entry_index].path;
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) {
+            continue;
+        }
+
+        if (rel_path[0] != '\0') {
+            SDL_snprintf(child_rel_path, sizeof(child_rel_path), "%s\\%s", rel_path, name);
+        } else {
+            SDL_strlcpy(child_rel_path, name, sizeof(child_rel_path));
+        }
+
+        is_directory = (list.entries[entry_index].attributes & TIG_FILE_ATTRIBUTE_SUBDIR) != 0;
+        entry = tig_file_archive_index_find(index, child_rel_path);
+        compat_join_path(pattern, sizeof(pattern), path, name);
+
+        if (entry != NULL && ((entry->flags & TIG_FILE_ARCHIVE_ENTRY_DIRECTORY) != 0) == is_directory) {
+            if (is_directory && !tig_file_archive_prune(index, pattern, child_rel_path)) {
+                success = false;
+            }
+        } else if (is_directory) {
+            if (!tig_file_empty_directory_native(pattern)
+                || tig_file_rmdir_ex_native(pattern) != 0) {
+                success = false;
+            }
+        } else {
+            if (tig_file_remove_native(pattern) != 0) {
+                success = false;
+            }
+        }
+    }
+
+    tig_file_list_destroy(&list);
+    return success;
+}
+
+// Extracts version 2 archive. When `sync` is set, files at the destination
+// which already match the archive are left intact.
+bool tig_file_unarchive_entries(TigFileArchiveIndex* index, TigFile* data_stream, const char* dst, bool sync)
+{
+    TigFileArchiveBatch batch;
+    TigFileArchiveBatch verify_batch;
+    TigFileArchiveEntry* entry;
     TigFileInfo info;
-    TigFindFileData directory_ffd;
-    TigFileRepository* repo;
-    unsigned int ignored;
-    TigDatabaseFindFileData database_ffd;
     char path[TIG_MAX_PATH];
-    char fname[COMPAT_MAX_FNAME];
-    char ext[COMPAT_MAX_EXT];
+    TigFile* stream;
+    int start;
+    int end;
+    int batch_index;
+    int count;
+    size_t batch_size;
+    bool success = true;
+
+    // Parents are sorted before their subdirectories.
+    for (start = 0; start < index->count; start++) {
+        entry = &(index->entries[start]);
+        if ((entry->flags & TIG_FILE_ARCHIVE_ENTRY_DIRECTORY) != 0) {
+            tig_file_archive_entry_path(path, sizeof(path), dst, entry->path);
+            if (!tig_file_is_directory_native(path)) {
+                tig_file_mkdir_native(path);
+            }
+        }
+    }
 
-    strcpy(mutable_pattern, pattern);
+    batch.entries = (TigFileArchiveEntry**)MALLOC(sizeof(*batch.entries) * (index->count + 1));
+    batch.reuse_index = NULL;
+    verify_batch.entries = (TigFileArchiveEntry**)MALLOC(sizeof(*verify_batch.entries) * (index->count + 1));
+    verify_batch.reuse_index = NULL;
+
+    start = 0;
+    while (success && start < index->count) {
+        batch.count = 0;
+        batch_size = 0;
+        end = start;
+        while (success && end < index->count && batch_size < TIG_FILE_ARCHIVE_BATCH_SIZE) {
+            entry = &(index->entries[end++]);
+            if ((entry->flags & TIG_FILE_ARCHIVE_ENTRY_DIRECTORY) != 0) {
+                continue;
+            }
 
-    pattern_length = strlen(mutable_pattern);
-    if (pattern_length > 2 && strcmp(&(mutable_pattern[pattern_length - 3]), "*.*") == 0) {
-        mutable_pattern[pattern_length - 2] = '\0';
-    }
+            entry->unchanged = false;
+            entry->failed = false;
+
+            // Pick up the file at the destination if it looks the same.
+            if (sync && entry->size != 0) {
+                tig_file_archive_entry_path(path, sizeof(path), dst, entry->path);
+                if (tig_file_exists_native(path, &info)
+                    && (info.attributes & TIG_FILE_ATTRIBUTE_SUBDIR) == 0
+                    && info.size == entry->size) {
+                    stream = tig_file_fopen_native(path, "rb");
+                    if (stream != NULL) {
+                        entry->data = (unsigned char*)MALLOC(entry->size);
+                        if (tig_file_fread(entry->data, entry->size, 1, stream) != 1) {
+                            FREE(entry->data);
+                            entry->data = NULL;
+                        }
+                        tig_file_fclose(stream);
+                    }
+                }
+            }
 
-    list->count = 0;
-    list->entries = NULL;
+            batch.entries[batch.count++] = entry;
+            batch_size += entry->size;
+        }
 
-    if (mutable_pattern[0] == '.' || mutable_pattern[0] == '\\' || mutable_pattern[1] == ':' || mutable_pattern[0] == '/') {
-        if (tig_find_first_file(mutable_pattern, &directory_ffd)) {
-            do {
-                tig_file_process_attribs(directory_ffd.path_info.type, &(info.attributes));
-                info.size = (size_t)directory_ffd.path_info.size;
-                strcpy(info.path, directory_ffd.name);
-                info.modify_time = SDL_NS_TO_SECONDS(directory_ffd.path_info.modify_time);
+        // Check which of the existing files are up to date.
+        if (sync) {
+            verify_batch.count = 0;
+            for (batch_index = 0; batch_index < batch.count; batch_index++) {
+                if (batch.entries[batch_index]->data != NULL) {
+                    verify_batch.entries[verify_batch.count++] = batch.entries[batch_index];
+                }
+            }
 
-                tig_file_list_add(list, &info);
-            } while (tig_find_next_file(&directory_ffd));
+            tig_file_archive_run(&verify_batch, tig_file_archive_verify);
         }
-        tig_find_close(&directory_ffd);
-    } else {
-        ignored = tig_file_ignored(pattern);
 
-        repo = tig_file_repositories_head;
-        while (repo != NULL) {
-            if ((repo->type & TIG_FILE_REPOSITORY_DATABASE) != 0) {
-                if ((ignored & TIG_FILE_IGNORE_DATABASE) == 0) {
-                    if (tig_database_find_first_entry(repo->database, mutable_pattern, &database_ffd)) {
-                        do {
-                            info.attributes = TIG_FILE_ATTRIBUTE_0x80 | TIG_FILE_ATTRIBUTE_READONLY;
-                            if ((database_ffd.is_directory & 0x1) != 0) {
-                                info.attributes |= TIG_FILE_ATTRIBUTE_SUBDIR;
-                            }
-                            info.size = database_ffd.size;
+        // Read and inflate contents of the rest.
+        count = 0;
+        for (batch_index = 0; batch_index < batch.count; batch_index++) {
+            entry = batch.entries[batch_index];
+            tig_file_archive_entry_release(entry);
 
-                            compat_splitpath(database_ffd.name, NULL, NULL, fname, ext);
-                            compat_makepath(info.path, NULL, NULL, fname, ext);
+            if (entry->unchanged) {
+                continue;
+            }
 
-                            tig_file_list_add(list, &info);
-                        } while (tig_database_find_next_entry(&database_ffd));
-                    }
-                    tig_database_find_close(&database_ffd);
+            if (entry->stored_size != 0) {
+                entry->stored_data = (unsigned char*)MALLOC(entry->stored_size);
+                if (tig_file_fseek(data_stream, (int)entry->offset, SEEK_SET) != 0
+                    || tig_file_fread(entry->stored_data, entry->stored_size, 1, data_stream) != 1) {
+                    success = false;
                 }
-            } else if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
-                if ((ignored & TIG_FILE_IGNORE_DIRECTORY) == 0) {
-                    compat_join_path(path, sizeof(path), repo->path, mutable_pattern);
+            }
 
-                    if (tig_find_first_file(path, &directory_ffd)) {
-                        do {
-                            tig_file_process_attribs(directory_ffd.path_info.type, &(info.attributes));
-                            info.size = (size_t)directory_ffd.path_info.size;
-                            strcpy(info.path, directory_ffd.name);
-                            info.modify_time = SDL_NS_TO_SECONDS(directory_ffd.path_info.modify_time);
+            batch.entries[count++] = entry;
+        }
+        batch.count = count;
 
-                            tig_file_list_add(list, &info);
-                        } while (tig_find_next_file(&directory_ffd));
+        if (success) {
+            tig_file_archive_run(&batch, tig_file_archive_unpack);
+        }
+
+        for (batch_index = 0; batch_index < batch.count; batch_index++) {
+            entry = batch.entries[batch_index];
+            if (success) {
+                if (entry->failed) {
+                    tig_debug_printf("TIG: tig_file_unarchive: corrupted entry %s\n", entry->path);
+                    success = false;
+                } else {
+                    tig_file_archive_entry_path(path, sizeof(path), dst, entry->path);
+                    stream = tig_file_fopen_native(path, "wb");
+                    if (stream == NULL) {
+                        success = false;
+                    } else {
+                        if (entry->size != 0
+                            && tig_file_fwrite(entry->data, entry->size, 1, stream) != 1) {
+                            success = false;
+                        }
+                        tig_file_fclose(stream);
                     }
-                    tig_find_close(&directory_ffd);
                 }
             }
-            repo = repo->next;
+
+            tig_file_archive_entry_release(entry);
         }
+
+        start = end;
     }
+
+    FREE(verify_batch.entries);
+    FREE(batch.entries);
+
+    return success;
 }
 
-// 0x52FB20
-void tig_file_list_destroy(TigFileList* file_list)
+// 0x52ECA0
+int tig_file_init(TigInitInfo* init_info)
 {
-    if (file_list->entries != NULL) {
-        FREE(file_list->entries);
+    (void)init_info;
+
+    tig_file_prefetch_init();
+
+    // FIX: Make `tig.dat` mandatory.
+    //
+    // When `tig.dat` is not present in the current working directory, the
+    // original code attempts to add a repository at the path provided by
+    // `GetModuleFileNameA`, which is the full path to `Arcanum.exe`. Obviously,
+    // this is not a valid asset bundle.
+    if (!tig_file_repository_add("tig.dat")) {
+        tig_file_prefetch_exit();
+        return TIG_ERR_GENERIC;
     }
 
-    file_list->count = 0;
-    file_list->entries = NULL;
+    // Current working directory.
+    tig_file_repository_add(".");
+
+    return TIG_OK;
 }
 
-// 0x52FB40
-int tig_file_filelength(TigFile* stream)
+// 0x52ED00
+void tig_file_exit(void)
 {
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_filelength(stream->impl.database_file_stream);
+    TigFileIgnore* next;
+
+    while (tig_file_ignore_head != NULL) {
+        next = tig_file_ignore_head->next;
+        if (tig_file_ignore_head->path != NULL) {
+            FREE(tig_file_ignore_head->path);
+        }
+        FREE(tig_file_ignore_head);
+        tig_file_ignore_head = next;
     }
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        long pos;
-        long size;
+    tig_file_prefetch_exit();
+    tig_file_repository_remove_all();
+}
 
-        pos = ftell(stream->impl.plain_file_stream);
-        if (pos == -1) {
-            return -1;
-        }
+// 0x52ED40
+bool tig_file_repository_add_native(const char* path)
+{
+    TigFileRepository* curr;
+    TigFileRepository* prev;
+    TigFileRepository* next;
+    TigFileRepository* repo;
+    SDL_PathInfo path_info;
+    TigDatabase* database;
+    char cache_path[TIG_MAX_PATH];
 
-        if (fseek(stream->impl.plain_file_stream, 0, SEEK_END) != 0) {
-            return -1;
-        }
+    prev = NULL;
+    curr = tig_file_repositories_head;
+    while (curr != NULL && SDL_strcasecmp(curr->path, path) != 0) {
+        prev = curr;
+        curr = curr->next;
+    }
 
-        size = ftell(stream->impl.plain_file_stream);
-        if (size == -1) {
-            return -1;
-        }
+    if (curr != NULL) {
+        if (prev != NULL) {
+            if ((curr->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0
+                && curr->next != NULL
+                && SDL_strcasecmp(curr->next->path, path) == 0) {
+                // Move repo on top of the list.
+                next = curr->next;
+                curr->next = next->next;
+                next->next = tig_file_repositories_head;
+                tig_file_repositories_head = next;
+            }
 
-        if (fseek(stream->impl.plain_file_stream, pos, SEEK_SET) != 0) {
-            return -1;
+            prev->next = curr->next;
+            curr->next = tig_file_repositories_head;
+            tig_file_repositories_head = curr;
+
+            // Priorities have changed.
+            tig_file_index_rebuild();
         }
+        return true;
+    }
 
-        return (int)size;
+    // NOTE: Original code is slightly different. For unknown reason (likely a
+    // bug) it treats `path` as a pattern and loops over it using
+    // `tig_find_first_file` and `tig_find_next_file`. However, it does not use
+    // the resolved file name, only the provided `path`. This means that the
+    // same repository can be added multiple times if the pattern given to this
+    // function has several matches.
+    if (SDL_GetPathInfo(path, &path_info)) {
+        if (path_info.type == SDL_PATHTYPE_DIRECTORY) {
+            repo = (TigFileRepository*)MALLOC(sizeof(TigFileRepository));
+            repo->type = 0;
+            repo->path = NULL;
+            repo->database = NULL;
+            repo->next = NULL;
+
+            repo->path = STRDUP(path);
+            repo->type = TIG_FILE_REPOSITORY_DIRECTORY;
+            repo->next = tig_file_repositories_head;
+            tig_file_repositories_head = repo;
+
+            tig_debug_printf("TIG File: Added path \"%s\"\n", path);
+
+            compat_join_path(cache_path, sizeof(cache_path), tig_file_repositories_head->path, CACHE_DIR_NAME);
+            tig_file_rmdir_recursively_native(cache_path);
+
+            tig_file_index_rebuild();
+
+            return true;
+        } else {
+            database = tig_database_open(path);
+            if (database != NULL) {
+                repo = (TigFileRepository*)MALLOC(sizeof(TigFileRepository));
+                repo->type = 0;
+                repo->path = NULL;
+                repo->database = NULL;
+                repo->next = NULL;
+
+                repo->path = STRDUP(path);
+                repo->type = TIG_FILE_REPOSITORY_DATABASE;
+                repo->database = database;
+
+                repo->next = tig_file_repositories_head;
+                tig_file_repositories_head = repo;
+
+                tig_debug_printf("TIG File: Added database \"%s\"\n", path);
+
+                tig_file_index_rebuild();
+
+                return true;
+            }
+        }
     }
 
-    return -1;
+    tig_debug_printf("TIG File: Error - Invalid path \"%s\"\n", path);
+    return false;
 }
 
-// 0x52FB80
-bool tig_file_exists_native(const char* file_name, TigFileInfo* info)
+// 0x52EF30
+bool tig_file_repository_remove_native(const char* file_name)
 {
-    TigFindFileData ffd;
     TigFileRepository* repo;
-    TigDatabaseEntry* database_entry;
+    TigFileRepository* prev;
+    TigFileRepository* next;
+    bool removed = false;
+    char path[TIG_MAX_PATH];
+
+    // Workers must not read databases being closed.
+    tig_file_prefetch_flush();
+
+    prev = NULL;
+    repo = tig_file_repositories_head;
+    while (repo != NULL) {
+        if (SDL_strcasecmp(file_name, repo->path) == 0) {
+            next = repo->next;
+            if ((repo->type & TIG_FILE_DATABASE) != 0) {
+                tig_database_close(repo->database);
+            } else {
+                compat_join_path(path, sizeof(path), repo->path, CACHE_DIR_NAME);
+                tig_file_rmdir_recursively_native(path);
+            }
+
+            if (prev != NULL) {
+                prev->next = next;
+            } else {
+                tig_file_repositories_head = next;
+            }
+
+            FREE(repo->path);
+            FREE(repo);
+
+            repo = next;
+            removed = true;
+        } else {
+            prev = repo;
+            repo = repo->next;
+        }
+    }
+
+    if (removed) {
+        tig_file_index_rebuild();
+    }
+
+    return removed;
+}
+
+// 0x52F000
+bool tig_file_repository_remove_all(void)
+{
+    TigFileRepository* curr;
+    TigFileRepository* next;
+    char path[TIG_MAX_PATH];
+
+    tig_file_prefetch_flush();
+
+    curr = tig_file_repositories_head;
+    while (curr != NULL) {
+        next = curr->next;
+        if ((curr->type & 1) != 0) {
+            tig_database_close(curr->database);
+        } else {
+            compat_join_path(path, sizeof(path), curr->path, CACHE_DIR_NAME);
+            tig_file_rmdir_recursively_native(path);
+        }
+
+        FREE(curr->path);
+        FREE(curr);
+
+        curr = next;
+    }
+
+    tig_file_repositories_head = NULL;
+
+    tig_file_index_free();
+    tig_file_miss_clear();
+
+    return true;
+}
+
+// 0x52F0A0
+bool tig_file_repository_guid(const char* path, TigGuid* guid)
+{
+    TigFileRepository* curr = tig_file_repositories_head;
+    while (curr != NULL) {
+        if ((curr->type & TIG_FILE_DATABASE) != 0) {
+            if (SDL_strcasecmp(curr->database->path, path) == 0) {
+                *guid = curr->database->guid;
+                return true;
+            }
+        }
+        curr = curr->next;
+    }
+
+    return false;
+}
+
+// 0x52F100
+int tig_file_mkdir_ex_native(const char* path)
+{
+    char temp_path[TIG_MAX_PATH];
+    size_t temp_path_length;
+    TigFileRepository* repo;
+
+    temp_path[0] = '\0';
+
+    if (path[0] != '.' && path[0] != '\\' && path[1] != ':' && path[0] != '/') {
+        repo = tig_file_repositories_head;
+        while (repo != NULL) {
+            if ((repo->type & TIG_FILE_PLAIN) != 0) {
+                strcpy(temp_path, repo->path);
+                break;
+            }
+            repo = repo->next;
+        }
+    }
+
+    compat_append_path(temp_path, sizeof(temp_path), path);
+
+    temp_path_length = strlen(temp_path);
+    if (temp_path[temp_path_length] == PATH_SEPARATOR) {
+        temp_path[temp_path_length] = '\0';
+    }
+
+    tig_file_miss_clear();
+
+    if (!SDL_CreateDirectory(temp_path)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+// 0x52F230
+int tig_file_rmdir_ex_native(const char* path)
+{
+    char temp_path[TIG_MAX_PATH];
+    TigFileRepository* repo;
+
+    temp_path[0] = '\0';
+
+    if (path[0] != '.' && path[0] != '\\' && path[1] != ':' && path[0] != '/') {
+        repo = tig_file_repositories_head;
+        while (repo != NULL) {
+            if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
+                strcpy(temp_path, repo->path);
+                break;
+            }
+            repo = repo->next;
+        }
+    }
+
+    compat_append_path(temp_path, sizeof(temp_path), path);
+
+    tig_file_miss_clear();
+
+    if (!SDL_RemovePath(temp_path)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+// 0x52F370
+void tig_file_ignore(const char* path, unsigned int flags)
+{
+    TigFileIgnore* ignore;
+    size_t path_length;
+    char* pch;
+
+    if ((flags & (TIG_FILE_DATABASE | TIG_FILE_PLAIN)) != 0) {
+        if (fpattern_isvalid(path)) {
+            ignore = (TigFileIgnore*)MALLOC(sizeof(*ignore));
+            ignore->flags = flags;
+            ignore->path = strdup(path);
+            ignore->next = tig_file_ignore_head;
+            tig_file_ignore_head = ignore;
+
+            // Trim *.* pattern from the end of string.
+            path_length = strlen(ignore->path);
+            if (path_length > 3) {
+                pch = &(ignore->path[path_length - 3]);
+                if (strcmp(pch, "*.*") == 0) {
+                    *pch = '\0';
+                }
+            }
+        }
+    }
+}
+
+// 0x52F410
+bool tig_file_extract_native(const char* filename, char* path)
+{
+    TigDatabaseEntry* database_entry;
+    TigFile* in;
+    TigFile* out;
+    TigFileRepository* first_directory_repo;
+    TigFileRepository* repo;
+    TigFindFileData ffd;
+    char tmp[TIG_MAX_PATH];
     unsigned int ignored;
+
+    first_directory_repo = NULL;
+    if (filename[0] == '.' || filename[0] == '\\' || filename[1] == ':' || filename[0] == '/') {
+        strcpy(path, filename);
+        return true;
+    }
+
+    compat_join_path(path, TIG_MAX_PATH, CACHE_DIR_NAME, filename);
+
+    ignored = tig_file_ignored(filename);
+
+    repo = tig_file_repositories_head;
+    while (repo != NULL) {
+        if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
+            if (first_directory_repo == NULL) {
+                first_directory_repo = repo;
+            }
+
+            if ((ignored & TIG_FILE_IGNORE_DIRECTORY) == 0) {
+                // Check if file exists in a directory bundle.
+                compat_join_path(tmp, sizeof(tmp), repo->path, filename);
+                compat_resolve_path(tmp);
+                if (tig_find_first_file(tmp, &ffd)) {
+                    strcpy(path, tmp);
+                    tig_find_close(&ffd);
+                    return true;
+                }
+                tig_find_close(&ffd);
+
+                // Check if file is already expanded.
+                compat_join_path(tmp, sizeof(tmp), repo->path, path);
+                compat_resolve_path(tmp);
+                if (tig_find_first_file(tmp, &ffd)) {
+                    strcpy(path, tmp);
+                    tig_find_close(&ffd);
+                    return true;
+                }
+                tig_find_close(&ffd);
+            }
+        } else if ((repo->type & TIG_FILE_REPOSITORY_DATABASE) != 0) {
+            if ((ignored & TIG_FILE_IGNORE_DATABASE) == 0) {
+                if (tig_database_get_entry(repo->database, filename, &database_entry)) {
+                    compat_splitpath(path, NULL, tmp, NULL, NULL);
+                    tig_file_mkdir_ex_native(tmp);
+
+                    out = tig_file_fopen_native(path, "wb");
+                    if (out == NULL) {
+                        return false;
+                    }
+
+                    in = tig_file_create();
+                    in->impl.database_file_stream = tig_database_fopen_entry(repo->database, database_entry, "rb");
+                    in->flags |= TIG_FILE_DATABASE;
+
+                    if (!tig_file_copy_internal(out, in)) {
+                        tig_file_fclose(out);
+                        tig_file_fclose(in);
+                        return false;
+                    }
+
+                    tig_file_fclose(out);
+                    tig_file_fclose(in);
+
+                    if (first_directory_repo == NULL) {
+                        // If we're here it means out file was sucessfully
+                        // created in the first directory repo, we just need it
+                        // to look deeper.
+                        while (repo != NULL) {
+                            if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
+                                first_directory_repo = repo;
+                                break;
+                            }
+                            repo = repo->next;
+                        }
+                    }
+
+                    compat_join_path(tmp, sizeof(tmp), first_directory_repo->path, path);
+                    strcpy(path, tmp);
+
+                    return true;
+                }
+            }
+        }
+        repo = repo->next;
+    }
+
+    return false;
+}
+
+// 0x52F760
+void tig_file_list_create_native(TigFileList* list, const char* pattern)
+{
+    char mutable_pattern[TIG_MAX_PATH];
+    size_t pattern_length;
+    TigFileInfo info;
+    TigFindFileData directory_ffd;
+    TigFileRepository* repo;
+    unsigned int ignored;
+    TigDatabaseFindFileData database_ffd;
+    char path[TIG_MAX_PATH];
+    char fname[COMPAT_MAX_FNAME];
+    char ext[COMPAT_MAX_EXT];
+
+    strcpy(mutable_pattern, pattern);
+
+    pattern_length = strlen(mutable_pattern);
+    if (pattern_length > 2 && strcmp(&(mutable_pattern[pattern_length - 3]), "*.*") == 0) {
+        mutable_pattern[pattern_length - 2] = '\0';
+    }
+
+    list->count = 0;
+    list->entries = NULL;
+
+    if (mutable_pattern[0] == '.' || mutable_pattern[0] == '\\' || mutable_pattern[1] == ':' || mutable_pattern[0] == '/') {
+        if (tig_find_first_file(mutable_pattern, &directory_ffd)) {
+            do {
+                tig_file_process_attribs(directory_ffd.path_info.type, &(info.attributes));
+                info.size = (size_t)directory_ffd.path_info.size;
+                strcpy(info.path, directory_ffd.name);
+                info.modify_time = SDL_NS_TO_SECONDS(directory_ffd.path_info.modify_time);
+
+                tig_file_list_add(list, &info);
+            } while (tig_find_next_file(&directory_ffd));
+        }
+        tig_find_close(&directory_ffd);
+    } else {
+        ignored = tig_file_ignored(pattern);
+
+        repo = tig_file_repositories_head;
+        while (repo != NULL) {
+            if ((repo->type & TIG_FILE_REPOSITORY_DATABASE) != 0) {
+                if ((ignored & TIG_FILE_IGNORE_DATABASE) == 0) {
+                    if (tig_database_find_first_entry(repo->database, mutable_pattern, &database_ffd)) {
+                        do {
+                            info.attributes = TIG_FILE_ATTRIBUTE_0x80 | TIG_FILE_ATTRIBUTE_READONLY;
+                            if ((database_ffd.is_directory & 0x1) != 0) {
+                                info.attributes |= TIG_FILE_ATTRIBUTE_SUBDIR;
+                            }
+                            info.size = database_ffd.size;
+
+                            compat_splitpath(database_ffd.name, NULL, NULL, fname, ext);
+                            compat_makepath(info.path, NULL, NULL, fname, ext);
+
+                            tig_file_list_add(list, &info);
+                        } while (tig_database_find_next_entry(&database_ffd));
+                    }
+                    tig_database_find_close(&database_ffd);
+                }
+            } else if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
+                if ((ignored & TIG_FILE_IGNORE_DIRECTORY) == 0) {
+                    compat_join_path(path, sizeof(path), repo->path, mutable_pattern);
+
+                    if (tig_find_first_file(path, &directory_ffd)) {
+                        do {
+                            tig_file_process_attribs(directory_ffd.path_info.type, &(info.attributes));
+                            info.size = (size_t)directory_ffd.path_info.size;
+                            strcpy(info.path, directory_ffd.name);
+                            info.modify_time = SDL_NS_TO_SECONDS(directory_ffd.path_info.modify_time);
+
+                            tig_file_list_add(list, &info);
+                        } while (tig_find_next_file(&directory_ffd));
+                    }
+                    tig_find_close(&directory_ffd);
+                }
+            }
+            repo = repo->next;
+        }
+    }
+}
+
+// 0x52FB20
+void tig_file_list_destroy(TigFileList* file_list)
+{
+    if (file_list->entries != NULL) {
+        FREE(file_list->entries);
+    }
+
+    file_list->count = 0;
+    file_list->entries = NULL;
+}
+
+// 0x52FB40
+int tig_file_filelength(TigFile* stream)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_filelength(stream->impl.database_file_stream);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        long pos;
+        long size;
+
+        pos = ftell(stream->impl.plain_file_stream);
+        if (pos == -1) {
+            return -1;
+        }
+
+        if (fseek(stream->impl.plain_file_stream, 0, SEEK_END) != 0) {
+            return -1;
+        }
+
+        size = ftell(stream->impl.plain_file_stream);
+        if (size == -1) {
+            return -1;
+        }
+
+        if (fseek(stream->impl.plain_file_stream, pos, SEEK_SET) != 0) {
+            return -1;
+        }
+
+        return (int)size;
+    }
+
+    return -1;
+}
+
+// 0x52FB80
+bool tig_file_exists_native(const char* file_name, TigFileInfo* info)
+{
+    TigFindFileData ffd;
+    TigFileRepository* repo;
+    TigFileIndexNode* node;
+    TigDatabaseEntry* database_entry;
+    unsigned int ignored;
+    unsigned int hash;
+    bool shadowed;
+    bool found;
+    char path[TIG_MAX_PATH];
+    char fname[COMPAT_MAX_FNAME];
+    char ext[COMPAT_MAX_EXT];
+
+    ignored = tig_file_ignored(file_name);
+
+    if (file_name[0] == '.' || file_name[0] == '\\' || file_name[1] == ':' || file_name[0] == '/') {
+        if (!tig_find_first_file(file_name, &ffd)) {
+            tig_find_close(&ffd);
+            return false;
+        }
+
+        if (info != NULL) {
+            tig_file_process_attribs(ffd.path_info.type, &(info->attributes));
+            info->size = (size_t)ffd.path_info.size;
+            strcpy(info->path, ffd.name);
+            info->modify_time = SDL_NS_TO_SECONDS(ffd.path_info.modify_time);
+        }
+
+        tig_find_close(&ffd);
+        return true;
+    }
+
+    hash = tig_file_index_hash(file_name);
+
+    // Archive entry with the highest priority (if any).
+    node = NULL;
+    if ((ignored & TIG_FILE_IGNORE_DATABASE) == 0) {
+        node = tig_file_index_find(file_name, hash);
+    }
+
+    // Directory repositories take precedence over the archives which follow
+    // them, so they have to be checked on the file system unless the path is
+    // already known to be missing from all of them.
+    if ((ignored & TIG_FILE_IGNORE_DIRECTORY) == 0
+        && !tig_file_miss_contains(file_name, hash)) {
+        shadowed = false;
+        found = false;
+
+        repo = tig_file_repositories_head;
+        while (repo != NULL) {
+            if (node != NULL && repo == node->repo) {
+                shadowed = true;
+            } else if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
+                compat_join_path(path, sizeof(path), repo->path, file_name);
+
+                if (tig_find_first_file(path, &ffd)) {
+                    if (!shadowed) {
+                        if (info != NULL) {
+                            tig_file_process_attribs(ffd.path_info.type, &(info->attributes));
+                            info->size = (size_t)ffd.path_info.size;
+                            strcpy(info->path, ffd.name);
+                            info->modify_time = SDL_NS_TO_SECONDS(ffd.path_info.modify_time);
+                        }
+
+                        tig_find_close(&ffd);
+                        return true;
+                    }
+
+                    tig_find_close(&ffd);
+                    found = true;
+                    break;
+                }
+                tig_find_close(&ffd);
+            }
+            repo = repo->next;
+        }
+
+        // Continuing the walk past the winning archive ensures the path is
+        // absent from every directory repository, so it's safe to remember.
+        if (!found) {
+            tig_file_miss_add(file_name, hash);
+        }
+    }
+
+    if (node != NULL) {
+        if (info != NULL) {
+            database_entry = node->entry;
+
+            info->attributes = TIG_FILE_ATTRIBUTE_0x80 | TIG_FILE_ATTRIBUTE_READONLY;
+            if ((database_entry->flags & TIG_DATABASE_ENTRY_DIRECTORY) != 0) {
+                info->attributes |= TIG_FILE_ATTRIBUTE_SUBDIR;
+            }
+            info->size = database_entry->size;
+
+            compat_splitpath(database_entry->path, NULL, NULL, fname, ext);
+            compat_makepath(info->path, 0, 0, fname, ext);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+// 0x52FE60
+bool tig_file_exists_in_path_native(const char* search_path, const char* file_name, TigFileInfo* info)
+{
+    TigFindFileData ffd;
+    TigFileRepository* repo;
+    TigDatabaseEntry* database_entry;
+    unsigned int ignored;
+    char path[TIG_MAX_PATH];
+    char fname[COMPAT_MAX_FNAME];
+    char ext[COMPAT_MAX_EXT];
+
+    if (file_name[0] == '.' || file_name[0] == '\\' || file_name[1] == ':' || file_name[0] == '/') {
+        return tig_file_exists_native(file_name, info);
+    }
+
+    ignored = tig_file_ignored(file_name);
+
+    repo = tig_file_repositories_head;
+    while (repo != NULL) {
+        if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
+            if ((ignored & TIG_FILE_IGNORE_DATABASE) != 0
+                && SDL_strcasecmp(search_path, repo->path) == 0) {
+                compat_join_path(path, sizeof(path), repo->path, file_name);
+
+                if (tig_find_first_file(path, &ffd)) {
+                    if (info != NULL) {
+                        tig_file_process_attribs(ffd.path_info.type, &(info->attributes));
+                        info->size = (size_t)ffd.path_info.size;
+                        strcpy(info->path, ffd.name);
+                        info->modify_time = SDL_NS_TO_SECONDS(ffd.path_info.modify_time);
+                    }
+
+                    tig_find_close(&ffd);
+                    return true;
+                }
+                tig_find_close(&ffd);
+            }
+        } else if ((repo->type & TIG_FILE_REPOSITORY_DATABASE) != 0) {
+            if ((ignored & TIG_FILE_IGNORE_DATABASE) == 0
+                && SDL_strcasecmp(search_path, repo->path) == 0) {
+                if (tig_database_get_entry(repo->database, file_name, &database_entry)) {
+                    if (info != NULL) {
+                        info->attributes = TIG_FILE_ATTRIBUTE_0x80 | TIG_FILE_ATTRIBUTE_READONLY;
+                        if ((database_entry->flags & TIG_DATABASE_ENTRY_DIRECTORY) != 0) {
+                            info->attributes |= TIG_FILE_ATTRIBUTE_SUBDIR;
+                        }
+                        info->size = database_entry->size;
+
+                        compat_splitpath(database_entry->path, NULL, NULL, fname, ext);
+                        compat_makepath(info->path, 0, 0, fname, ext);
+                    }
+
+                    return true;
+                }
+            }
+        }
+        repo = repo->next;
+    }
+
+    return false;
+}
+
+// 0x5300F0
+int tig_file_remove_native(const char* file_name)
+{
+    TigFileRepository* repo;
+    char path[TIG_MAX_PATH];
+    TigDatabaseEntry* database_entry;
+
+    tig_file_miss_clear();
+
+    if (file_name[0] == '.' || file_name[0] == '\\' || file_name[1] == ':' || file_name[0] == '/') {
+        return SDL_RemovePath(file_name) ? 0 : 1;
+    }
+
+    if ((tig_file_ignored(file_name) & 0x2) != 0) {
+        return 1;
+    }
+
+    repo = tig_file_repositories_head;
+    while (repo != NULL) {
+        if ((repo->type & TIG_FILE_PLAIN) != 0) {
+            compat_join_path(path, sizeof(path), repo->path, file_name);
+
+            if (SDL_RemovePath(path)) {
+                repo = repo->next;
+                while (repo != NULL) {
+                    if ((repo->type & TIG_FILE_DATABASE) != 0
+                        && tig_database_get_entry(repo->database, file_name, &database_entry)) {
+                        database_entry->flags &= ~0x200;
+                        database_entry->flags |= 0x100;
+                        break;
+                    }
+                    repo = repo->next;
+                }
+
+                return 0;
+            }
+        }
+        repo = repo->next;
+    }
+
+    return 1;
+}
+
+// 0x5301F0
+int tig_file_rename_native(const char* old_file_name, const char* new_file_name)
+{
+    TigFileRepository* repo;
+    char old_path[TIG_MAX_PATH];
+    char new_path[TIG_MAX_PATH];
+
+    tig_file_miss_clear();
+
+    if (old_file_name[0] == '.' || old_file_name[0] == '\\' || old_file_name[1] == ':' || old_file_name[0] == '/') {
+        return SDL_RenamePath(old_file_name, new_file_name) ? 0 : 1;
+    }
+
+    if ((tig_file_ignored(old_file_name) & 0x2) != 0) {
+        return 1;
+    }
+
+    repo = tig_file_repositories_head;
+    while (repo != NULL) {
+        if ((repo->type & TIG_FILE_PLAIN) != 0) {
+            compat_join_path(old_path, sizeof(old_path), repo->path, old_file_name);
+            compat_join_path(new_path, sizeof(new_path), repo->path, new_file_name);
+
+            if (SDL_RenamePath(old_path, new_path)) {
+                return 0;
+            }
+        }
+        repo = repo->next;
+    }
+
+    return 1;
+}
+
+// 0x530330
+int tig_file_fclose(TigFile* stream)
+{
+    bool success;
+
+    success = tig_file_close_internal(stream);
+    tig_file_destroy(stream);
+
+    if (!success) {
+        return EOF;
+    }
+
+    return 0;
+}
+
+// 0x530360
+int tig_file_fflush(TigFile* stream)
+{
+    if (stream == NULL) {
+        return fflush(stdin);
+    }
+
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_fflush(stream->impl.database_file_stream);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return fflush(stream->impl.plain_file_stream);
+    }
+
+    return -1;
+}
+
+// 0x5303A0
+TigFile* tig_file_fopen_native(const char* path, const char* mode)
+{
+    TigFile* stream;
+
+    stream = tig_file_create();
+    if (tig_file_open_internal_native(path, mode, stream) == 0) {
+        tig_file_destroy(stream);
+        return NULL;
+    }
+
+    return stream;
+}
+
+// 0x5303D0
+TigFile* tig_file_reopen_native(const char* path, const char* mode, TigFile* stream)
+{
+    tig_file_close_internal(stream);
+
+    if (tig_file_open_internal_native(path, mode, stream) == 0) {
+        tig_file_destroy(stream);
+        return NULL;
+    }
+
+    return stream;
+}
+
+// 0x530410
+int tig_file_setbuf(TigFile* stream, char* buffer)
+{
+    if (buffer != NULL) {
+        return tig_file_setvbuf(stream, buffer, _IOFBF, 512);
+    } else {
+        return tig_file_setvbuf(stream, NULL, _IONBF, 512);
+    }
+}
+
+// 0x530440
+int tig_file_setvbuf(TigFile* stream, char* buffer, int mode, size_t size)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_setvbuf(stream->impl.database_file_stream, buffer, mode, size);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return setvbuf(stream->impl.plain_file_stream, buffer, mode, size);
+    }
+
+    return 1;
+}
+
+// 0x530490
+int tig_file_fprintf(TigFile* stream, const char* format, ...)
+{
+    int rc;
+    va_list args;
+
+    va_start(args, format);
+    rc = tig_file_vfprintf(stream, format, args);
+    va_end(args);
+
+    return rc;
+}
+
+// 0x5304C0
+int tig_file_vfprintf(TigFile* stream, const char* format, va_list args)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_vfprintf(stream->impl.database_file_stream, format, args);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return vfprintf(stream->impl.plain_file_stream, format, args);
+    }
+
+    return -1;
+}
+
+// 0x530510
+int tig_file_fgetc(TigFile* stream)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_fgetc(stream->impl.database_file_stream);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return fgetc(stream->impl.plain_file_stream);
+    }
+
+    return -1;
+}
+
+// 0x530540
+char* tig_file_fgets(char* buffer, int max_count, TigFile* stream)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_fgets(buffer, max_count, stream->impl.database_file_stream);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return fgets(buffer, max_count, stream->impl.plain_file_stream);
+    }
+
+    return NULL;
+}
+
+// 0x530580
+int tig_file_fputc(int ch, TigFile* stream)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_fputc(ch, stream->impl.database_file_stream);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return fputc(ch, stream->impl.plain_file_stream);
+    }
+
+    return -1;
+}
+
+// 0x5305C0
+int tig_file_fputs(const char* str, TigFile* stream)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_fputs(str, stream->impl.database_file_stream);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return fputs(str, stream->impl.plain_file_stream);
+    }
+
+    return -1;
+}
+
+// 0x530600
+int tig_file_ungetc(int ch, TigFile* stream)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_ungetc(ch, stream->impl.database_file_stream);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return ungetc(ch, stream->impl.plain_file_stream);
+    }
+
+    return -1;
+}
+
+// 0x530640
+size_t tig_file_fread(void* buffer, size_t size, size_t count, TigFile* stream)
+{
+    if (size == 0 || count == 0) {
+        return 0;
+    }
+
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_fread(buffer, size, count, stream->impl.database_file_stream);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return fread(buffer, size, count, stream->impl.plain_file_stream);
+    }
+
+    return count - 1;
+}
+
+// 0x5306A0
+size_t tig_file_fwrite(const void* buffer, size_t size, size_t count, TigFile* stream)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_fwrite(buffer, size, count, stream->impl.database_file_stream);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return fwrite(buffer, size, count, stream->impl.plain_file_stream);
+    }
+
+    return count - 1;
+}
+
+// 0x5306F0
+int tig_file_fgetpos(TigFile* stream, int* pos_ptr)
+{
+    int pos;
+
+    pos = tig_file_ftell(stream);
+    if (pos == -1) {
+        return 1;
+    }
+
+    *pos_ptr = pos;
+
+    return 0;
+}
+
+// 0x530720
+int tig_file_fseek(TigFile* stream, int offset, int origin)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_fseek(stream->impl.database_file_stream, offset, origin);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return fseek(stream->impl.plain_file_stream, offset, origin);
+    }
+
+    return 1;
+}
+
+// 0x530770
+int tig_file_fsetpos(TigFile* stream, int* pos)
+{
+    return tig_file_fseek(stream, *pos, SEEK_SET);
+}
+
+// 0x530790
+int tig_file_ftell(TigFile* stream)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_ftell(stream->impl.database_file_stream);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return (int)ftell(stream->impl.plain_file_stream);
+    }
+
+    return -1;
+}
+
+// 0x5307C0
+void tig_file_rewind(TigFile* stream)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        tig_database_rewind(stream->impl.database_file_stream);
+    } else if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        rewind(stream->impl.plain_file_stream);
+    }
+}
+
+// 0x5307F0
+void tig_file_clearerr(TigFile* stream)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        tig_database_clearerr(stream->impl.database_file_stream);
+    } else if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        clearerr(stream->impl.plain_file_stream);
+    }
+}
+
+// 0x530820
+int tig_file_feof(TigFile* stream)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_feof(stream->impl.database_file_stream);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return feof(stream->impl.plain_file_stream);
+    }
+
+    return 0;
+}
+
+// 0x530850
+int tig_file_ferror(TigFile* stream)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_ferror(stream->impl.database_file_stream);
+    }
+
+    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        return ferror(stream->impl.plain_file_stream);
+    }
+
+    return 0;
+}
+
+// 0x5308E0
+bool tig_file_lock(const char* filename, const void* owner, size_t size)
+{
     char path[TIG_MAX_PATH];
-    char fname[COMPAT_MAX_FNAME];
-    char ext[COMPAT_MAX_EXT];
+    TigFileRepository* repo;
+    FILE* stream;
 
-    ignored = tig_file_ignored(file_name);
+    if (filename[0] == '.' || filename[0] == '\\' || filename[1] == ':') {
+        strcpy(path, filename);
+    } else {
+        repo = tig_file_repositories_head;
+        while (repo != NULL) {
+            if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
+                break;
+            }
+            repo = repo->next;
+        }
 
-    if (file_name[0] == '.' || file_name[0] == '\\' || file_name[1] == ':' || file_name[0] == '/') {
-        if (!tig_find_first_file(file_name, &ffd)) {
-            tig_find_close(&ffd);
+        if (repo == NULL) {
             return false;
         }
 
-        if (info != NULL) {
-            tig_file_process_attribs(ffd.path_info.type, &(info->attributes));
-            info->size = (size_t)ffd.path_info.size;
-            strcpy(info->path, ffd.name);
-            info->modify_time = SDL_NS_TO_SECONDS(ffd.path_info.modify_time);
+        SDL_snprintf(path, sizeof(path), "%s\\%s", repo->path, filename);
+    }
+
+    tig_file_miss_clear();
+
+    stream = fopen(path, "wbx");
+    if (stream == NULL) {
+        return false;
+    }
+
+    if (size > 1024) {
+        size = 1024;
+    }
+
+    if (fwrite(owner, size, 1, stream) != 1) {
+        fclose(stream);
+        SDL_RemovePath(path);
+        return false;
+    }
+
+    if (fclose(stream) != 0) {
+        SDL_RemovePath(path);
+        return false;
+    }
+
+    return true;
+}
+
+// 0x530A10
+bool tig_file_unlock(const char* filename, const void* owner, size_t size)
+{
+    bool unlocked = true;
+    char drive[COMPAT_MAX_DRIVE];
+    char dir[COMPAT_MAX_DIR];
+    char path[TIG_MAX_PATH];
+    TigFileList file_list;
+    unsigned int index;
+
+    compat_splitpath(filename, drive, dir, NULL, NULL);
+
+    tig_file_list_create(&file_list, filename);
+
+    for (index = 0; index < file_list.count; index++) {
+        if ((file_list.entries[index].attributes & (TIG_FILE_ATTRIBUTE_SUBDIR | TIG_FILE_ATTRIBUTE_0x80)) == 0) {
+            compat_makepath(path, drive, dir, file_list.entries[index].path, NULL);
+            if (!tig_file_locked_by(path, owner, size)
+                || tig_file_remove(path) == -1) {
+                unlocked = false;
+            }
+        }
+    }
+
+    tig_file_list_destroy(&file_list);
+
+    return unlocked;
+}
+
+// 0x530AE0
+bool tig_file_locked_by(const char* filename, const void* owner, size_t size)
+{
+    char path[TIG_MAX_PATH];
+    TigFileRepository* repo;
+
+    if (filename[0] == '.' || filename[0] == '\\' || filename[1] == ':') {
+        strcpy(path, filename);
+    } else {
+        repo = tig_file_repositories_head;
+        while (repo != NULL) {
+            if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
+                break;
+            }
+            repo = repo->next;
+        }
+
+        if (repo == NULL) {
+            return false;
         }
 
-        tig_find_close(&ffd);
-        return true;
+        SDL_snprintf(path, sizeof(path), "%s\\%s", repo->path, filename);
     }
 
-    repo = tig_file_repositories_head;
-    while (repo != NULL) {
-        if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
-            if ((ignored & TIG_FILE_IGNORE_DIRECTORY) == 0) {
-                compat_join_path(path, sizeof(path), repo->path, file_name);
+    return sub_5310C0(path, owner, size);
+}
 
-                if (tig_find_first_file(path, &ffd)) {
-                    if (info != NULL) {
-                        tig_file_process_attribs(ffd.path_info.type, &(info->attributes));
-                        info->size = (size_t)ffd.path_info.size;
-                        strcpy(info->path, ffd.name);
-                        info->modify_time = SDL_NS_TO_SECONDS(ffd.path_info.modify_time);
-                    }
+// 0x530BD0
+TigFile* tig_file_create(void)
+{
+    TigFile* stream;
 
-                    tig_find_close(&ffd);
-                    return true;
-                }
-                tig_find_close(&ffd);
-            }
-        } else if ((repo->type & TIG_FILE_REPOSITORY_DATABASE) != 0) {
-            if ((ignored & TIG_FILE_IGNORE_DATABASE) == 0) {
-                if (tig_database_get_entry(repo->database, file_name, &database_entry)) {
-                    if (info != NULL) {
-                        info->attributes = TIG_FILE_ATTRIBUTE_0x80 | TIG_FILE_ATTRIBUTE_READONLY;
-                        if ((database_entry->flags & TIG_DATABASE_ENTRY_DIRECTORY) != 0) {
-                            info->attributes |= TIG_FILE_ATTRIBUTE_SUBDIR;
-                        }
-                        info->size = database_entry->size;
+    stream = (TigFile*)MALLOC(sizeof(*stream));
+    stream->path = 0;
+    stream->flags = 0;
+    stream->impl.plain_file_stream = 0;
 
-                        compat_splitpath(database_entry->path, NULL, NULL, fname, ext);
-                        compat_makepath(info->path, 0, 0, fname, ext);
-                    }
+    return stream;
+}
 
-                    return true;
-                }
-            }
+// 0x530BF0
+void tig_file_destroy(TigFile* stream)
+{
+    FREE(stream);
+}
+
+// 0x530C00
+bool tig_file_close_internal(TigFile* stream)
+{
+    bool success = false;
+
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        if (tig_database_fclose(stream->impl.database_file_stream) == 0) {
+            success = true;
+        }
+    } else if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        if (fclose(stream->impl.plain_file_stream) == 0) {
+            success = true;
         }
-        repo = repo->next;
     }
 
-    return false;
+    if ((stream->flags & TIG_FILE_DELETE_ON_CLOSE) != 0) {
+        tig_file_remove(stream->path);
+        FREE(stream->path);
+        stream->path = NULL;
+        stream->flags &= ~TIG_FILE_DELETE_ON_CLOSE;
+    }
+
+    return success;
 }
 
-// 0x52FE60
-bool tig_file_exists_in_path_native(const char* search_path, const char* file_name, TigFileInfo* info)
+// 0x530C70
+int tig_file_open_internal_native(const char* path, const char* mode, TigFile* stream)
 {
-    TigFindFileData ffd;
+    unsigned int ignored;
+    unsigned int hash;
+    bool writing;
+    bool missing;
     TigFileRepository* repo;
+    TigFileRepository* writeable_repo;
+    TigFileIndexNode* node;
     TigDatabaseEntry* database_entry;
-    unsigned int ignored;
-    char path[TIG_MAX_PATH];
-    char fname[COMPAT_MAX_FNAME];
-    char ext[COMPAT_MAX_EXT];
+    char mutable_path[TIG_MAX_PATH];
 
-    if (file_name[0] == '.' || file_name[0] == '\\' || file_name[1] == ':' || file_name[0] == '/') {
-        return tig_file_exists_native(file_name, info);
+    stream->flags &= ~(TIG_FILE_DATABASE | TIG_FILE_PLAIN);
+
+    // Files opened for writing might appear in directory repositories.
+    writing = mode[0] != 'r' || strchr(mode, '+') != NULL;
+    if (writing) {
+        tig_file_miss_clear();
     }
 
-    ignored = tig_file_ignored(file_name);
+    if (path[0] == '.' || path[0] == '\\' || path[1] == ':' || path[0] == '/') {
+        stream->impl.plain_file_stream = fopen(path, mode);
+        if (stream->impl.plain_file_stream == NULL) {
+            return 0;
+        }
 
-    repo = tig_file_repositories_head;
-    while (repo != NULL) {
-        if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
-            if ((ignored & TIG_FILE_IGNORE_DATABASE) != 0
-                && SDL_strcasecmp(search_path, repo->path) == 0) {
-                compat_join_path(path, sizeof(path), repo->path, file_name);
+        stream->flags |= TIG_FILE_PLAIN;
+    } else {
+        ignored = tig_file_ignored(path);
+        hash = tig_file_index_hash(path);
+        missing = !writing && tig_file_miss_contains(path, hash);
 
-                if (tig_find_first_file(path, &ffd)) {
-                    if (info != NULL) {
-                        tig_file_process_attribs(ffd.path_info.type, &(info->attributes));
-                        info->size = (size_t)ffd.path_info.size;
-                        strcpy(info->path, ffd.name);
-                        info->modify_time = SDL_NS_TO_SECONDS(ffd.path_info.modify_time);
-                    }
+        node = NULL;
+        if ((ignored & TIG_FILE_IGNORE_DATABASE) == 0) {
+            node = tig_file_index_find(path, hash);
+        }
 
-                    tig_find_close(&ffd);
-                    return true;
-                }
-                tig_find_close(&ffd);
-            }
-        } else if ((repo->type & TIG_FILE_REPOSITORY_DATABASE) != 0) {
-            if ((ignored & TIG_FILE_IGNORE_DATABASE) == 0
-                && SDL_strcasecmp(search_path, repo->path) == 0) {
-                if (tig_database_get_entry(repo->database, file_name, &database_entry)) {
-                    if (info != NULL) {
-                        info->attributes = TIG_FILE_ATTRIBUTE_0x80 | TIG_FILE_ATTRIBUTE_READONLY;
-                        if ((database_entry->flags & TIG_DATABASE_ENTRY_DIRECTORY) != 0) {
-                            info->attributes |= TIG_FILE_ATTRIBUTE_SUBDIR;
+        if (node != NULL) {
+            repo = node->repo;
+            database_entry = node->entry;
+
+            if (!missing
+                && ((database_entry->flags & (TIG_DATABASE_ENTRY_0x100 | TIG_DATABASE_ENTRY_0x200)) != 0
+                    || mode[0] == 'w')) {
+                writeable_repo = tig_file_repositories_head;
+                while (writeable_repo != repo) {
+                    if ((writeable_repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
+                        compat_join_path(mutable_path, sizeof(mutable_path), writeable_repo->path, path);
+                        compat_resolve_path(mutable_path);
+
+                        stream->impl.plain_file_stream = fopen(mutable_path, mode);
+                        if (stream->impl.plain_file_stream != NULL) {
+                            stream->flags |= TIG_FILE_PLAIN;
+                            database_entry->flags &= ~TIG_DATABASE_ENTRY_0x100;
+                            database_entry->flags |= TIG_DATABASE_ENTRY_0x200;
+                            break;
                         }
-                        info->size = database_entry->size;
-
-                        compat_splitpath(database_entry->path, NULL, NULL, fname, ext);
-                        compat_makepath(info->path, 0, 0, fname, ext);
                     }
-
-                    return true;
+                    writeable_repo = writeable_repo->next;
                 }
             }
-        }
-        repo = repo->next;
-    }
 
-    return false;
-}
+            if ((stream->flags & TIG_FILE_PLAIN) == 0) {
+                TigDatabaseMapping* contents;
 
-// 0x5300F0
-int tig_file_remove_native(const char* file_name)
-{
-    TigFileRepository* repo;
-    char path[TIG_MAX_PATH];
-    TigDatabaseEntry* database_entry;
+                database_entry->flags &= ~(TIG_DATABASE_ENTRY_0x100 | TIG_DATABASE_ENTRY_0x200);
 
-    if (file_name[0] == '.' || file_name[0] == '\\' || file_name[1] == ':' || file_name[0] == '/') {
-        return SDL_RemovePath(file_name) ? 0 : 1;
-    }
+                contents = tig_file_prefetch_take(repo->database, database_entry);
+                if (contents != NULL) {
+                    stream->impl.database_file_stream = tig_database_fopen_contents(repo->database, database_entry, mode, contents);
+                    tig_database_unmap_contents(contents);
+                } else {
+                    stream->impl.database_file_stream = NULL;
+                }
 
-    if ((tig_file_ignored(file_name) & 0x2) != 0) {
-        return 1;
-    }
+                if (stream->impl.database_file_stream == NULL) {
+                    stream->impl.database_file_stream = tig_database_fopen_entry(repo->database, database_entry, mode);
+                }
+                stream->flags |= TIG_FILE_DATABASE;
+            }
+        }
 
-    repo = tig_file_repositories_head;
-    while (repo != NULL) {
-        if ((repo->type & TIG_FILE_PLAIN) != 0) {
-            compat_join_path(path, sizeof(path), repo->path, file_name);
+        if ((stream->flags & (TIG_FILE_DATABASE | TIG_FILE_PLAIN)) == 0
+            && (ignored & TIG_FILE_PLAIN) == 0
+            && !missing) {
+            repo = tig_file_repositories_head;
+            while (repo != NULL) {
+                if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
+                    compat_join_path(mutable_path, sizeof(mutable_path), repo->path, path);
+                    compat_resolve_path(mutable_path);
 
-            if (SDL_RemovePath(path)) {
-                repo = repo->next;
-                while (repo != NULL) {
-                    if ((repo->type & TIG_FILE_DATABASE) != 0
-                        && tig_database_get_entry(repo->database, file_name, &database_entry)) {
-                        database_entry->flags &= ~0x200;
-                        database_entry->flags |= 0x100;
+                    stream->impl.plain_file_stream = fopen(mutable_path, mode);
+                    if (stream->impl.plain_file_stream != NULL) {
+                        stream->flags |= TIG_FILE_PLAIN;
                         break;
                     }
-                    repo = repo->next;
                 }
+                repo = repo->next;
+            }
 
-                return 0;
+            // Every directory repository was tried.
+            if (!writing && (stream->flags & TIG_FILE_PLAIN) == 0) {
+                tig_file_miss_add(path, hash);
             }
         }
-        repo = repo->next;
     }
 
-    return 1;
+    return stream->flags & (TIG_FILE_DATABASE | TIG_FILE_PLAIN);
 }
 
-// 0x5301F0
-int tig_file_rename_native(const char* old_file_name, const char* new_file_name)
+// 0x530F90
+void tig_file_process_attribs(SDL_PathType type, unsigned int* flags)
 {
-    TigFileRepository* repo;
-    char old_path[TIG_MAX_PATH];
-    char new_path[TIG_MAX_PATH];
-
-    if (old_file_name[0] == '.' || old_file_name[0] == '\\' || old_file_name[1] == ':' || old_file_name[0] == '/') {
-        return SDL_RenamePath(old_file_name, new_file_name) ? 0 : 1;
-    }
-
-    if ((tig_file_ignored(old_file_name) & 0x2) != 0) {
-        return 1;
-    }
-
-    repo = tig_file_repositories_head;
-    while (repo != NULL) {
-        if ((repo->type & TIG_FILE_PLAIN) != 0) {
-            compat_join_path(old_path, sizeof(old_path), repo->path, old_file_name);
-            compat_join_path(new_path, sizeof(new_path), repo->path, new_file_name);
+    *flags = 0;
 
-            if (SDL_RenamePath(old_path, new_path)) {
-                return 0;
-            }
-        }
-        repo = repo->next;
+    if (type == SDL_PATHTYPE_DIRECTORY) {
+        *flags |= TIG_FILE_ATTRIBUTE_SUBDIR;
     }
-
-    return 1;
 }
 
-// 0x530330
-int tig_file_fclose(TigFile* stream)
+// 0x530FD0
+void tig_file_list_add(TigFileList* list, TigFileInfo* info)
 {
-    bool success;
+    if (list->count != 0) {
+        int l = 0;
+        int r = list->count - 1;
+        int m;
+        int cmp;
 
-    success = tig_file_close_internal(stream);
-    tig_file_destroy(stream);
+        while (l <= r) {
+            m = (l + r) / 2;
+            cmp = SDL_strcasecmp(list->entries[m].path, info->path);
+            if (cmp < 0) {
+                l = m + 1;
+            } else if (cmp > 0) {
+                r = m - 1;
+            } else {
+                // Already added.
+                return;
+            }
+        }
 
-    if (!success) {
-        return EOF;
+        list->entries = (TigFileInfo*)REALLOC(list->entries, sizeof(TigFileInfo) * (list->count + 1));
+        memmove(&(list->entries[l + 1]), &(list->entries[l]), sizeof(TigFileInfo) * (list->count - l));
+        list->entries[l] = *info;
+        list->count++;
+    } else {
+        list->entries = (TigFileInfo*)MALLOC(sizeof(TigFileInfo));
+        list->entries[0] = *info;
+        list->count++;
     }
-
-    return 0;
 }
 
-// 0x530360
-int tig_file_fflush(TigFile* stream)
+// 0x5310C0
+bool sub_5310C0(const char* filename, const void* owner, size_t size)
 {
+    FILE* stream;
+    uint8_t file_owner[1024];
+
+    stream = fopen(filename, "rb");
     if (stream == NULL) {
-        return fflush(stdin);
+        return false;
     }
 
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_fflush(stream->impl.database_file_stream);
+    if (size > 1024) {
+        size = 1024;
     }
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return fflush(stream->impl.plain_file_stream);
+    if (fread(file_owner, size, 1, stream) != 0) {
+        fclose(stream);
+        return false;
     }
 
-    return -1;
+    if (memcmp(owner, file_owner, size) != 0) {
+        fclose(stream);
+        return false;
+    }
+
+    fclose(stream);
+
+    return true;
 }
 
-// 0x5303A0
-TigFile* tig_file_fopen_native(const char* path, const char* mode)
+// 0x531170
+unsigned int tig_file_ignored(const char* path)
 {
-    TigFile* stream;
+    if (!fpattern_isvalid(path)) {
+        return 0;
+    }
 
-    stream = tig_file_create();
-    if (tig_file_open_internal_native(path, mode, stream) == 0) {
-        tig_file_destroy(stream);
-        return NULL;
+    off_62B2A8 = tig_file_ignore_head;
+    while (off_62B2A8 != NULL) {
+        if (fpattern_matchn(off_62B2A8->path, path)) {
+            return off_62B2A8->flags;
+        }
+        off_62B2A8 = off_62B2A8->next;
     }
 
-    return stream;
+    return 0;
 }
 
-// 0x5303D0
-TigFile* tig_file_reopen_native(const char* path, const char* mode, TigFile* stream)
+// 0x5311D0
+bool tig_file_copy_native(const char* src, const char* dst)
 {
-    tig_file_close_internal(stream);
+    TigFile* in;
+    TigFile* out;
 
-    if (tig_file_open_internal_native(path, mode, stream) == 0) {
-        tig_file_destroy(stream);
-        return NULL;
+    if (!tig_file_exists_native(src, NULL)) {
+        return false;
     }
 
-    return stream;
-}
-
-// 0x530410
-int tig_file_setbuf(TigFile* stream, char* buffer)
-{
-    if (buffer != NULL) {
-        return tig_file_setvbuf(stream, buffer, _IOFBF, 512);
-    } else {
-        return tig_file_setvbuf(stream, NULL, _IONBF, 512);
+    in = tig_file_fopen_native(src, "rb");
+    if (in == NULL) {
+        return false;
     }
-}
 
-// 0x530440
-int tig_file_setvbuf(TigFile* stream, char* buffer, int mode, size_t size)
-{
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_setvbuf(stream->impl.database_file_stream, buffer, mode, size);
+    out = tig_file_fopen_native(dst, "wb");
+    if (out == NULL) {
+        tig_file_fclose(in);
+        return false;
     }
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return setvbuf(stream->impl.plain_file_stream, buffer, mode, size);
+    if (!tig_file_copy_internal(out, in)) {
+        tig_file_fclose(out);
+        tig_file_fclose(in);
+        return false;
     }
 
-    return 1;
+    tig_file_fclose(out);
+    tig_file_fclose(in);
+    return true;
 }
 
-// 0x530490
-int tig_file_fprintf(TigFile* stream, const char* format, ...)
+// 0x531250
+bool tig_file_copy_internal(TigFile* dst, TigFile* src)
 {
-    int rc;
-    va_list args;
+    unsigned char buffer[1 << 15];
+    unsigned int size;
 
-    va_start(args, format);
-    rc = tig_file_vfprintf(stream, format, args);
-    va_end(args);
+    size = tig_file_filelength(src);
+    if (src == 0) {
+        return false;
+    }
 
-    return rc;
-}
+    while (size >= sizeof(buffer)) {
+        if (tig_file_fread(buffer, sizeof(buffer), 1, src) != 1) {
+            return false;
+        }
 
-// 0x5304C0
-int tig_file_vfprintf(TigFile* stream, const char* format, va_list args)
-{
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_vfprintf(stream->impl.database_file_stream, format, args);
-    }
+        if (tig_file_fwrite(buffer, sizeof(buffer), 1, dst) != 1) {
+            return false;
+        }
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return vfprintf(stream->impl.plain_file_stream, format, args);
+        size -= sizeof(buffer);
     }
 
-    return -1;
-}
-
-// 0x530510
-int tig_file_fgetc(TigFile* stream)
-{
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_fgetc(stream->impl.database_file_stream);
+    if (tig_file_fread(buffer, size, 1, src) != 1) {
+        return false;
     }
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return fgetc(stream->impl.plain_file_stream);
+    if (tig_file_fwrite(buffer, size, 1, dst) != 1) {
+        return false;
     }
 
-    return -1;
+    return true;
 }
 
-// 0x530540
-char* tig_file_fgets(char* buffer, int max_count, TigFile* stream)
+// 0x531320
+int tig_file_rmdir_recursively_native(const char* path)
 {
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_fgets(buffer, max_count, stream->impl.database_file_stream);
-    }
+    char mutable_path[TIG_MAX_PATH];
+    TigFindFileData ffd;
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return fgets(buffer, max_count, stream->impl.plain_file_stream);
-    }
+    compat_join_path(mutable_path, sizeof(mutable_path), path, "*.*");
 
-    return NULL;
-}
+    if (tig_find_first_file(mutable_path, &ffd)) {
+        do {
+            compat_join_path(mutable_path, sizeof(mutable_path), path, ffd.name);
 
-// 0x530580
-int tig_file_fputc(int ch, TigFile* stream)
-{
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_fputc(ch, stream->impl.database_file_stream);
+            if (ffd.path_info.type == SDL_PATHTYPE_DIRECTORY) {
+                if (strcmp(ffd.name, ".") != 0
+                    && strcmp(ffd.name, "..") != 0) {
+                    tig_file_rmdir_recursively_native(mutable_path);
+                }
+            } else {
+                SDL_RemovePath(mutable_path);
+            }
+        } while (tig_find_next_file(&ffd));
     }
+    tig_find_close(&ffd);
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return fputc(ch, stream->impl.plain_file_stream);
+    if (!SDL_RemovePath(path)) {
+        return -1;
     }
 
-    return -1;
+    return 0;
 }
 
-// 0x5305C0
-int tig_file_fputs(const char* str, TigFile* stream)
+unsigned int tig_file_index_hash(const char* path)
 {
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_fputs(str, stream->impl.database_file_stream);
-    }
+    unsigned int hash = 2166136261u;
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return fputs(str, stream->impl.plain_file_stream);
+    // Case-insensitive FNV-1a, archive entries are stored in lower case.
+    while (*path != '\0') {
+        hash ^= (unsigned char)SDL_tolower((unsigned char)*path++);
+        hash *= 16777619u;
     }
 
-    return -1;
+    return hash;
 }
 
-// 0x530600
-int tig_file_ungetc(int ch, TigFile* stream)
+void tig_file_index_rebuild(void)
 {
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_ungetc(ch, stream->impl.database_file_stream);
-    }
+    TigFileRepository* repo;
+    TigFileRepository** repos;
+    TigDatabaseEntry* entry;
+    TigFileIndexNode* node;
+    unsigned int repos_count;
+    unsigned int nodes_count;
+    unsigned int buckets_count;
+    unsigned int bucket;
+    unsigned int index;
+    unsigned int entry_index;
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return ungetc(ch, stream->impl.plain_file_stream);
-    }
+    tig_file_index_free();
 
-    return -1;
-}
+    // Set of files available in archives changes together with repositories.
+    tig_file_miss_clear();
 
-// 0x530640
-size_t tig_file_fread(void* buffer, size_t size, size_t count, TigFile* stream)
-{
-    if (size == 0 || count == 0) {
-        return 0;
-    }
+    // Prefetched contents might be shadowed now.
+    tig_file_prefetch_flush();
 
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_fread(buffer, size, count, stream->impl.database_file_stream);
+    repos_count = 0;
+    nodes_count = 0;
+    for (repo = tig_file_repositories_head; repo != NULL; repo = repo->next) {
+        repos_count++;
+        if ((repo->type & TIG_FILE_REPOSITORY_DATABASE) != 0) {
+            nodes_count += repo->database->entries_count;
+        }
     }
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return fread(buffer, size, count, stream->impl.plain_file_stream);
+    if (nodes_count == 0) {
+        return;
     }
 
-    return count - 1;
-}
+    repos = (TigFileRepository**)MALLOC(sizeof(*repos) * repos_count);
+    index = 0;
+    for (repo = tig_file_repositories_head; repo != NULL; repo = repo->next) {
+        repos[index++] = repo;
+    }
 
-// 0x5306A0
-size_t tig_file_fwrite(const void* buffer, size_t size, size_t count, TigFile* stream)
-{
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_fwrite(buffer, size, count, stream->impl.database_file_stream);
+    buckets_count = 1;
+    while (buckets_count < nodes_count * 2) {
+        buckets_count <<= 1;
     }
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return fwrite(buffer, size, count, stream->impl.plain_file_stream);
+    tig_file_index_nodes = (TigFileIndexNode*)MALLOC(sizeof(*tig_file_index_nodes) * nodes_count);
+    tig_file_index_buckets = (int*)MALLOC(sizeof(*tig_file_index_buckets) * buckets_count);
+    tig_file_index_mask = buckets_count - 1;
+
+    for (bucket = 0; bucket < buckets_count; bucket++) {
+        tig_file_index_buckets[bucket] = -1;
     }
 
-    return count - 1;
-}
+    // Walk repositories from the lowest priority to the highest and prepend
+    // nodes, so that chains end up in the lookup order.
+    node = tig_file_index_nodes;
+    while (repos_count > 0) {
+        repo = repos[--repos_count];
+        if ((repo->type & TIG_FILE_REPOSITORY_DATABASE) == 0) {
+            continue;
+        }
 
-// 0x5306F0
-int tig_file_fgetpos(TigFile* stream, int* pos_ptr)
-{
-    int pos;
+        for (entry_index = 0; entry_index < repo->database->entries_count; entry_index++) {
+            entry = &(repo->database->entries[entry_index]);
+            if ((entry->flags & TIG_DATABASE_ENTRY_IGNORED) != 0) {
+                continue;
+            }
 
-    pos = tig_file_ftell(stream);
-    if (pos == -1) {
-        return 1;
-    }
+            node->hash = tig_file_index_hash(entry->path);
+            node->repo = repo;
+            node->entry = entry;
 
-    *pos_ptr = pos;
+            bucket = node->hash & tig_file_index_mask;
+            node->next = tig_file_index_buckets[bucket];
+            tig_file_index_buckets[bucket] = (int)(node - tig_file_index_nodes);
+            node++;
+        }
+    }
 
-    return 0;
+    FREE(repos);
 }
 
-// 0x530720
-int tig_file_fseek(TigFile* stream, int offset, int origin)
+void tig_file_index_free(void)
 {
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_fseek(stream->impl.database_file_stream, offset, origin);
+    if (tig_file_index_nodes != NULL) {
+        FREE(tig_file_index_nodes);
+        tig_file_index_nodes = NULL;
     }
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return fseek(stream->impl.plain_file_stream, offset, origin);
+    if (tig_file_index_buckets != NULL) {
+        FREE(tig_file_index_buckets);
+        tig_file_index_buckets = NULL;
     }
 
-    return 1;
-}
-
-// 0x530770
-int tig_file_fsetpos(TigFile* stream, int* pos)
-{
-    return tig_file_fseek(stream, *pos, SEEK_SET);
+    tig_file_index_mask = 0;
 }
 
-// 0x530790
-int tig_file_ftell(TigFile* stream)
+TigFileIndexNode* tig_file_index_find(const char* path, unsigned int hash)
 {
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_ftell(stream->impl.database_file_stream);
+    int index;
+    TigFileIndexNode* node;
+
+    if (tig_file_index_buckets == NULL) {
+        return NULL;
     }
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return (int)ftell(stream->impl.plain_file_stream);
+    index = tig_file_index_buckets[hash & tig_file_index_mask];
+    while (index != -1) {
+        node = &(tig_file_index_nodes[index]);
+        if (node->hash == hash && SDL_strcasecmp(node->entry->path, path) == 0) {
+            return node;
+        }
+        index = node->next;
     }
 
-    return -1;
+    return NULL;
 }
 
-// 0x5307C0
-void tig_file_rewind(TigFile* stream)
+bool tig_file_miss_contains(const char* path, unsigned int hash)
 {
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        tig_database_rewind(stream->impl.database_file_stream);
-    } else if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        rewind(stream->impl.plain_file_stream);
+    TigFileMissNode* node;
+
+    node = tig_file_miss_buckets[hash % TIG_FILE_MISS_BUCKETS];
+    while (node != NULL) {
+        if (node->hash == hash && SDL_strcasecmp(node->path, path) == 0) {
+            return true;
+        }
+        node = node->next;
     }
+
+    return false;
 }
 
-// 0x5307F0
-void tig_file_clearerr(TigFile* stream)
+void tig_file_miss_add(const char* path, unsigned int hash)
 {
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        tig_database_clearerr(stream->impl.database_file_stream);
-    } else if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        clearerr(stream->impl.plain_file_stream);
+    TigFileMissNode* node;
+
+    if (tig_file_miss_count >= TIG_FILE_MISS_MAX) {
+        tig_file_miss_clear();
     }
+
+    node = (TigFileMissNode*)MALLOC(sizeof(*node));
+    node->hash = hash;
+    node->path = STRDUP(path);
+    node->next = tig_file_miss_buckets[hash % TIG_FILE_MISS_BUCKETS];
+    tig_file_miss_buckets[hash % TIG_FILE_MISS_BUCKETS] = node;
+    tig_file_miss_count++;
 }
 
-// 0x530820
-int tig_file_feof(TigFile* stream)
+void tig_file_miss_clear(void)
 {
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_feof(stream->impl.database_file_stream);
+    int bucket;
+    TigFileMissNode* node;
+    TigFileMissNode* next;
+
+    if (tig_file_miss_count == 0) {
+        return;
     }
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return feof(stream->impl.plain_file_stream);
+    for (bucket = 0; bucket < TIG_FILE_MISS_BUCKETS; bucket++) {
+        node = tig_file_miss_buckets[bucket];
+        while (node != NULL) {
+            next = node->next;
+            FREE(node->path);
+            FREE(node);
+            node = next;
+        }
+        tig_file_miss_buckets[bucket] = NULL;
     }
 
-    return 0;
+    tig_file_miss_count = 0;
 }
 
-// 0x530850
-int tig_file_ferror(TigFile* stream)
+void tig_file_prefetch_init(void)
 {
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        return tig_database_ferror(stream->impl.database_file_stream);
+    int count;
+    int index;
+
+    tig_file_prefetch_mutex = SDL_CreateMutex();
+    tig_file_prefetch_queued_cond = SDL_CreateCondition();
+    tig_file_prefetch_done_cond = SDL_CreateCondition();
+    tig_file_prefetch_quit = false;
+
+    // Leave one core for the main thread.
+    count = SDL_GetNumLogicalCPUCores() - 1;
+    if (count < 1) {
+        count = 1;
+    } else if (count > TIG_FILE_PREFETCH_MAX_WORKERS) {
+        count = TIG_FILE_PREFETCH_MAX_WORKERS;
     }
 
-    if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        return ferror(stream->impl.plain_file_stream);
+    // NOTE: Failing to start workers is not fatal, pending requests are
+    // executed on the main thread when someone needs them.
+    tig_file_prefetch_workers_count = 0;
+    for (index = 0; index < count; index++) {
+        tig_file_prefetch_workers[tig_file_prefetch_workers_count] = SDL_CreateThread(tig_file_prefetch_worker, "TIG File Prefetch", NULL);
+        if (tig_file_prefetch_workers[tig_file_prefetch_workers_count] != NULL) {
+            tig_file_prefetch_workers_count++;
+        }
     }
-
-    return 0;
 }
 
-// 0x5308E0
-bool tig_file_lock(const char* filename, const void* owner, size_t size)
+void tig_file_prefetch_exit(void)
 {
-    char path[TIG_MAX_PATH];
-    TigFileRepository* repo;
-    FILE* stream;
+    int index;
 
-    if (filename[0] == '.' || filename[0] == '\\' || filename[1] == ':') {
-        strcpy(path, filename);
-    } else {
-        repo = tig_file_repositories_head;
-        while (repo != NULL) {
-            if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
-                break;
-            }
-            repo = repo->next;
-        }
+    tig_file_prefetch_flush();
 
-        if (repo == NULL) {
-            return false;
-        }
+    SDL_LockMutex(tig_file_prefetch_mutex);
+    tig_file_prefetch_quit = true;
+    SDL_BroadcastCondition(tig_file_prefetch_queued_cond);
+    SDL_UnlockMutex(tig_file_prefetch_mutex);
 
-        SDL_snprintf(path, sizeof(path), "%s\\%s", repo->path, filename);
+    for (index = 0; index < tig_file_prefetch_workers_count; index++) {
+        SDL_WaitThread(tig_file_prefetch_workers[index], NULL);
+        tig_file_prefetch_workers[index] = NULL;
     }
+    tig_file_prefetch_workers_count = 0;
 
-    stream = fopen(path, "wbx");
-    if (stream == NULL) {
+    SDL_DestroyCondition(tig_file_prefetch_done_cond);
+    tig_file_prefetch_done_cond = NULL;
+
+    SDL_DestroyCondition(tig_file_prefetch_queued_cond);
+    tig_file_prefetch_queued_cond = NULL;
+
+    SDL_DestroyMutex(tig_file_prefetch_mutex);
+    tig_file_prefetch_mutex = NULL;
+}
+
+bool tig_file_locate_native(const char* path, TigFileLocation* location)
+{
+    unsigned int ignored;
+    unsigned int hash;
+    TigFileIndexNode* node;
+    TigFileRepository* repo;
+    SDL_PathInfo path_info;
+    char mutable_path[TIG_MAX_PATH];
+
+    if (path[0] == '.' || path[0] == '\\' || path[1] == ':' || path[0] == '/') {
         return false;
     }
 
-    if (size > 1024) {
-        size = 1024;
+    ignored = tig_file_ignored(path);
+    if ((ignored & TIG_FILE_IGNORE_DATABASE) != 0) {
+        return false;
     }
 
-    if (fwrite(owner, size, 1, stream) != 1) {
-        fclose(stream);
-        SDL_RemovePath(path);
+    hash = tig_file_index_hash(path);
+    node = tig_file_index_find(path, hash);
+    if (node == NULL) {
         return false;
     }
 
-    if (fclose(stream) != 0) {
-        SDL_RemovePath(path);
+    // Mirror `tig_file_open_internal_native`: the entry can be overridden
+    // by a loose file in the directory repository in front of the archive.
+    if ((node->entry->flags & (TIG_DATABASE_ENTRY_0x100 | TIG_DATABASE_ENTRY_0x200)) != 0
+        && !tig_file_miss_contains(path, hash)) {
+        for (repo = tig_file_repositories_head; repo != node->repo; repo = repo->next) {
+            if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
+                compat_join_path(mutable_path, sizeof(mutable_path), repo->path, path);
+                compat_resolve_path(mutable_path);
+
+                if (SDL_GetPathInfo(mutable_path, &path_info)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    if (!SDL_GetPathInfo(node->repo->database->path, &path_info)) {
         return false;
     }
 
+    snprintf(location->archive_path, sizeof(location->archive_path), "%s", node->repo->database->path);
+    location->archive_size = path_info.size;
+    location->archive_modify_time = SDL_NS_TO_SECONDS(path_info.modify_time);
+    location->offset = (unsigned int)node->entry->offset;
+    location->size = node->entry->size;
+    location->compressed_size = node->entry->compressed_size;
+
+    // The rest are runtime bookkeeping flags.
+    location->flags = node->entry->flags & (TIG_DATABASE_ENTRY_PLAIN | TIG_DATABASE_ENTRY_COMPRESSED);
+
     return true;
 }
 
-// 0x530A10
-bool tig_file_unlock(const char* filename, const void* owner, size_t size)
+unsigned int tig_file_prefetch_native(const char* path, int priority)
 {
-    bool unlocked = true;
-    char drive[COMPAT_MAX_DRIVE];
-    char dir[COMPAT_MAX_DIR];
-    char path[TIG_MAX_PATH];
-    TigFileList file_list;
-    unsigned int index;
-
-    compat_splitpath(filename, drive, dir, NULL, NULL);
-
-    tig_file_list_create(&file_list, filename);
+    unsigned int ignored;
+    unsigned int hash;
+    TigFileIndexNode* node;
+    TigFileRepository* repo;
+    TigFilePrefetchRequest* request;
+    TigFilePrefetchRequest* next;
+    TigFilePrefetchRequest* tail;
+    SDL_PathInfo path_info;
+    char mutable_path[TIG_MAX_PATH];
 
-    for (index = 0; index < file_list.count; index++) {
-        if ((file_list.entries[index].attributes & (TIG_FILE_ATTRIBUTE_SUBDIR | TIG_FILE_ATTRIBUTE_0x80)) == 0) {
-            compat_makepath(path, drive, dir, file_list.entries[index].path, NULL);
-            if (!tig_file_locked_by(path, owner, size)
-                || tig_file_remove(path) == -1) {
-                unlocked = false;
-            }
-        }
+    if (tig_file_prefetch_mutex == NULL) {
+        return 0;
     }
 
-    tig_file_list_destroy(&file_list);
+    // Only archive entries are prefetched, the OS does a good job with loose
+    // files on its own.
+    if (path[0] == '.' || path[0] == '\\' || path[1] == ':' || path[0] == '/') {
+        return 0;
+    }
 
-    return unlocked;
-}
+    ignored = tig_file_ignored(path);
+    if ((ignored & TIG_FILE_IGNORE_DATABASE) != 0) {
+        return 0;
+    }
 
-// 0x530AE0
-bool tig_file_locked_by(const char* filename, const void* owner, size_t size)
-{
-    char path[TIG_MAX_PATH];
-    TigFileRepository* repo;
+    hash = tig_file_index_hash(path);
+    node = tig_file_index_find(path, hash);
+    if (node == NULL) {
+        return 0;
+    }
 
-    if (filename[0] == '.' || filename[0] == '\\' || filename[1] == ':') {
-        strcpy(path, filename);
-    } else {
-        repo = tig_file_repositories_head;
-        while (repo != NULL) {
+    // Mirror `tig_file_open_internal_native`: the entry can be overridden
+    // by a loose file in the directory repository in front of the archive.
+    if ((node->entry->flags & (TIG_DATABASE_ENTRY_0x100 | TIG_DATABASE_ENTRY_0x200)) != 0
+        && !tig_file_miss_contains(path, hash)) {
+        for (repo = tig_file_repositories_head; repo != node->repo; repo = repo->next) {
             if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
-                break;
+                compat_join_path(mutable_path, sizeof(mutable_path), repo->path, path);
+                compat_resolve_path(mutable_path);
+
+                if (SDL_GetPathInfo(mutable_path, &path_info)) {
+                    return 0;
+                }
             }
-            repo = repo->next;
+        }
+    }
+
+    SDL_LockMutex(tig_file_prefetch_mutex);
+
+    // Merge with an outstanding request for the same entry, and sweep
+    // requests which have nothing to serve anymore along the way.
+    tail = NULL;
+    request = tig_file_prefetch_requests_head;
+    while (request != NULL) {
+        if (request->state == TIG_FILE_PREFETCH_FAILED
+            || (request->state == TIG_FILE_PREFETCH_DONE && request->contents == NULL)) {
+            next = request->next;
+            tig_file_prefetch_discard(request);
+            request = next;
+            continue;
         }
 
-        if (repo == NULL) {
-            return false;
+        if (request->entry == node->entry) {
+            if (request->priority < priority) {
+                request->priority = priority;
+            }
+
+            SDL_UnlockMutex(tig_file_prefetch_mutex);
+            return request->handle;
         }
 
-        SDL_snprintf(path, sizeof(path), "%s\\%s", repo->path, filename);
+        tail = request;
+        request = request->next;
     }
 
-    return sub_5310C0(path, owner, size);
-}
+    // Zero is reserved for "no request".
+    if (++tig_file_prefetch_next_handle == 0) {
+        tig_file_prefetch_next_handle++;
+    }
 
-// 0x530BD0
-TigFile* tig_file_create(void)
-{
-    TigFile* stream;
+    request = (TigFilePrefetchRequest*)MALLOC(sizeof(*request));
+    request->handle = tig_file_prefetch_next_handle;
+    request->priority = priority;
+    request->state = TIG_FILE_PREFETCH_QUEUED;
+    request->database = node->repo->database;
+    request->entry = node->entry;
+    request->contents = NULL;
+    request->next = NULL;
+
+    if (tail != NULL) {
+        tail->next = request;
+    } else {
+        tig_file_prefetch_requests_head = request;
+    }
+    tig_file_prefetch_requests_count++;
 
-    stream = (TigFile*)MALLOC(sizeof(*stream));
-    stream->path = 0;
-    stream->flags = 0;
-    stream->impl.plain_file_stream = 0;
+    SDL_SignalCondition(tig_file_prefetch_queued_cond);
+    SDL_UnlockMutex(tig_file_prefetch_mutex);
 
-    return stream;
+    return request->handle;
 }
 
-// 0x530BF0
-void tig_file_destroy(TigFile* stream)
+// Blocks until the request identified by `handle` is completed. Requests
+// which are still in the queue are executed right away on the calling thread.
+//
+// Returns `false` if the entry could not be read.
+bool tig_file_prefetch_wait(unsigned int handle)
 {
-    FREE(stream);
-}
+    TigFilePrefetchRequest* request;
+    bool success;
 
-// 0x530C00
-bool tig_file_close_internal(TigFile* stream)
-{
-    bool success = false;
+    if (handle == 0 || tig_file_prefetch_mutex == NULL) {
+        return true;
+    }
 
-    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
-        if (tig_database_fclose(stream->impl.database_file_stream) == 0) {
-            success = true;
-        }
-    } else if ((stream->flags & TIG_FILE_PLAIN) != 0) {
-        if (fclose(stream->impl.plain_file_stream) == 0) {
-            success = true;
-        }
+    SDL_LockMutex(tig_file_prefetch_mutex);
+
+    request = tig_file_prefetch_requests_head;
+    while (request != NULL && request->handle != handle) {
+        request = request->next;
     }
 
-    if ((stream->flags & TIG_FILE_DELETE_ON_CLOSE) != 0) {
-        tig_file_remove(stream->path);
-        FREE(stream->path);
-        stream->path = NULL;
-        stream->flags &= ~TIG_FILE_DELETE_ON_CLOSE;
+    // Already consumed by `tig_file_fopen` (or flushed).
+    if (request == NULL) {
+        SDL_UnlockMutex(tig_file_prefetch_mutex);
+        return true;
+    }
+
+    tig_file_prefetch_complete(request);
+
+    success = request->state == TIG_FILE_PREFETCH_DONE;
+
+    // Keep only requests that have something to serve.
+    if (request->contents == NULL) {
+        tig_file_prefetch_discard(request);
     }
 
+    SDL_UnlockMutex(tig_file_prefetch_mutex);
+
     return success;
 }
 
-// 0x530C70
-int tig_file_open_internal_native(const char* path, const char* mode, TigFile* stream)
+int tig_file_prefetch_worker(void* userdata)
 {
-    unsigned int ignored;
-    TigFileRepository* repo;
-    TigFileRepository* writeable_repo;
-    TigDatabaseEntry* database_entry;
-    char mutable_path[TIG_MAX_PATH];
+    TigFilePrefetchRequest* request;
 
-    stream->flags &= ~(TIG_FILE_DATABASE | TIG_FILE_PLAIN);
+    (void)userdata;
 
-    if (path[0] == '.' || path[0] == '\\' || path[1] == ':' || path[0] == '/') {
-        stream->impl.plain_file_stream = fopen(path, mode);
-        if (stream->impl.plain_file_stream == NULL) {
-            return 0;
+    SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_LOW);
+
+    SDL_LockMutex(tig_file_prefetch_mutex);
+
+    while (!tig_file_prefetch_quit) {
+        request = tig_file_prefetch_next_queued();
+        if (request == NULL) {
+            SDL_WaitCondition(tig_file_prefetch_queued_cond, tig_file_prefetch_mutex);
+            continue;
         }
 
-        stream->flags |= TIG_FILE_PLAIN;
-    } else {
-        ignored = tig_file_ignored(path);
+        tig_file_prefetch_run(request);
+    }
 
-        repo = tig_file_repositories_head;
-        while (repo != NULL) {
-            if ((repo->type & TIG_FILE_REPOSITORY_DATABASE) != 0
-                && (ignored & TIG_FILE_IGNORE_DATABASE) == 0
-                && tig_database_get_entry(repo->database, path, &database_entry)) {
-                if ((database_entry->flags & (TIG_DATABASE_ENTRY_0x100 | TIG_DATABASE_ENTRY_0x200)) != 0
-                    || mode[0] == 'w') {
-                    writeable_repo = tig_file_repositories_head;
-                    while (writeable_repo != repo) {
-                        if ((writeable_repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
-                            compat_join_path(mutable_path, sizeof(mutable_path), writeable_repo->path, path);
-                            compat_resolve_path(mutable_path);
-
-                            stream->impl.plain_file_stream = fopen(mutable_path, mode);
-                            if (stream->impl.plain_file_stream != NULL) {
-                                stream->flags |= TIG_FILE_PLAIN;
-                                database_entry->flags &= ~TIG_DATABASE_ENTRY_0x100;
-                                database_entry->flags |= TIG_DATABASE_ENTRY_0x200;
-                                break;
-                            }
-                        }
-                        writeable_repo = writeable_repo->next;
-                    }
-                }
+    SDL_UnlockMutex(tig_file_prefetch_mutex);
 
-                if ((stream->flags & TIG_FILE_PLAIN) == 0) {
-                    database_entry->flags &= ~(TIG_DATABASE_ENTRY_0x100 | TIG_DATABASE_ENTRY_0x200);
-                    stream->impl.database_file_stream = tig_database_fopen_entry(repo->database, database_entry, mode);
-                    stream->flags |= TIG_FILE_DATABASE;
-                }
-                break;
-            }
-            repo = repo->next;
+    return 0;
+}
+
+// Returns queued request with the highest priority (the oldest one among
+// equals). Must be called with `tig_file_prefetch_mutex` held.
+TigFilePrefetchRequest* tig_file_prefetch_next_queued(void)
+{
+    TigFilePrefetchRequest* request;
+    TigFilePrefetchRequest* best;
+
+    best = NULL;
+    for (request = tig_file_prefetch_requests_head; request != NULL; request = request->next) {
+        if (request->state == TIG_FILE_PREFETCH_QUEUED
+            && (best == NULL || request->priority > best->priority)) {
+            best = request;
         }
+    }
 
-        if ((stream->flags & (TIG_FILE_DATABASE | TIG_FILE_PLAIN)) == 0
-            && (ignored & TIG_FILE_PLAIN) == 0) {
-            repo = tig_file_repositories_head;
-            while (repo != NULL) {
-                if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
-                    compat_join_path(mutable_path, sizeof(mutable_path), repo->path, path);
-                    compat_resolve_path(mutable_path);
+    return best;
+}
 
-                    stream->impl.plain_file_stream = fopen(mutable_path, mode);
-                    if (stream->impl.plain_file_stream != NULL) {
-                        stream->flags |= TIG_FILE_PLAIN;
-                        break;
-                    }
+// Executes queued request. Must be called with `tig_file_prefetch_mutex`
+// held, the lock is released while the entry is being read.
+void tig_file_prefetch_run(TigFilePrefetchRequest* request)
+{
+    TigFilePrefetchRequest* victim;
+    TigDatabaseMapping* contents;
+    bool success;
+
+    request->state = TIG_FILE_PREFETCH_RUNNING;
+
+    SDL_UnlockMutex(tig_file_prefetch_mutex);
+    success = tig_database_prefetch(request->database, request->entry, &contents);
+    SDL_LockMutex(tig_file_prefetch_mutex);
+
+    if (success) {
+        request->state = TIG_FILE_PREFETCH_DONE;
+        request->contents = contents;
+
+        if (contents != NULL) {
+            tig_file_prefetch_contents_size += request->entry->size;
+
+            // Drop the oldest contents to stay within budget.
+            victim = tig_file_prefetch_requests_head;
+            while (victim != NULL && tig_file_prefetch_contents_size > TIG_FILE_PREFETCH_BUDGET) {
+                if (victim->contents != NULL) {
+                    tig_database_unmap_contents(victim->contents);
+                    victim->contents = NULL;
+                    tig_file_prefetch_contents_size -= victim->entry->size;
                 }
-                repo = repo->next;
+                victim = victim->next;
             }
         }
+    } else {
+        request->state = TIG_FILE_PREFETCH_FAILED;
     }
 
-    return stream->flags & (TIG_FILE_DATABASE | TIG_FILE_PLAIN);
+    SDL_BroadcastCondition(tig_file_prefetch_done_cond);
 }
 
-// 0x530F90
-void tig_file_process_attribs(SDL_PathType type, unsigned int* flags)
+// Brings request to completion, either by running it on the calling thread,
+// or waiting for the worker. Must be called with `tig_file_prefetch_mutex`
+// held.
+void tig_file_prefetch_complete(TigFilePrefetchRequest* request)
 {
-    *flags = 0;
-
-    if (type == SDL_PATHTYPE_DIRECTORY) {
-        *flags |= TIG_FILE_ATTRIBUTE_SUBDIR;
+    while (request->state == TIG_FILE_PREFETCH_QUEUED
+        || request->state == TIG_FILE_PREFETCH_RUNNING) {
+        if (request->state == TIG_FILE_PREFETCH_QUEUED) {
+            tig_file_prefetch_run(request);
+        } else {
+            SDL_WaitCondition(tig_file_prefetch_done_cond, tig_file_prefetch_mutex);
+        }
     }
 }
 
-// 0x530FD0
-void tig_file_list_add(TigFileList* list, TigFileInfo* info)
+// Removes completed request. Must be called on the main thread with
+// `tig_file_prefetch_mutex` held.
+void tig_file_prefetch_discard(TigFilePrefetchRequest* request)
 {
-    if (list->count != 0) {
-        int l = 0;
-        int r = list->count - 1;
-        int m;
-        int cmp;
+    TigFilePrefetchRequest* prev;
 
-        while (l <= r) {
-            m = (l + r) / 2;
-            cmp = SDL_strcasecmp(list->entries[m].path, info->path);
-            if (cmp < 0) {
-                l = m + 1;
-            } else if (cmp > 0) {
-                r = m - 1;
-            } else {
-                // Already added.
-                return;
-            }
+    if (tig_file_prefetch_requests_head == request) {
+        tig_file_prefetch_requests_head = request->next;
+    } else {
+        prev = tig_file_prefetch_requests_head;
+        while (prev->next != request) {
+            prev = prev->next;
         }
+        prev->next = request->next;
+    }
 
-        list->entries = (TigFileInfo*)REALLOC(list->entries, sizeof(TigFileInfo) * (list->count + 1));
-        memmove(&(list->entries[l + 1]), &(list->entries[l]), sizeof(TigFileInfo) * (list->count - l));
-        list->entries[l] = *info;
-        list->count++;
-    } else {
-        list->entries = (TigFileInfo*)MALLOC(sizeof(TigFileInfo));
-        list->entries[0] = *info;
-        list->count++;
+    if (request->contents != NULL) {
+        tig_database_unmap_contents(request->contents);
+        tig_file_prefetch_contents_size -= request->entry->size;
     }
+
+    FREE(request);
+    tig_file_prefetch_requests_count--;
 }
 
-// 0x5310C0
-bool sub_5310C0(const char* filename, const void* owner, size_t size)
+// Cancels queued requests, waits for running ones and drops everything.
+void tig_file_prefetch_flush(void)
 {
-    FILE* stream;
-    uint8_t file_owner[1024];
+    TigFilePrefetchRequest* request;
 
-    stream = fopen(filename, "rb");
-    if (stream == NULL) {
-        return false;
+    if (tig_file_prefetch_mutex == NULL || tig_file_prefetch_requests_count == 0) {
+        return;
     }
 
-    if (size > 1024) {
-        size = 1024;
-    }
+    SDL_LockMutex(tig_file_prefetch_mutex);
 
-    if (fread(file_owner, size, 1, stream) != 0) {
-        fclose(stream);
-        return false;
+    for (request = tig_file_prefetch_requests_head; request != NULL; request = request->next) {
+        if (request->state == TIG_FILE_PREFETCH_QUEUED) {
+            request->state = TIG_FILE_PREFETCH_FAILED;
+        }
     }
 
-    if (memcmp(owner, file_owner, size) != 0) {
-        fclose(stream);
-        return false;
-    }
+    while (tig_file_prefetch_requests_head != NULL) {
+        request = tig_file_prefetch_requests_head;
+        if (request->state == TIG_FILE_PREFETCH_RUNNING) {
+            SDL_WaitCondition(tig_file_prefetch_done_cond, tig_file_prefetch_mutex);
+            continue;
+        }
 
-    fclose(stream);
+        tig_file_prefetch_discard(request);
+    }
 
-    return true;
+    SDL_UnlockMutex(tig_file_prefetch_mutex);
 }
 
-// 0x531170
-unsigned int tig_file_ignored(const char* path)
+// Returns prefetched contents of `entry` (if any), the caller receives the
+// reference. Requests that are not completed yet are finished first, which is
+// never slower than reading the entry from scratch.
+TigDatabaseMapping* tig_file_prefetch_take(TigDatabase* database, TigDatabaseEntry* entry)
 {
-    if (!fpattern_isvalid(path)) {
-        return 0;
-    }
+    TigFilePrefetchRequest* request;
+    TigDatabaseMapping* contents;
 
-    off_62B2A8 = tig_file_ignore_head;
-    while (off_62B2A8 != NULL) {
-        if (fpattern_matchn(off_62B2A8->path, path)) {
-            return off_62B2A8->flags;
-        }
-        off_62B2A8 = off_62B2A8->next;
+    // Requests are only added on this thread, no need to lock.
+    if (tig_file_prefetch_requests_count == 0) {
+        return NULL;
     }
 
-    return 0;
-}
-
-// 0x5311D0
-bool tig_file_copy_native(const char* src, const char* dst)
-{
-    TigFile* in;
-    TigFile* out;
+    SDL_LockMutex(tig_file_prefetch_mutex);
 
-    if (!tig_file_exists_native(src, NULL)) {
-        return false;
+    request = tig_file_prefetch_requests_head;
+    while (request != NULL
+        && (request->database != database || request->entry != entry)) {
+        request = request->next;
     }
 
-    in = tig_file_fopen_native(src, "rb");
-    if (in == NULL) {
-        return false;
+    if (request == NULL) {
+        SDL_UnlockMutex(tig_file_prefetch_mutex);
+        return NULL;
     }
 
-    out = tig_file_fopen_native(dst, "wb");
-    if (out == NULL) {
-        tig_file_fclose(in);
-        return false;
-    }
+    tig_file_prefetch_complete(request);
 
-    if (!tig_file_copy_internal(out, in)) {
-        tig_file_fclose(out);
-        tig_file_fclose(in);
-        return false;
+    contents = request->contents;
+    if (contents != NULL) {
+        request->contents = NULL;
+        tig_file_prefetch_contents_size -= entry->size;
     }
 
-    tig_file_fclose(out);
-    tig_file_fclose(in);
-    return true;
+    tig_file_prefetch_discard(request);
+
+    SDL_UnlockMutex(tig_file_prefetch_mutex);
+
+    return contents;
 }
 
-// 0x531250
-bool tig_file_copy_internal(TigFile* dst, TigFile* src)
+bool tig_file_map_contents_native(const char* path, TigFileMapping* mapping)
 {
-    unsigned char buffer[1 << 15];
-    unsigned int size;
+    TigFile* stream;
+    int size;
 
-    size = tig_file_filelength(src);
-    if (src == 0) {
+    memset(mapping, 0, sizeof(*mapping));
+
+    stream = tig_file_fopen_native(path, "rb");
+    if (stream == NULL) {
         return false;
     }
 
-    while (size >= sizeof(buffer)) {
-        if (tig_file_fread(buffer, sizeof(buffer), 1, src) != 1) {
-            return false;
-        }
+    size = tig_file_filelength(stream);
+    if (size < 0) {
+        tig_file_fclose(stream);
+        return false;
+    }
 
-        if (tig_file_fwrite(buffer, sizeof(buffer), 1, dst) != 1) {
-            return false;
-        }
+    mapping->size = (size_t)size;
 
-        size -= sizeof(buffer);
+    // Stored archive entries are borrowed right from the archive mapping.
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        mapping->data = tig_database_map_contents(stream->impl.database_file_stream,
+            (TigDatabaseMapping**)&(mapping->database_mapping));
     }
 
-    if (tig_file_fread(buffer, size, 1, src) != 1) {
-        return false;
-    }
+    // Everything else (compressed entries, loose files) has to be read. Note
+    // that compressed entries of mapped archives are inflated in one go
+    // straight from the mapping.
+    if (mapping->data == NULL) {
+        mapping->buffer = MALLOC(mapping->size);
+        if (mapping->size != 0
+            && tig_file_fread(mapping->buffer, mapping->size, 1, stream) != 1) {
+            FREE(mapping->buffer);
+            tig_file_fclose(stream);
+            memset(mapping, 0, sizeof(*mapping));
+            return false;
+        }
 
-    if (tig_file_fwrite(buffer, size, 1, dst) != 1) {
-        return false;
+        mapping->data = mapping->buffer;
     }
 
+    tig_file_fclose(stream);
+
     return true;
 }
 
-// 0x531320
-int tig_file_rmdir_recursively_native(const char* path)
+void tig_file_unmap_contents(TigFileMapping* mapping)
 {
-    char mutable_path[TIG_MAX_PATH];
-    TigFindFileData ffd;
-
-    compat_join_path(mutable_path, sizeof(mutable_path), path, "*.*");
-
-    if (tig_find_first_file(mutable_path, &ffd)) {
-        do {
-            compat_join_path(mutable_path, sizeof(mutable_path), path, ffd.name);
-
-            if (ffd.path_info.type == SDL_PATHTYPE_DIRECTORY) {
-                if (strcmp(ffd.name, ".") != 0
-                    && strcmp(ffd.name, "..") != 0) {
-                    tig_file_rmdir_recursively_native(mutable_path);
-                }
-            } else {
-                SDL_RemovePath(mutable_path);
-            }
-        } while (tig_find_next_file(&ffd));
+    if (mapping->database_mapping != NULL) {
+        tig_database_unmap_contents((TigDatabaseMapping*)mapping->database_mapping);
     }
-    tig_find_close(&ffd);
 
-    if (!SDL_RemovePath(path)) {
-        return -1;
+    if (mapping->buffer != NULL) {
+        FREE(mapping->buffer);
     }
 
-    return 0;
+    memset(mapping, 0, sizeof(*mapping));
 }
 
 static Sint64 tig_file_io_size(void* userdata)
 {
-    TigFile* stream = (TigFile*)userdata;
+    TigFileIo* io = (TigFileIo*)userdata;
 
-    return tig_file_filelength(stream);
+    return tig_file_filelength(io->stream);
 }
 
 static Sint64 tig_file_io_seek(void* userdata, Sint64 offset, SDL_IOWhence whence)
 {
-    TigFile* stream = (TigFile*)userdata;
+    TigFileIo* io = (TigFileIo*)userdata;
     int stdio_whence;
+    Sint64 pos;
 
     if (offset < INT_MIN || offset > INT_MAX) {
         return -1;
     }
 
+    if (io->buffer != NULL) {
+        // Only the logical position is changed, the underlying stream is
+        // repositioned when the buffer has to be refilled.
+        switch (whence) {
+        case SDL_IO_SEEK_SET:
+            pos = offset;
+            break;
+        case SDL_IO_SEEK_CUR:
+            pos = io->pos + offset;
+            break;
+        case SDL_IO_SEEK_END:
+            pos = tig_file_filelength(io->stream) + offset;
+            break;
+        default:
+            SDL_SetError("Unknown value for 'whence'");
+            return -1;
+        }
+
+        // Reject seeking past the end right away, like the underlying
+        // stream does.
+        if (pos < 0 || pos > tig_file_filelength(io->stream)) {
+            return -1;
+        }
+
+        io->pos = pos;
+
+        return io->pos;
+    }
+
     switch (whence) {
     case SDL_IO_SEEK_SET:
         stdio_whence = SEEK_SET;
@@ -2022,27 +3717,109 @@ static Sint64 tig_file_io_seek(void* userdata, Sint64 offset, SDL_IOWhence whenc
         return -1;
     }
 
-    if (tig_file_fseek(stream, (int)offset, stdio_whence) != 0) {
+    if (tig_file_fseek(io->stream, (int)offset, stdio_whence) != 0) {
         return -1;
     }
 
-    return tig_file_ftell(stream);
+    return tig_file_ftell(io->stream);
 }
 
-static size_t tig_file_io_read(void* userdata, void* ptr, size_t size, SDL_IOStatus* status)
+// Reads from the underlying stream at `pos`, repositioning it if needed.
+static size_t tig_file_io_read_at(TigFileIo* io, Sint64 pos, void* ptr, size_t size)
 {
-    TigFile* stream = (TigFile*)userdata;
-    size_t bytes = tig_file_fread(ptr, 1, size, stream);
+    size_t bytes;
 
-    (void)status;
+    if (io->stream_pos != pos) {
+        if (tig_file_fseek(io->stream, (int)pos, SEEK_SET) != 0) {
+            io->stream_pos = -1;
+            return 0;
+        }
+        io->stream_pos = pos;
+    }
+
+    bytes = tig_file_fread(ptr, 1, size, io->stream);
+    io->stream_pos += bytes;
 
     return bytes;
 }
 
+static size_t tig_file_io_read(void* userdata, void* ptr, size_t size, SDL_IOStatus* status)
+{
+    TigFileIo* io = (TigFileIo*)userdata;
+    unsigned char* dst = (unsigned char*)ptr;
+    size_t total;
+    size_t offset;
+    size_t chunk;
+    size_t keep;
+    size_t bytes;
+
+    if (io->buffer == NULL) {
+        bytes = tig_file_fread(ptr, 1, size, io->stream);
+        if (bytes < size) {
+            *status = tig_file_ferror(io->stream) ? SDL_IO_STATUS_ERROR : SDL_IO_STATUS_EOF;
+        }
+        return bytes;
+    }
+
+    total = 0;
+    while (total < size) {
+        // Serve from the buffer if possible.
+        if (io->pos >= io->buffer_pos && io->pos < io->buffer_pos + (Sint64)io->buffer_len) {
+            offset = (size_t)(io->pos - io->buffer_pos);
+            chunk = io->buffer_len - offset;
+            if (chunk > size - total) {
+                chunk = size - total;
+            }
+
+            memcpy(dst + total, io->buffer + offset, chunk);
+            total += chunk;
+            io->pos += chunk;
+            continue;
+        }
+
+        // Large reads go straight to the caller.
+        if (size - total >= TIG_FILE_IO_BUFFER_SIZE) {
+            bytes = tig_file_io_read_at(io, io->pos, dst + total, size - total);
+            total += bytes;
+            io->pos += bytes;
+            break;
+        }
+
+        // Refill the buffer. When reading sequentially keep the tail of the
+        // previous contents in front.
+        keep = 0;
+        if (io->pos == io->buffer_pos + (Sint64)io->buffer_len) {
+            keep = io->buffer_len < TIG_FILE_IO_KEEP_SIZE ? io->buffer_len : TIG_FILE_IO_KEEP_SIZE;
+            memmove(io->buffer, io->buffer + io->buffer_len - keep, keep);
+        }
+
+        bytes = tig_file_io_read_at(io, io->pos, io->buffer + keep, TIG_FILE_IO_BUFFER_SIZE - keep);
+        io->buffer_pos = io->pos - (Sint64)keep;
+        io->buffer_len = keep + bytes;
+
+        if (bytes == 0) {
+            break;
+        }
+    }
+
+    if (total < size) {
+        *status = tig_file_ferror(io->stream) ? SDL_IO_STATUS_ERROR : SDL_IO_STATUS_EOF;
+    }
+
+    return total;
+}
+
 static size_t tig_file_io_write(void* userdata, const void* ptr, size_t size, SDL_IOStatus* status)
 {
-    TigFile* stream = (TigFile*)userdata;
-    size_t bytes = tig_file_fwrite(ptr, 1, size, stream);
+    TigFileIo* io = (TigFileIo*)userdata;
+    size_t bytes;
+
+    if (io->buffer != NULL) {
+        *status = SDL_IO_STATUS_ERROR;
+        return 0;
+    }
+
+    bytes = tig_file_fwrite(ptr, 1, size, io->stream);
 
     (void)status;
 
@@ -2051,26 +3828,44 @@ static size_t tig_file_io_write(void* userdata, const void* ptr, size_t size, SD
 
 static bool tig_file_io_close(void* userdata)
 {
-    TigFile* stream = (TigFile*)userdata;
+    TigFileIo* io = (TigFileIo*)userdata;
+    bool success;
 
-    if (tig_file_fclose(stream) != 0) {
-        return false;
+    success = tig_file_fclose(io->stream) == 0;
+
+    if (io->buffer != NULL) {
+        FREE(io->buffer);
     }
+    FREE(io);
 
-    return true;
+    return success;
 }
 
 SDL_IOStream* tig_file_io_open(const char* path, const char* mode)
 {
     TigFile* stream;
+    TigFileIo* io;
     SDL_IOStreamInterface iface;
-    SDL_IOStream* io;
+    SDL_IOStream* sdl_io;
 
     stream = tig_file_fopen(path, mode);
     if (stream == NULL) {
         return NULL;
     }
 
+    io = (TigFileIo*)MALLOC(sizeof(*io));
+    io->stream = stream;
+    io->buffer = NULL;
+    io->buffer_len = 0;
+    io->buffer_pos = 0;
+    io->stream_pos = 0;
+    io->pos = 0;
+
+    // Buffer read-only streams, see `TigFileIo`.
+    if (mode[0] == 'r' && strchr(mode, '+') == NULL) {
+        io->buffer = (unsigned char*)MALLOC(TIG_FILE_IO_BUFFER_SIZE);
+    }
+
     SDL_INIT_INTERFACE(&iface);
     iface.size = tig_file_io_size;
     iface.seek = tig_file_io_seek;
@@ -2078,12 +3873,13 @@ SDL_IOStream* tig_file_io_open(const char* path, const char* mode)
     iface.write = tig_file_io_write;
     iface.close = tig_file_io_close;
 
-    io = SDL_OpenIO(&iface, stream);
-    if (io == NULL) {
+    sdl_io = SDL_OpenIO(&iface, io);
+    if (sdl_io == NULL) {
+        tig_file_io_close(io);
         return NULL;
     }
 
-    return io;
+    return sdl_io;
 }
 
 bool tig_file_mkdir(const char* path)
@@ -2173,6 +3969,22 @@ bool tig_file_unarchive(const char* src, const char* dst)
     return tig_file_unarchive_native(native_src, native_dst);
 }
 
+bool tig_file_unarchive_sync(const char* src, const char* dst)
+{
+    char native_src[TIG_MAX_PATH];
+    char native_dst[TIG_MAX_PATH];
+
+    strcpy(native_src, src);
+    compat_windows_path_to_native(native_src);
+    compat_resolve_path(native_src);
+
+    strcpy(native_dst, dst);
+    compat_windows_path_to_native(native_dst);
+    compat_resolve_path(native_dst);
+
+    return tig_file_unarchive_sync_native(native_src, native_dst);
+}
+
 bool tig_file_repository_add(const char* path)
 {
     char native_path[TIG_MAX_PATH];
@@ -2334,3 +4146,49 @@ bool tig_file_copy(const char* src, const char* dst)
 
     return tig_file_copy_native(native_src, native_dst);
 }
+
+bool tig_file_map_contents(const char* path, TigFileMapping* mapping)
+{
+    char native_path[TIG_MAX_PATH];
+
+    if (path[0] == '\0') {
+        memset(mapping, 0, sizeof(*mapping));
+        return false;
+    }
+
+    strcpy(native_path, path);
+    compat_windows_path_to_native(native_path);
+    compat_resolve_path(native_path);
+
+    return tig_file_map_contents_native(native_path, mapping);
+}
+
+bool tig_file_locate(const char* path, TigFileLocation* location)
+{
+    char native_path[TIG_MAX_PATH];
+
+    if (path[0] == '\0') {
+        return false;
+    }
+
+    strcpy(native_path, path);
+    compat_windows_path_to_native(native_path);
+    compat_resolve_path(native_path);
+
+    return tig_file_locate_native(native_path, location);
+}
+
+unsigned int tig_file_prefetch(const char* path, int priority)
+{
+    char native_path[TIG_MAX_PATH];
+
+    if (path[0] == '\0') {
+        return 0;
+    }
+
+    strcpy(native_path, path);
+    compat_windows_path_to_native(native_path);
+    compat_resolve_path(native_path);
+
+    return tig_file_prefetch_native(native_path, priority);
+}
@@ -3,8 +3,18 @@
 // The FILECACHE module provides `TigFileCache` object used to cache files
 // loaded from FILE module.
 //
-// Implements a least-recently-used cache. The maximum number of files and
-// maximum the cache can hold is provided during creation.
+// Implements a least-recently-used cache. The maximum size of contents the
+// cache can hold is provided during creation. Files are looked up by path via
+// hash table. Unused files are kept in LRU order and evicted from the least
+// recently released one whenever the cache runs out of bytes. The number of
+// files is not limited, the table of items grows as needed (in blocks which
+// never move, so acquired entries stay valid).
+//
+// Files larger than stream size (see `tig_file_cache_set_stream_size`) are not
+// loaded at all. Their entries are marked as `streamed` and have no `data`,
+// the caller is expected to read them on demand with
+// `tig_file_cache_entry_open_io`. Such entries don't count towards cache size,
+// so that big files cannot push out a bunch of small frequently used ones.
 //
 // NOTES
 //
@@ -21,6 +31,9 @@
 // (see SOUND subsystem). This is different from Fallouts where `Cache` was also
 // used for art files. In TIG the ART subsystem has it's own cache, which is
 // considered implementation detail and have no public API.
+//
+// - The original implementation looked up files with linear scan and evicted
+// random items.
 
 #include "tig/file_cache.h"
 
@@ -29,15 +42,26 @@
 
 #define FOURCC_FILC SDL_FOURCC('C', 'L', 'I', 'F')
 
+#define TIG_FILE_CACHE_NONE -1
+
+#define TIG_FILE_CACHE_BLOCK_SIZE 32
+
+static TigFileCacheItem* tig_file_cache_item(TigFileCache* cache, int index);
+static void tig_file_cache_grow(TigFileCache* cache);
+static void tig_file_cache_rehash(TigFileCache* cache);
 static void tig_file_cache_entry_remove(TigFileCache* cache, TigFileCacheItem* entry);
-static bool tig_file_cache_read_contents_into(const char* path, void** data, int* size);
-static bool tig_file_cache_prepare_item(TigFileCache* cache, TigFileCacheItem* item, const char* path);
-static TigFileCacheItem* sub_538D80(TigFileCache* cache);
-static TigFileCacheItem* sub_538D90(TigFileCache* cache);
-static TigFileCacheItem* sub_538E00(TigFileCache* cache);
+static bool tig_file_cache_read_contents_into(const char* path, TigFileMapping* mapping);
+static bool tig_file_cache_prepare_item(TigFileCache* cache, TigFileCacheItem* item, const char* path, unsigned int hash);
+static TigFileCacheItem* tig_file_cache_take_item(TigFileCache* cache);
 static void tig_file_cache_shrink(TigFileCache* cache, int size);
 static TigFileCacheEntry* tig_file_cache_acquire_internal(TigFileCache* cache, TigFileCacheItem* item);
 static void tig_file_cache_release_internal(TigFileCache* cache, TigFileCacheItem* entry);
+static unsigned int tig_file_cache_hash(const char* path);
+static TigFileCacheItem* tig_file_cache_find(TigFileCache* cache, const char* path, unsigned int hash);
+static void tig_file_cache_hash_insert(TigFileCache* cache, TigFileCacheItem* item);
+static void tig_file_cache_hash_remove(TigFileCache* cache, TigFileCacheItem* item);
+static void tig_file_cache_lru_push(TigFileCache* cache, TigFileCacheItem* item);
+static void tig_file_cache_lru_remove(TigFileCache* cache, TigFileCacheItem* item);
 
 // 0x6364F8
 static int tig_file_cache_hit_count;
@@ -70,32 +94,41 @@ void tig_file_cache_exit(void)
 // 0x538AA0
 void tig_file_cache_flush(TigFileCache* cache)
 {
-    int index;
-
-    for (index = 0; index < cache->capacity; index++) {
-        if (cache->items[index].refcount == 0) {
-            tig_file_cache_entry_remove(cache, &(cache->items[index]));
-        }
+    while (cache->lru_tail != TIG_FILE_CACHE_NONE) {
+        tig_file_cache_entry_remove(cache, tig_file_cache_item(cache, cache->lru_tail));
     }
 }
 
 // 0x538AE0
 void tig_file_cache_entry_remove(TigFileCache* cache, TigFileCacheItem* item)
 {
-    if (item->entry.data != NULL) {
+    int index;
+
+    if (item->entry.data != NULL || item->entry.streamed) {
+        tig_file_cache_hash_remove(cache, item);
+        tig_file_cache_lru_remove(cache, item);
+
         cache->items_count--;
-        cache->bytes -= item->entry.size;
-        tig_file_cache_removed_bytes += item->entry.size;
+        if (!item->entry.streamed) {
+            cache->bytes -= item->entry.size;
+            tig_file_cache_removed_bytes += item->entry.size;
+        }
 
         if (item->entry.path) {
             FREE(item->entry.path);
             item->entry.path = NULL;
         }
 
-        FREE(item->entry.data);
+        // Contents are either borrowed from archive or owned by mapping.
+        tig_file_unmap_contents(&(item->mapping));
         item->entry.data = NULL;
 
+        index = item->entry.index;
         memset(item, 0, sizeof(*item));
+        item->entry.index = index;
+
+        item->next_free = cache->free_head;
+        cache->free_head = index;
     }
 }
 
@@ -106,52 +139,153 @@ TigFileCache* tig_file_cache_create(int capacity, int max_size)
 
     cache = (TigFileCache*)MALLOC(sizeof(*cache));
     cache->signature = FOURCC_FILC;
-    cache->capacity = capacity;
+    cache->capacity = 0;
     cache->max_size = max_size;
-    cache->items = (TigFileCacheItem*)CALLOC(capacity, sizeof(*cache->items));
+    cache->blocks = NULL;
+    cache->blocks_count = 0;
     cache->items_count = 0;
     cache->bytes = 0;
+    cache->stream_size = max_size;
+    cache->buckets = NULL;
+    cache->buckets_count = 0;
+    cache->free_head = TIG_FILE_CACHE_NONE;
+    cache->lru_head = TIG_FILE_CACHE_NONE;
+    cache->lru_tail = TIG_FILE_CACHE_NONE;
+
+    do {
+        tig_file_cache_grow(cache);
+    } while (cache->capacity < capacity);
+
     return cache;
 }
 
 // 0x538BA0
 void tig_file_cache_destroy(TigFileCache* cache)
 {
+    int index;
+
     tig_file_cache_flush(cache);
-    FREE(cache->items);
+
+    for (index = 0; index < cache->blocks_count; index++) {
+        FREE(cache->blocks[index]);
+    }
+
+    FREE(cache->blocks);
+    FREE(cache->buckets);
     FREE(cache);
 }
 
-// 0x538BC0
-bool tig_file_cache_read_contents_into(const char* path, void** data, int* size)
+TigFileCacheItem* tig_file_cache_item(TigFileCache* cache, int index)
 {
-    TigFile* stream;
+    return &(cache->blocks[index / TIG_FILE_CACHE_BLOCK_SIZE][index % TIG_FILE_CACHE_BLOCK_SIZE]);
+}
 
-    stream = tig_file_fopen(path, "rb");
-    if (stream == NULL) {
-        return false;
+// Adds a block of free items.
+void tig_file_cache_grow(TigFileCache* cache)
+{
+    TigFileCacheItem* block;
+    int index;
+
+    block = (TigFileCacheItem*)CALLOC(TIG_FILE_CACHE_BLOCK_SIZE, sizeof(*block));
+    cache->blocks = (TigFileCacheItem**)REALLOC(cache->blocks, sizeof(*cache->blocks) * (cache->blocks_count + 1));
+    cache->blocks[cache->blocks_count++] = block;
+
+    for (index = TIG_FILE_CACHE_BLOCK_SIZE - 1; index >= 0; index--) {
+        block[index].entry.index = cache->capacity + index;
+        block[index].next_free = cache->free_head;
+        cache->free_head = cache->capacity + index;
     }
 
-    *size = tig_file_filelength(stream);
-    *data = MALLOC(*size);
-    tig_file_fread(*data, *size, 1, stream);
-    tig_file_fclose(stream);
+    cache->capacity += TIG_FILE_CACHE_BLOCK_SIZE;
 
-    return true;
+    // Keep hash table at most half full.
+    if (cache->buckets_count < cache->capacity * 2) {
+        tig_file_cache_rehash(cache);
+    }
+}
+
+void tig_file_cache_rehash(TigFileCache* cache)
+{
+    int index;
+    TigFileCacheItem* item;
+
+    if (cache->buckets_count == 0) {
+        cache->buckets_count = 16;
+    }
+
+    while (cache->buckets_count < cache->capacity * 2) {
+        cache->buckets_count *= 2;
+    }
+
+    cache->buckets = (int*)REALLOC(cache->buckets, sizeof(*cache->buckets) * cache->buckets_count);
+    for (index = 0; index < cache->buckets_count; index++) {
+        cache->buckets[index] = TIG_FILE_CACHE_NONE;
+    }
+
+    for (index = 0; index < cache->capacity; index++) {
+        item = tig_file_cache_item(cache, index);
+        if (item->entry.path != NULL) {
+            tig_file_cache_hash_insert(cache, item);
+        }
+    }
+}
+
+void tig_file_cache_set_stream_size(TigFileCache* cache, int size)
+{
+    cache->stream_size = size;
+}
+
+SDL_IOStream* tig_file_cache_entry_open_io(TigFileCacheEntry* entry)
+{
+    if (entry->data != NULL) {
+        return SDL_IOFromConstMem(entry->data, entry->size);
+    }
+
+    if (entry->streamed) {
+        return tig_file_io_open(entry->path, "rb");
+    }
+
+    return NULL;
+}
+
+// 0x538BC0
+bool tig_file_cache_read_contents_into(const char* path, TigFileMapping* mapping)
+{
+    return tig_file_map_contents(path, mapping);
 }
 
 // 0x538C20
-bool tig_file_cache_prepare_item(TigFileCache* cache, TigFileCacheItem* item, const char* path)
+bool tig_file_cache_prepare_item(TigFileCache* cache, TigFileCacheItem* item, const char* path, unsigned int hash)
 {
-    if (!tig_file_cache_read_contents_into(path, &(item->entry.data), &(item->entry.size))) {
+    TigFileInfo info;
+
+    if (!tig_file_exists(path, &info)) {
         return false;
     }
 
+    if (info.size > (size_t)cache->stream_size) {
+        // Big file, leave it where it is.
+        item->entry.data = NULL;
+        item->entry.size = (int)info.size;
+        item->entry.streamed = true;
+    } else {
+        if (!tig_file_cache_read_contents_into(path, &(item->mapping))) {
+            return false;
+        }
+
+        item->entry.data = item->mapping.data;
+        item->entry.size = (int)item->mapping.size;
+        item->entry.streamed = false;
+
+        cache->bytes += item->entry.size;
+    }
+
     item->entry.path = STRDUP(path);
+    item->hash = hash;
 
     cache->items_count++;
-    cache->bytes += item->entry.size;
-    item->entry.index = (int)(item - cache->items);
+
+    tig_file_cache_hash_insert(cache, item);
 
     return true;
 }
@@ -162,41 +296,35 @@ TigFileCacheEntry* tig_file_cache_acquire(TigFileCache* cache, const char* path)
     // 0x6364E8
     static TigFileCacheEntry null_entry;
 
-    int index;
+    unsigned int hash;
     TigFileCacheItem* item;
-    TigFileCacheItem* new_item = NULL;
     TigFileCacheEntry* entry;
 
-    for (index = 0; index < cache->capacity; index++) {
-        item = &(cache->items[index]);
-        if (item->entry.data != NULL) {
-            if (SDL_strcasecmp(item->entry.path, path) == 0) {
-                tig_file_cache_hit_count++;
-                tig_file_cache_hit_bytes += item->entry.size;
-                return tig_file_cache_acquire_internal(cache, item);
-            }
-        } else {
-            if (new_item == NULL) {
-                new_item = item;
-            }
-        }
-    }
+    hash = tig_file_cache_hash(path);
 
-    if (new_item == NULL) {
-        new_item = sub_538D80(cache);
-        if (new_item == NULL) {
-            return &null_entry;
+    item = tig_file_cache_find(cache, path, hash);
+    if (item != NULL) {
+        tig_file_cache_hit_count++;
+        if (!item->entry.streamed) {
+            tig_file_cache_hit_bytes += item->entry.size;
         }
+        return tig_file_cache_acquire_internal(cache, item);
     }
 
-    if (!tig_file_cache_prepare_item(cache, new_item, path)) {
+    item = tig_file_cache_take_item(cache);
+
+    if (!tig_file_cache_prepare_item(cache, item, path, hash)) {
+        item->next_free = cache->free_head;
+        cache->free_head = item->entry.index;
         return &null_entry;
     }
 
     tig_file_cache_miss_count++;
-    tig_file_cache_miss_bytes += new_item->entry.size;
+    if (!item->entry.streamed) {
+        tig_file_cache_miss_bytes += item->entry.size;
+    }
 
-    entry = tig_file_cache_acquire_internal(cache, new_item);
+    entry = tig_file_cache_acquire_internal(cache, item);
 
     if (cache->bytes > cache->max_size) {
         tig_file_cache_shrink(cache, cache->bytes - cache->max_size);
@@ -205,95 +333,150 @@ TigFileCacheEntry* tig_file_cache_acquire(TigFileCache* cache, const char* path)
     return entry;
 }
 
-// 0x538D80
-TigFileCacheItem* sub_538D80(TigFileCache* cache)
+// Returns unused item, growing the table if there are no free items. Files
+// are evicted based on their size only, see `tig_file_cache_shrink`.
+TigFileCacheItem* tig_file_cache_take_item(TigFileCache* cache)
 {
-    return sub_538D90(cache);
+    TigFileCacheItem* item;
+
+    if (cache->free_head == TIG_FILE_CACHE_NONE) {
+        tig_file_cache_grow(cache);
+    }
+
+    item = tig_file_cache_item(cache, cache->free_head);
+    cache->free_head = item->next_free;
+
+    return item;
 }
 
-// 0x538D90
-TigFileCacheItem* sub_538D90(TigFileCache* cache)
+// 0x538E40
+void tig_file_cache_shrink(TigFileCache* cache, int size)
 {
-    int attempt;
-    int index;
-    TigFileCacheItem* entry;
+    tig_file_cache_removed_bytes = 0;
 
-    for (attempt = 0; attempt < 4 * cache->capacity; attempt++) {
-        index = rand() % cache->capacity;
-        entry = &(cache->items[index]);
-        if (entry->entry.data == NULL) {
-            return entry;
-        }
+    while (tig_file_cache_removed_bytes < size
+        && cache->lru_tail != TIG_FILE_CACHE_NONE) {
+        tig_file_cache_entry_remove(cache, tig_file_cache_item(cache, cache->lru_tail));
+    }
+}
 
-        if (entry->refcount == 0) {
-            tig_file_cache_entry_remove(cache, entry);
-            return entry;
-        }
+// 0x538E90
+TigFileCacheEntry* tig_file_cache_acquire_internal(TigFileCache* cache, TigFileCacheItem* item)
+{
+    if (item->refcount == 0) {
+        tig_file_cache_lru_remove(cache, item);
     }
 
-    return sub_538E00(cache);
+    item->refcount++;
+    return &(item->entry);
+}
+
+// 0x538EA0
+void tig_file_cache_release(TigFileCache* cache, TigFileCacheEntry* entry)
+{
+    tig_file_cache_release_internal(cache, tig_file_cache_item(cache, entry->index));
 }
 
-// 0x538E00
-TigFileCacheItem* sub_538E00(TigFileCache* cache)
+// 0x538EC0
+void tig_file_cache_release_internal(TigFileCache* cache, TigFileCacheItem* item)
 {
-    int index;
-    TigFileCacheItem* entry;
+    time(&(item->timestamp));
+    item->refcount--;
 
-    for (index = 0; index < cache->capacity; index++) {
-        entry = &(cache->items[index]);
-        if (entry->entry.data == NULL) {
-            return entry;
-        }
+    if (item->refcount == 0) {
+        tig_file_cache_lru_push(cache, item);
+    }
+}
+
+unsigned int tig_file_cache_hash(const char* path)
+{
+    unsigned int hash = 2166136261u;
 
-        if (entry->refcount == 0) {
-            tig_file_cache_entry_remove(cache, entry);
-            return entry;
+    // Case-insensitive FNV-1a, paths are compared case-insensitively.
+    while (*path != '\0') {
+        hash ^= (unsigned char)SDL_tolower((unsigned char)*path++);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+TigFileCacheItem* tig_file_cache_find(TigFileCache* cache, const char* path, unsigned int hash)
+{
+    int index;
+    TigFileCacheItem* item;
+
+    index = cache->buckets[hash & (cache->buckets_count - 1)];
+    while (index != TIG_FILE_CACHE_NONE) {
+        item = tig_file_cache_item(cache, index);
+        if (item->hash == hash && SDL_strcasecmp(item->entry.path, path) == 0) {
+            return item;
         }
+        index = item->next_hash;
     }
 
     return NULL;
 }
 
-// 0x538E40
-void tig_file_cache_shrink(TigFileCache* cache, int size)
+void tig_file_cache_hash_insert(TigFileCache* cache, TigFileCacheItem* item)
 {
-    int attempt;
+    int* bucket;
 
-    if (size > cache->bytes) {
-        tig_file_cache_flush(cache);
-    } else {
-        tig_file_cache_removed_bytes = 0;
+    bucket = &(cache->buckets[item->hash & (cache->buckets_count - 1)]);
+    item->next_hash = *bucket;
+    *bucket = item->entry.index;
+}
+
+void tig_file_cache_hash_remove(TigFileCache* cache, TigFileCacheItem* item)
+{
+    int* index_ptr;
+    int index;
 
-        for (attempt = 0; attempt < 4 * cache->capacity; attempt++) {
-            sub_538D90(cache);
-            if (tig_file_cache_removed_bytes >= size) {
-                break;
-            }
+    index = item->entry.index;
+    index_ptr = &(cache->buckets[item->hash & (cache->buckets_count - 1)]);
+    while (*index_ptr != TIG_FILE_CACHE_NONE) {
+        if (*index_ptr == index) {
+            *index_ptr = item->next_hash;
+            break;
         }
+        index_ptr = &(tig_file_cache_item(cache, *index_ptr)->next_hash);
     }
 }
 
-// 0x538E90
-TigFileCacheEntry* tig_file_cache_acquire_internal(TigFileCache* cache, TigFileCacheItem* item)
+// Makes the item the most recently used among unreferenced ones.
+void tig_file_cache_lru_push(TigFileCache* cache, TigFileCacheItem* item)
 {
-    (void)cache;
+    int index;
 
-    item->refcount++;
-    return &(item->entry);
+    index = item->entry.index;
+    item->lru_prev = TIG_FILE_CACHE_NONE;
+    item->lru_next = cache->lru_head;
+    if (cache->lru_head != TIG_FILE_CACHE_NONE) {
+        tig_file_cache_item(cache, cache->lru_head)->lru_prev = index;
+    } else {
+        cache->lru_tail = index;
+    }
+    cache->lru_head = index;
+    item->in_lru = true;
 }
 
-// 0x538EA0
-void tig_file_cache_release(TigFileCache* cache, TigFileCacheEntry* entry)
+void tig_file_cache_lru_remove(TigFileCache* cache, TigFileCacheItem* item)
 {
-    tig_file_cache_release_internal(cache, &(cache->items[entry->index]));
-}
+    if (!item->in_lru) {
+        return;
+    }
 
-// 0x538EC0
-void tig_file_cache_release_internal(TigFileCache* cache, TigFileCacheItem* item)
-{
-    (void)cache;
+    if (item->lru_prev != TIG_FILE_CACHE_NONE) {
+        tig_file_cache_item(cache, item->lru_prev)->lru_next = item->lru_next;
+    } else {
+        cache->lru_head = item->lru_next;
+    }
 
-    time(&(item->timestamp));
-    item->refcount--;
+    if (item->lru_next != TIG_FILE_CACHE_NONE) {
+        tig_file_cache_item(cache, item->lru_next)->lru_prev = item->lru_prev;
+    } else {
+        cache->lru_tail = item->lru_prev;
+    }
+
+    item->in_lru = false;
 }
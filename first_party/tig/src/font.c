@@ -8,9 +8,57 @@
 
 #define FONT_STACK_SIZE 20
 
+// Number of entries in the layout cache (power of two).
+#define TIG_FONT_LAYOUT_CACHE_SIZE 256
+
+// Metrics of a single glyph as obtained with `tig_font_glyph_data`.
+typedef struct TigFontGlyph {
+    tig_art_id_t art_id;
+    int width;
+    int height;
+    int dx;
+    int dy;
+} TigFontGlyph;
+
+// Font created with `tig_font_create`, handles point to it.
+//
+// Looking up glyph metrics involves art cache and the frame header, so they are
+// kept in a flat table indexed by character. Entries are filled on first use
+// (`glyph_ready`), failed lookups are not remembered.
+typedef struct TigFontInfo {
+    TigFont font;
+    bool glyph_ready[256];
+    TigFontGlyph glyphs[256];
+} TigFontInfo;
+
+// A line of laid out text as returned by `sub_535C40`.
+typedef struct TigFontLine {
+    int length;
+    int width;
+} TigFontLine;
+
+// Line breaks of `str` written with `font` within `max_width`.
+//
+// `error` denotes that breaking the line following the last one failed (see
+// `sub_535C40`).
+typedef struct TigFontLayout {
+    TigFontInfo* font;
+    unsigned int hash;
+    int max_width;
+    char* str;
+    TigFontLine* lines;
+    int lines_count;
+    int lines_capacity;
+    bool error;
+} TigFontLayout;
+
 static int sub_535850(TigVideoBuffer* video_buffer, const char* str, int length, TigArtBlitInfo* blit_info, bool shadow);
-static int sub_535C40(tig_art_id_t font_art_id, const char* str, int max_width, int* width_ptr);
+static int sub_535C40(TigFontInfo* font, const char* str, int max_width, int* width_ptr);
 static bool tig_font_glyph_data(tig_art_id_t font_art_id, int ch, int* width_ptr, int* height_ptr, int* dx_ptr, int* dy_ptr);
+static const TigFontGlyph* tig_font_glyph(TigFontInfo* font, int ch);
+static unsigned int tig_font_layout_hash(TigFontInfo* font, const char* str, int max_width);
+static const TigFontLayout* tig_font_layout(TigFontInfo* font, const char* str, int max_width);
+static void tig_font_layout_reset(TigFontLayout* layout);
 
 // 0x630CFC
 static int tig_font_stack_index;
@@ -24,6 +72,9 @@ static tig_color_t tig_font_shadow_color;
 // 0x630D54
 static tig_font_handle_t tig_font_default_font;
 
+// Recently laid out strings, indexed by `tig_font_layout_hash`.
+static TigFontLayout tig_font_layouts[TIG_FONT_LAYOUT_CACHE_SIZE];
+
 // 0x5351D0
 int tig_font_init(TigInitInfo* init_info)
 {
@@ -50,18 +101,30 @@ int tig_font_init(TigInitInfo* init_info)
 // 0x5352C0
 void tig_font_exit(void)
 {
+    int index;
+
     tig_font_pop();
     tig_font_destroy(tig_font_default_font);
+
+    for (index = 0; index < TIG_FONT_LAYOUT_CACHE_SIZE; index++) {
+        tig_font_layout_reset(&(tig_font_layouts[index]));
+        if (tig_font_layouts[index].lines != NULL) {
+            FREE(tig_font_layouts[index].lines);
+            tig_font_layouts[index].lines = NULL;
+            tig_font_layouts[index].lines_capacity = 0;
+        }
+    }
 }
 
 // 0x5352E0
 void tig_font_create(TigFont* font_data, tig_font_handle_t* font_handle_ptr)
 {
-    TigFont* copy;
+    TigFontInfo* copy;
     TigArtAnimData art_anim_data;
 
-    copy = (TigFont*)MALLOC(sizeof(TigFont));
-    memcpy(copy, font_data, sizeof(TigFont));
+    copy = (TigFontInfo*)MALLOC(sizeof(TigFontInfo));
+    memcpy(&(copy->font), font_data, sizeof(TigFont));
+    memset(copy->glyph_ready, 0, sizeof(copy->glyph_ready));
 
     if (tig_art_anim_data(font_data->art_id, &art_anim_data) != TIG_OK) {
         // Fatal error - missing font art.
@@ -74,7 +137,16 @@ void tig_font_create(TigFont* font_data, tig_font_handle_t* font_handle_ptr)
 // 0x535330
 void tig_font_destroy(tig_font_handle_t font_handle)
 {
-    FREE((TigFont*)font_handle);
+    int index;
+
+    // Forget layouts of this font, the memory can be reused by another one.
+    for (index = 0; index < TIG_FONT_LAYOUT_CACHE_SIZE; index++) {
+        if (tig_font_layouts[index].font == (TigFontInfo*)font_handle) {
+            tig_font_layout_reset(&(tig_font_layouts[index]));
+        }
+    }
+
+    FREE((TigFontInfo*)font_handle);
 }
 
 // 0x535340
@@ -105,17 +177,15 @@ void tig_font_pop(void)
 // 0x535390
 void tig_font_measure(TigFont* font)
 {
+    TigFontInfo* font_info;
+    const TigFontGlyph* glyph;
+    const TigFontLayout* layout;
     const char* str;
     int width;
     int height;
-    int glyph_width;
     int glyph_height;
-    int glyph_dx;
-    int glyph_dy;
     int pos;
     int lines;
-    int line_length;
-    int line_width;
 
     str = font->str;
     width = font->width;
@@ -129,42 +199,40 @@ void tig_font_measure(TigFont* font)
     height = 0;
 
     if (str != NULL) {
+        font_info = (TigFontInfo*)tig_font_stack[tig_font_stack_index];
         glyph_height = 0;
         lines = 1;
         if (font->width != 0) {
-            if (!tig_font_glyph_data(tig_font_stack[tig_font_stack_index]->art_id, str[0], &glyph_width, &glyph_height, &glyph_dx, &glyph_dy)) {
+            glyph = tig_font_glyph(font_info, str[0]);
+            if (glyph == NULL) {
                 font->height = 0;
                 return;
             }
 
-            pos = 0;
-            for (;;) {
-                line_length = sub_535C40(tig_font_stack[tig_font_stack_index]->art_id, &(str[pos]), font->width, &line_width);
-                if (line_length == -1) {
-                    font->height = 0;
-                    return;
-                }
-
-                pos += line_length;
-                if (str[pos] == '\0') {
-                    break;
-                }
+            glyph_height = glyph->height;
 
-                lines++;
-                pos++;
+            layout = tig_font_layout(font_info, str, font->width);
+            if (layout->error) {
+                font->height = 0;
+                return;
             }
+
+            lines = layout->lines_count;
         } else {
             pos = 0;
             while (str[pos] != '\0') {
-                if (!tig_font_glyph_data(tig_font_stack[tig_font_stack_index]->art_id, str[pos], &glyph_width, &glyph_height, &glyph_dx, &glyph_dy)) {
+                glyph = tig_font_glyph(font_info, str[pos]);
+                if (glyph == NULL) {
                     font->height = 0;
                     return;
                 }
 
+                glyph_height = glyph->height;
+
                 if (str[pos + 1] != '\0') {
-                    width += glyph_dx;
+                    width += glyph->dx;
                 } else {
-                    width += glyph_width;
+                    width += glyph->width;
                 }
 
                 pos++;
@@ -194,13 +262,13 @@ void tig_font_measure(TigFont* font)
 // 0x535570
 int tig_font_write(TigVideoBuffer* video_buffer, const char* str, const TigRect* rect, TigRect* dirty_rect)
 {
+    TigFontInfo* font_info;
+    const TigFontGlyph* glyph;
+    const TigFontLayout* layout;
     TigArtBlitInfo blit_info;
     TigRect dst_rect;
     TigRect src_rect;
-    int glyph_dx;
-    int glyph_dy;
     int glyph_height;
-    int glyph_width;
     int max_width;
     int max_y;
     int min_dx;
@@ -217,6 +285,12 @@ int tig_font_write(TigVideoBuffer* video_buffer, const char* str, const TigRect*
         return TIG_OK;
     }
 
+    font_info = (TigFontInfo*)tig_font_stack[tig_font_stack_index];
+
+    // CE: Line breaks are the same for both passes (and likely for the next
+    // redraw), see `tig_font_layout`.
+    layout = NULL;
+
     if ((tig_font_stack[tig_font_stack_index]->flags & TIG_FONT_SHADOW) != 0) {
         num_passes = 2;
         shadow = true;
@@ -264,25 +338,37 @@ int tig_font_write(TigVideoBuffer* video_buffer, const char* str, const TigRect*
 
         remainder = str;
 
-        if (!tig_font_glyph_data(tig_font_stack[tig_font_stack_index]->art_id, ' ', &glyph_width, &glyph_height, &glyph_dx, &glyph_dy)) {
+        glyph = tig_font_glyph(font_info, ' ');
+        if (glyph == NULL) {
             return TIG_ERR_GENERIC;
         }
 
+        glyph_height = glyph->height;
+
         max_y = rect->y;
         dst_rect_x = dst_rect.x;
 
         if (glyph_height <= rect->height) {
+            int line_index;
             int line_length;
             int line_width;
             int dx;
             int rc;
 
+            if (layout == NULL) {
+                layout = tig_font_layout(font_info, str, rect->width);
+            }
+
+            line_index = 0;
             while (1) {
-                line_length = sub_535C40(tig_font_stack[tig_font_stack_index]->art_id, remainder, rect->width, &line_width);
-                if (line_length == -1) {
+                // Out of lines means the line breaker failed.
+                if (line_index == layout->lines_count) {
                     break;
                 }
 
+                line_length = layout->lines[line_index].length;
+                line_width = layout->lines[line_index].width;
+
                 if ((tig_font_stack[tig_font_stack_index]->flags & TIG_FONT_CENTERED) != 0) {
                     dx = (rect->width - line_width) / 2;
                 } else {
@@ -318,6 +404,7 @@ int tig_font_write(TigVideoBuffer* video_buffer, const char* str, const TigRect*
                 }
 
                 remainder += line_length + 1;
+                line_index++;
                 if (rect->y + rect->height - max_y < glyph_height) {
                     break;
                 }
@@ -345,6 +432,8 @@ int tig_font_write(TigVideoBuffer* video_buffer, const char* str, const TigRect*
 // 0x535850
 int sub_535850(TigVideoBuffer* video_buffer, const char* str, int length, TigArtBlitInfo* blit_info, bool shadow)
 {
+    TigFontInfo* font_info;
+    const TigFontGlyph* glyph;
     tig_art_id_t glyph_art_id;
     int blt_dst_rect_x;
     int blt_dst_rect_y;
@@ -359,6 +448,8 @@ int sub_535850(TigVideoBuffer* video_buffer, const char* str, int length, TigArt
     glyph_dy = 0;
     rc = TIG_OK;
 
+    font_info = (TigFontInfo*)tig_font_stack[tig_font_stack_index];
+
     blt_dst_rect_x = blit_info->dst_rect->x;
     blt_dst_rect_y = blit_info->dst_rect->y;
 
@@ -368,13 +459,17 @@ int sub_535850(TigVideoBuffer* video_buffer, const char* str, int length, TigArt
         }
 
         if (str[pos] != '\n') {
-            glyph_art_id = tig_art_id_frame_set(tig_font_stack[tig_font_stack_index]->art_id,
-                (unsigned char)str[pos] - 31);
-
-            if (!tig_font_glyph_data(glyph_art_id, str[pos], &glyph_width, &glyph_height, &glyph_dx, &glyph_dy)) {
+            glyph = tig_font_glyph(font_info, str[pos]);
+            if (glyph == NULL) {
                 return TIG_ERR_GENERIC;
             }
 
+            glyph_art_id = glyph->art_id;
+            glyph_width = glyph->width;
+            glyph_height = glyph->height;
+            glyph_dx = glyph->dx;
+            glyph_dy = glyph->dy;
+
             if (str[pos] != '\t') {
                 blit_info->art_id = glyph_art_id;
                 blit_info->src_rect->width = glyph_width;
@@ -473,12 +568,9 @@ int sub_535850(TigVideoBuffer* video_buffer, const char* str, int length, TigArt
 }
 
 // 0x535C40
-int sub_535C40(tig_art_id_t font_art_id, const char* str, int max_width, int* width_ptr)
+int sub_535C40(TigFontInfo* font, const char* str, int max_width, int* width_ptr)
 {
-    int glyph_width;
-    int glyph_height;
-    int glyph_dx;
-    int glyph_dy;
+    const TigFontGlyph* glyph;
     int pos;
     int prev;
     int width;
@@ -495,7 +587,8 @@ int sub_535C40(tig_art_id_t font_art_id, const char* str, int max_width, int* wi
             break;
         }
 
-        if (!tig_font_glyph_data(font_art_id, (unsigned char)str[pos], &glyph_width, &glyph_height, &glyph_dx, &glyph_dy)) {
+        glyph = tig_font_glyph(font, (unsigned char)str[pos]);
+        if (glyph == NULL) {
             return -1;
         }
 
@@ -505,13 +598,13 @@ int sub_535C40(tig_art_id_t font_art_id, const char* str, int max_width, int* wi
             *width_ptr = total_width;
         }
 
-        width = str[pos + 1] != '\0' ? glyph_dx : glyph_width;
+        width = str[pos + 1] != '\0' ? glyph->dx : glyph->width;
 
         if (total_width + width > max_width) {
             break;
         }
 
-        total_width += glyph_dx;
+        total_width += glyph->dx;
 
         if (str[pos] == '-') {
             // Found HYPHEN, save it a candidate to be a line break.
@@ -555,3 +648,108 @@ bool tig_font_glyph_data(tig_art_id_t font_art_id, int ch, int* width_ptr, int*
 
     return true;
 }
+
+// Returns metrics of the glyph for `ch`, or `NULL` if the glyph is missing.
+const TigFontGlyph* tig_font_glyph(TigFontInfo* font, int ch)
+{
+    TigFontGlyph* glyph;
+
+    ch = (unsigned char)ch;
+    glyph = &(font->glyphs[ch]);
+
+    if (!font->glyph_ready[ch]) {
+        if (!tig_font_glyph_data(font->font.art_id, ch, &(glyph->width), &(glyph->height), &(glyph->dx), &(glyph->dy))) {
+            return NULL;
+        }
+
+        glyph->art_id = tig_art_id_frame_set(font->font.art_id, ch - 31);
+        font->glyph_ready[ch] = true;
+    }
+
+    return glyph;
+}
+
+unsigned int tig_font_layout_hash(TigFontInfo* font, const char* str, int max_width)
+{
+    unsigned int hash = 2166136261u;
+
+    while (*str != '\0') {
+        hash ^= (unsigned char)*str++;
+        hash *= 16777619u;
+    }
+
+    hash ^= (unsigned int)max_width * 2654435761u;
+    hash ^= (unsigned int)((uintptr_t)font >> 4) * 40503u;
+
+    return hash;
+}
+
+// Returns line breaks of `str` (as produced by `sub_535C40`) from the layout
+// cache, laying it out if needed.
+//
+// The cache is direct-mapped, a string evicts whatever was laid out in its slot
+// before. The returned layout is valid until the next call.
+const TigFontLayout* tig_font_layout(TigFontInfo* font, const char* str, int max_width)
+{
+    TigFontLayout* layout;
+    unsigned int hash;
+    const char* remainder;
+    int line_length;
+    int line_width;
+
+    hash = tig_font_layout_hash(font, str, max_width);
+    layout = &(tig_font_layouts[hash & (TIG_FONT_LAYOUT_CACHE_SIZE - 1)]);
+
+    if (layout->font == font
+        && layout->hash == hash
+        && layout->max_width == max_width
+        && strcmp(layout->str, str) == 0) {
+        return layout;
+    }
+
+    tig_font_layout_reset(layout);
+
+    remainder = str;
+    for (;;) {
+        line_length = sub_535C40(font, remainder, max_width, &line_width);
+        if (line_length == -1) {
+            layout->error = true;
+            break;
+        }
+
+        if (layout->lines_count == layout->lines_capacity) {
+            layout->lines_capacity = layout->lines_capacity != 0 ? layout->lines_capacity * 2 : 8;
+            layout->lines = (TigFontLine*)REALLOC(layout->lines, sizeof(*layout->lines) * layout->lines_capacity);
+        }
+
+        layout->lines[layout->lines_count].length = line_length;
+        layout->lines[layout->lines_count].width = line_width;
+        layout->lines_count++;
+
+        if (remainder[line_length] == '\0') {
+            break;
+        }
+
+        remainder += line_length + 1;
+    }
+
+    layout->font = font;
+    layout->hash = hash;
+    layout->max_width = max_width;
+    layout->str = STRDUP(str);
+
+    return layout;
+}
+
+// Empties the layout cache entry (the lines buffer is kept for reuse).
+void tig_font_layout_reset(TigFontLayout* layout)
+{
+    if (layout->str != NULL) {
+        FREE(layout->str);
+        layout->str = NULL;
+    }
+
+    layout->font = NULL;
+    layout->lines_count = 0;
+    layout->error = false;
+}
@@ -20,9 +20,16 @@ typedef struct TigMemoryBlock {
 // Size of block plus a pair of guards.
 #define OVERHEAD_SIZE (sizeof(TigMemoryBlock) + START_GUARD_SIZE + END_GUARD_SIZE)
 
+// Initial number of buckets in the debug blocks table (must be power of two).
+#define BLOCKS_INITIAL_BUCKETS 1024
+
 static int tig_memory_sort_blocks(const void* va, const void* vb);
 static SDL_NORETURN void tig_memory_fatal_error(const char* format, ...);
 static void tig_memory_validate(TigMemoryBlock* block, const char* file, int line);
+static size_t tig_memory_block_hash(const void* ptr, size_t buckets_count);
+static TigMemoryBlock** tig_memory_block_find(void* ptr);
+static void tig_memory_block_insert(TigMemoryBlock* block);
+static void tig_memory_blocks_rehash(void);
 
 // 0x603DE8
 static size_t tig_memory_max_overhead;
@@ -48,8 +55,10 @@ static TigMemoryOutputFunc tig_memory_output_func;
 // 0x603E04
 static char tig_memory_output_buffer[1024];
 
-// 0x604204
-static TigMemoryBlock* tig_memory_blocks_head;
+// Live blocks keyed by data pointer, chained through `next`.
+static TigMemoryBlock** tig_memory_blocks_buckets;
+static size_t tig_memory_blocks_buckets_count;
+static size_t tig_memory_blocks_count;
 
 // 0x604208
 static bool tig_memory_initialized;
@@ -102,8 +111,8 @@ void* tig_memory_calloc(size_t count, size_t size, const char* file, int line)
 // 0x4FE430
 void tig_memory_free(void* ptr, const char* file, int line)
 {
+    TigMemoryBlock** link;
     TigMemoryBlock* block;
-    TigMemoryBlock* prev;
 
     if (!tig_memory_initialized) {
         tig_memory_init(NULL);
@@ -111,31 +120,24 @@ void tig_memory_free(void* ptr, const char* file, int line)
 
     SDL_LockMutex(tig_memory_mutex);
 
-    block = tig_memory_blocks_head;
-    prev = NULL;
-    while (block != NULL && block->data != ptr) {
-        prev = block;
-        block = block->next;
-    }
-
-    if (block == NULL) {
+    link = tig_memory_block_find(ptr);
+    if (link == NULL) {
         // NOTE: Format is slightly modified for VS Code to recognize file path.
         tig_memory_fatal_error("TIG Memory: Error - unable to locate block to free in %s:%d.",
             file,
             line);
     }
 
+    block = *link;
+
     tig_memory_validate(block, file, line);
 
     tig_memory_current_blocks -= 1;
     tig_memory_current_allocated -= block->size;
     tig_memory_current_overhead -= OVERHEAD_SIZE;
 
-    if (prev != NULL) {
-        prev->next = block->next;
-    } else {
-        tig_memory_blocks_head = block->next;
-    }
+    *link = block->next;
+    tig_memory_blocks_count--;
 
     free(block);
 
@@ -168,8 +170,7 @@ void* tig_memory_alloc(size_t size, const char* file, int line)
     block->size = size;
     block->file = file;
     block->line = line;
-    block->next = tig_memory_blocks_head;
-    tig_memory_blocks_head = block;
+    tig_memory_block_insert(block);
 
     // NOTE: Original code does not use `memset`, but it's a little bit safer
     // when you consider alignment issues.
@@ -200,8 +201,8 @@ void* tig_memory_alloc(size_t size, const char* file, int line)
 // 0x4FE5F0
 void* tig_memory_realloc(void* ptr, size_t size, const char* file, int line)
 {
+    TigMemoryBlock** link;
     TigMemoryBlock* block;
-    TigMemoryBlock* prev;
     size_t old_size;
 
     if (!tig_memory_initialized) {
@@ -214,25 +215,17 @@ void* tig_memory_realloc(void* ptr, size_t size, const char* file, int line)
 
     SDL_LockMutex(tig_memory_mutex);
 
-    block = tig_memory_blocks_head;
-    prev = NULL;
-    while (block != NULL && block->data != ptr) {
-        prev = block;
-        block = block->next;
-    }
-
-    if (block == NULL) {
+    link = tig_memory_block_find(ptr);
+    if (link == NULL) {
         // NOTE: Format is slightly modified for VS Code to recognize file path.
         tig_memory_fatal_error("TIG Memory: Error - unable to locate block to reallocate in %s:%d.",
             file,
             line);
     }
 
-    if (prev != NULL) {
-        prev->next = block->next;
-    } else {
-        tig_memory_blocks_head = block->next;
-    }
+    block = *link;
+    *link = block->next;
+    tig_memory_blocks_count--;
 
     old_size = block->size;
 
@@ -250,8 +243,7 @@ void* tig_memory_realloc(void* ptr, size_t size, const char* file, int line)
     block->size = size;
     block->file = file;
     block->line = line;
-    block->next = tig_memory_blocks_head;
-    tig_memory_blocks_head = block;
+    tig_memory_block_insert(block);
 
     // NOTE: Start guard stays in tact.
     memset((unsigned char*)block->data + size, END_GUARD_BYTE, END_GUARD_SIZE);
@@ -327,46 +319,56 @@ void tig_memory_print_stats(TigMemoryPrintStatsOptions opts)
 
     if ((opts & TIG_MEMORY_STATS_PRINT_ALL_BLOCKS) != 0) {
         TigMemoryBlock* curr;
+        size_t bucket;
 
-        curr = tig_memory_blocks_head;
-        while (curr != NULL) {
-            // NOTE: Format is slightly modified for VS Code to recognize file
-            // path. In addition %08x is replaced with %p to prevent compiler
-            // warning.
-            SDL_snprintf(tig_memory_output_buffer, sizeof(tig_memory_output_buffer),
-                "    %s:%d:  %zu bytes at %p.",
-                curr->file,
-                curr->line,
-                curr->size,
-                curr->data);
-            tig_memory_output_func(tig_memory_output_buffer);
-            curr = curr->next;
+        for (bucket = 0; bucket < tig_memory_blocks_buckets_count; bucket++) {
+            curr = tig_memory_blocks_buckets[bucket];
+            while (curr != NULL) {
+                // NOTE: Format is slightly modified for VS Code to recognize
+                // file path. In addition %08x is replaced with %p to prevent
+                // compiler warning.
+                SDL_snprintf(tig_memory_output_buffer, sizeof(tig_memory_output_buffer),
+                    "    %s:%d:  %zu bytes at %p.",
+                    curr->file,
+                    curr->line,
+                    curr->size,
+                    curr->data);
+                tig_memory_output_func(tig_memory_output_buffer);
+                curr = curr->next;
+            }
         }
-    } else if ((opts & TIG_MEMORY_STATS_PRINT_GROUPED_BLOCKS) != 0) {
+    } else if ((opts & TIG_MEMORY_STATS_PRINT_GROUPED_BLOCKS) != 0
+        && tig_memory_blocks_count != 0) {
         TigMemoryBlock** array;
         TigMemoryBlock* curr;
+        size_t bucket;
         size_t index;
         size_t allocated;
         size_t blocks;
 
-        array = (TigMemoryBlock**)malloc(sizeof(TigMemoryBlock*) * tig_memory_current_blocks);
+        // NOTE: Use the number of blocks in the table rather than
+        // `tig_memory_current_blocks`, which is cleared by
+        // `tig_memory_reset_stats`.
+        array = (TigMemoryBlock**)malloc(sizeof(TigMemoryBlock*) * tig_memory_blocks_count);
 
         index = 0;
-        curr = tig_memory_blocks_head;
-        while (curr != NULL) {
-            array[index++] = curr;
-            curr = curr->next;
+        for (bucket = 0; bucket < tig_memory_blocks_buckets_count; bucket++) {
+            curr = tig_memory_blocks_buckets[bucket];
+            while (curr != NULL) {
+                array[index++] = curr;
+                curr = curr->next;
+            }
         }
 
-        qsort(array, tig_memory_current_blocks, sizeof(blocks), tig_memory_sort_blocks);
+        qsort(array, tig_memory_blocks_count, sizeof(*array), tig_memory_sort_blocks);
 
         allocated = 0;
         blocks = 0;
-        for (index = 0; index < tig_memory_current_blocks; index++) {
+        for (index = 0; index < tig_memory_blocks_count; index++) {
             allocated += array[index]->size;
             blocks++;
 
-            if (index == tig_memory_current_blocks - 1
+            if (index == tig_memory_blocks_count - 1
                 || SDL_strcasecmp(array[index]->file, array[index + 1]->file) != 0
                 || array[index]->line != array[index + 1]->line) {
                 // NOTE: Format is slightly modified for VS Code to recognize
@@ -406,6 +408,7 @@ int tig_memory_sort_blocks(const void* va, const void* vb)
 void tig_memory_validate_all(const char* file, int line)
 {
     TigMemoryBlock* block;
+    size_t bucket;
 
     if (!tig_memory_initialized) {
         tig_memory_init(NULL);
@@ -413,10 +416,12 @@ void tig_memory_validate_all(const char* file, int line)
 
     SDL_LockMutex(tig_memory_mutex);
 
-    block = tig_memory_blocks_head;
-    while (block != NULL) {
-        tig_memory_validate(block, file, line);
-        block = block->next;
+    for (bucket = 0; bucket < tig_memory_blocks_buckets_count; bucket++) {
+        block = tig_memory_blocks_buckets[bucket];
+        while (block != NULL) {
+            tig_memory_validate(block, file, line);
+            block = block->next;
+        }
     }
 
     SDL_UnlockMutex(tig_memory_mutex);
@@ -485,6 +490,84 @@ void tig_memory_validate(TigMemoryBlock* block, const char* file, int line)
     }
 }
 
+size_t tig_memory_block_hash(const void* ptr, size_t buckets_count)
+{
+    return (size_t)(((uintptr_t)ptr >> 4) * 2654435761u) & (buckets_count - 1);
+}
+
+// Returns the link which points to the block with the specified data, or
+// `NULL` if there is no such block.
+TigMemoryBlock** tig_memory_block_find(void* ptr)
+{
+    TigMemoryBlock** link;
+
+    if (tig_memory_blocks_buckets == NULL) {
+        return NULL;
+    }
+
+    link = &(tig_memory_blocks_buckets[tig_memory_block_hash(ptr, tig_memory_blocks_buckets_count)]);
+    while (*link != NULL) {
+        if ((*link)->data == ptr) {
+            return link;
+        }
+        link = &((*link)->next);
+    }
+
+    return NULL;
+}
+
+void tig_memory_block_insert(TigMemoryBlock* block)
+{
+    size_t bucket;
+
+    if (tig_memory_blocks_count >= tig_memory_blocks_buckets_count) {
+        tig_memory_blocks_rehash();
+    }
+
+    bucket = tig_memory_block_hash(block->data, tig_memory_blocks_buckets_count);
+    block->next = tig_memory_blocks_buckets[bucket];
+    tig_memory_blocks_buckets[bucket] = block;
+    tig_memory_blocks_count++;
+}
+
+void tig_memory_blocks_rehash(void)
+{
+    TigMemoryBlock** buckets;
+    TigMemoryBlock* block;
+    size_t buckets_count;
+    size_t bucket;
+    size_t index;
+
+    buckets_count = tig_memory_blocks_buckets_count != 0
+        ? tig_memory_blocks_buckets_count * 2
+        : BLOCKS_INITIAL_BUCKETS;
+
+    buckets = (TigMemoryBlock**)calloc(buckets_count, sizeof(*buckets));
+    if (buckets == NULL) {
+        if (tig_memory_blocks_buckets != NULL) {
+            // Keep using the current table, chains just get longer.
+            return;
+        }
+
+        tig_memory_fatal_error("TIG Memory: Error - unable to allocate blocks table.");
+    }
+
+    for (index = 0; index < tig_memory_blocks_buckets_count; index++) {
+        while (tig_memory_blocks_buckets[index] != NULL) {
+            block = tig_memory_blocks_buckets[index];
+            tig_memory_blocks_buckets[index] = block->next;
+
+            bucket = tig_memory_block_hash(block->data, buckets_count);
+            block->next = buckets[bucket];
+            buckets[bucket] = block;
+        }
+    }
+
+    free(tig_memory_blocks_buckets);
+    tig_memory_blocks_buckets = buckets;
+    tig_memory_blocks_buckets_count = buckets_count;
+}
+
 #ifndef NDEBUG
 
 void tig_memory_stats(TigMemoryStats* stats)
@@ -149,6 +149,21 @@ void tig_message_ping(void)
         case SDL_EVENT_QUIT:
             tig_message_post_quit(0);
             break;
+        case SDL_EVENT_WINDOW_EXPOSED:
+        case SDL_EVENT_WINDOW_RESIZED:
+        case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+        case SDL_EVENT_WINDOW_RESTORED:
+        case SDL_EVENT_WINDOW_DISPLAY_CHANGED:
+            // The screen is only presented when it changes, make sure the
+            // window gets its contents back.
+            tig_video_invalidate();
+            break;
+        case SDL_EVENT_RENDER_TARGETS_RESET:
+        case SDL_EVENT_RENDER_DEVICE_RESET:
+            // The screen texture only receives dirty regions, after a reset
+            // it has to be uploaded in full.
+            tig_video_invalidate_texture();
+            break;
         }
     }
 }
@@ -99,9 +99,14 @@ int tig_sound_init(TigInitInfo* init_info)
 
     tig_sound_set_file_path_resolver(init_info->sound_file_path_resolver);
 
-    // Create a file cache for 20 files, approx. 1 MB total.
+    // Create a file cache for approx. 1 MB of sounds, with room for 20 files
+    // up front.
     tig_sound_cache = tig_file_cache_create(20, 1000000);
 
+    // Don't let occasional long sounds evict short ones which are played all
+    // the time.
+    tig_file_cache_set_stream_size(tig_sound_cache, 256000);
+
     return TIG_OK;
 }
 
@@ -393,6 +398,7 @@ void tig_sound_destroy(tig_sound_handle_t sound_handle)
 int tig_sound_play(tig_sound_handle_t sound_handle, const char* path, int id)
 {
     TigSound* snd;
+    SDL_IOStream* io;
 
     if (!tig_sound_initialized) {
         return TIG_OK;
@@ -407,8 +413,21 @@ int tig_sound_play(tig_sound_handle_t sound_handle, const char* path, int id)
     strcpy(snd->path, path);
     snd->file_cache_entry = tig_file_cache_acquire(tig_sound_cache, path);
 
-    if (snd->file_cache_entry->data != NULL) {
-        snd->audio_handle = AIL_quick_load_mem(snd->file_cache_entry->data, snd->file_cache_entry->size);
+    if (snd->file_cache_entry->streamed) {
+        io = tig_file_cache_entry_open_io(snd->file_cache_entry);
+        if (io == NULL) {
+            tig_file_cache_release(tig_sound_cache, snd->file_cache_entry);
+            snd->active = 0;
+            return TIG_OK;
+        }
+
+        snd->audio_handle = AIL_quick_load_io(io);
+        AIL_quick_set_volume(snd->audio_handle, snd->volume, snd->extra_volume);
+        AIL_quick_play(snd->audio_handle, snd->loops);
+        snd->flags |= TIG_SOUND_MEMORY;
+        snd->id = id;
+    } else if (snd->file_cache_entry->data != NULL) {
+        snd->audio_handle = AIL_quick_load_cached(snd->file_cache_entry->path, snd->file_cache_entry->data, snd->file_cache_entry->size);
         AIL_quick_set_volume(snd->audio_handle, snd->volume, snd->extra_volume);
         AIL_quick_play(snd->audio_handle, snd->loops);
         snd->flags |= TIG_SOUND_MEMORY;
@@ -437,7 +456,7 @@ int tig_sound_play_id(tig_sound_handle_t sound_handle, int id)
 // 0x5334D0
 int tig_sound_play_streamed(tig_sound_handle_t sound_handle, const char* name, int loops, int fade_duration, tig_sound_handle_t prev_sound_handle)
 {
-    char path[TIG_MAX_PATH];
+    SDL_IOStream* io;
     TigSound* snd;
     HDIGDRIVER dig;
     TigSound* prev_snd;
@@ -446,11 +465,16 @@ int tig_sound_play_streamed(tig_sound_handle_t sound_handle, const char* name, i
         return TIG_OK;
     }
 
-    if (!tig_file_extract(name, path)) {
+    if (!sound_handle_is_valid(sound_handle)) {
         return TIG_OK;
     }
 
-    if (!sound_handle_is_valid(sound_handle)) {
+    // CE: Read the file right from the repository instead of extracting it to
+    // the disk first (see `tig_file_extract`), so that starting music or voice
+    // does not write anything. Compressed archive entries are cheap to seek
+    // (e.g. when the track loops).
+    io = tig_file_io_open(name, "rb");
+    if (io == NULL) {
         return TIG_OK;
     }
 
@@ -461,7 +485,7 @@ int tig_sound_play_streamed(tig_sound_handle_t sound_handle, const char* name, i
     AIL_quick_handles(&dig, NULL, NULL);
 
     snd->flags |= TIG_SOUND_STREAMED;
-    snd->audio_stream = AIL_open_stream(dig, path, 0);
+    snd->audio_stream = AIL_open_stream_io(dig, io);
     if (snd->audio_stream == NULL) {
         snd->active = 0;
         return TIG_OK;
@@ -32,6 +32,12 @@ typedef struct TigVideoState {
     SDL_Texture* texture;
     SDL_Surface* surface;
     int fps;
+    TigRect dirty_rect;
+    bool dirty;
+    bool present_pending;
+    Uint64 frame_duration;
+    Uint64 last_present_time;
+    size_t bytes_uploaded;
 } TigVideoState;
 
 typedef struct TigFadeState {
@@ -44,6 +50,7 @@ static void tig_video_window_destroy(void);
 static bool sub_524830(void);
 static int tig_video_screenshot_make_internal(int key);
 static int tig_video_buffer_data_to_bmp(SDL_Surface* surface, TigRect* rect, const char* file_name);
+static void tig_video_invalidate_rect(const TigRect* rect);
 
 // 0x5BF3D8
 static int tig_video_screenshot_key = -1;
@@ -202,6 +209,8 @@ int tig_video_blit(TigVideoBuffer* src_video_buffer, TigRect* src_rect, TigRect*
         tig_video_state.surface,
         &native_dst_rect);
 
+    tig_video_invalidate_rect(&clamped_dst_rect);
+
     return TIG_OK;
 }
 
@@ -232,13 +241,54 @@ int tig_video_fill(const TigRect* rect, tig_color_t color)
         return TIG_ERR_GENERIC;
     }
 
+    tig_video_invalidate_rect(&clamped_rect);
+
     return TIG_OK;
 }
 
 // 0x51F8F0
 int tig_video_flip(void)
 {
-    SDL_UpdateTexture(tig_video_state.texture, NULL, tig_video_state.surface->pixels, tig_video_state.surface->pitch);
+    SDL_Rect native_rect;
+    int bytes_per_pixel;
+    Uint64 now;
+
+    tig_video_state.bytes_uploaded = 0;
+
+    // Upload only the part of the screen that was drawn since the last frame,
+    // the texture keeps the rest.
+    if (tig_video_state.dirty) {
+        bytes_per_pixel = SDL_BYTESPERPIXEL(tig_video_state.surface->format);
+
+        native_rect.x = tig_video_state.dirty_rect.x;
+        native_rect.y = tig_video_state.dirty_rect.y;
+        native_rect.w = tig_video_state.dirty_rect.width;
+        native_rect.h = tig_video_state.dirty_rect.height;
+
+        SDL_UpdateTexture(tig_video_state.texture,
+            &native_rect,
+            (Uint8*)tig_video_state.surface->pixels + native_rect.y * tig_video_state.surface->pitch + native_rect.x * bytes_per_pixel,
+            tig_video_state.surface->pitch);
+
+        tig_video_state.bytes_uploaded = (size_t)native_rect.w * native_rect.h * bytes_per_pixel;
+        tig_video_state.dirty = false;
+        tig_video_state.present_pending = true;
+    }
+
+    // Fade overlay and FPS counter are drawn on top of the texture and can
+    // change every frame.
+    if (!tig_video_state.present_pending
+        && !tig_fade_state.enabled
+        && !tig_video_show_fps) {
+        // Nothing to present, but keep the frame pace which vsync would
+        // otherwise set, callers spin on this function.
+        now = SDL_GetTicksNS();
+        if (now - tig_video_state.last_present_time < tig_video_state.frame_duration) {
+            SDL_DelayNS(tig_video_state.frame_duration - (now - tig_video_state.last_present_time));
+        }
+        tig_video_state.last_present_time = SDL_GetTicksNS();
+        return TIG_OK;
+    }
 
     SDL_RenderClear(tig_video_state.renderer);
     SDL_RenderTexture(tig_video_state.renderer, tig_video_state.texture, NULL, NULL);
@@ -263,9 +313,50 @@ int tig_video_flip(void)
 
     SDL_RenderPresent(tig_video_state.renderer);
 
+    tig_video_state.present_pending = false;
+    tig_video_state.last_present_time = SDL_GetTicksNS();
+
     return TIG_OK;
 }
 
+// Forces the next `tig_video_flip` to present the frame even if nothing has
+// been drawn (the window was exposed, resized, etc.).
+void tig_video_invalidate(void)
+{
+    tig_video_state.present_pending = true;
+}
+
+// Same as `tig_video_invalidate`, but also uploads the whole screen again,
+// for when the renderer has lost texture contents (device or targets reset).
+void tig_video_invalidate_texture(void)
+{
+    tig_video_invalidate_rect(&stru_610388);
+    tig_video_invalidate();
+}
+
+// Returns the number of bytes uploaded to the screen texture by the last
+// `tig_video_flip`.
+size_t tig_video_get_bytes_uploaded(void)
+{
+    return tig_video_state.bytes_uploaded;
+}
+
+// Adds `rect` (clamped to the screen) to the region uploaded by the next
+// `tig_video_flip`.
+void tig_video_invalidate_rect(const TigRect* rect)
+{
+    if (rect->width <= 0 || rect->height <= 0) {
+        return;
+    }
+
+    if (tig_video_state.dirty) {
+        tig_rect_union(&(tig_video_state.dirty_rect), rect, &(tig_video_state.dirty_rect));
+    } else {
+        tig_video_state.dirty_rect = *rect;
+        tig_video_state.dirty = true;
+    }
+}
+
 // 0x51F9E0
 int tig_video_screenshot_set_settings(TigVideoScreenshotSettings* settings)
 {
@@ -964,6 +1055,11 @@ int tig_video_buffer_blit(TigVideoBufferBlitInfo* blit_info)
         int x;
         int y;
 
+        // Read color key settings once, stores to `dst` would otherwise force
+        // reloading them for every pixel.
+        bool color_keyed = (blit_info->src_video_buffer->flags & TIG_VIDEO_BUFFER_COLOR_KEY) != 0;
+        unsigned int color_key = blit_info->src_video_buffer->color_key;
+
         uint32_t* src = (uint32_t*)((uint8_t*)blit_info->src_video_buffer->surface->pixels
             + blit_info->src_video_buffer->surface->pitch * blit_src_rect.y
             + 4 * blit_src_rect.x);
@@ -981,8 +1077,7 @@ int tig_video_buffer_blit(TigVideoBufferBlitInfo* blit_info)
             float b = vert_start_b + hor_step_b * (blit_src_rect.x - blit_info->lerp_rect->x);
 
             for (x = 0; x < blit_dst_rect.width; ++x) {
-                if ((blit_info->src_video_buffer->flags & TIG_VIDEO_BUFFER_COLOR_KEY) == 0
-                    || *src != blit_info->src_video_buffer->color_key) {
+                if (!color_keyed || *src != color_key) {
                     *dst = tig_color_mul(*src, tig_color_make((uint8_t)r, (uint8_t)g, (uint8_t)b));
                 }
 
@@ -1318,6 +1413,17 @@ bool tig_video_window_create(TigInitInfo* init_info)
     stru_610388.width = init_info->width;
     stru_610388.height = init_info->height;
 
+    // Texture contents are undefined until the first upload.
+    tig_video_invalidate_rect(&stru_610388);
+
+    // Pace of `tig_video_flip` when there is nothing to present.
+    const SDL_DisplayMode* display_mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+    if (display_mode != NULL && display_mode->refresh_rate > 0.0f) {
+        tig_video_state.frame_duration = (Uint64)(SDL_NS_PER_SECOND / display_mode->refresh_rate);
+    } else {
+        tig_video_state.frame_duration = SDL_NS_PER_SECOND / 60;
+    }
+
     return true;
 }
 
@@ -16,6 +16,13 @@
 #define TIG_WINDOW_MAX 50
 #define TIG_WINDOW_BUTTON_MAX 200
 
+// Maximum number of disjoint rects in `TigWindowRegion`.
+#define TIG_WINDOW_REGION_MAX 128
+
+// Maximum number of transparent window parts drawn on top of the composited
+// area (when there is no scratch buffer).
+#define TIG_WINDOW_DEFERRED_MAX 20
+
 // The following constants define layout and visual style of modal dialog
 // created by `tig_window_modal_dialog`.
 //
@@ -63,6 +70,13 @@ typedef struct TigWindow {
     /* 035C */ TigWindowMessageFilterFunc message_filter;
 } TigWindow;
 
+// Set of non-overlapping rects in screen coordinates. Fixed size, so that
+// compositing never allocates.
+typedef struct TigWindowRegion {
+    int count;
+    TigRect rects[TIG_WINDOW_REGION_MAX];
+} TigWindowRegion;
+
 static int tig_window_free_index(void);
 static int tig_window_handle_to_index(tig_window_handle_t window_handle);
 static tig_window_handle_t tig_window_index_to_handle(int window_index);
@@ -74,6 +88,10 @@ static void tig_window_modal_dialog_refresh(TigRect* rect);
 static bool tig_window_modal_dialog_create_buttons(int type, tig_window_handle_t window_handle);
 static bool tig_window_modal_dialog_init(void);
 static void tig_window_modal_dialog_exit(void);
+static void tig_window_compose(const TigRect* rect, TigVideoBuffer* dst_video_buffer, int origin_x, int origin_y, int top_window_index);
+static void tig_window_copy_rect(TigVideoBuffer* src_video_buffer, int src_x, int src_y, TigVideoBuffer* dst_video_buffer, int dst_x, int dst_y, const TigRect* rect);
+static void tig_window_region_add(TigWindowRegion* region, const TigRect* rect);
+static void tig_window_region_collapse(TigWindowRegion* region, const TigRect* rect);
 
 // 0x5BED98
 static tig_window_handle_t tig_window_modal_dialog_window_handle = TIG_WINDOW_HANDLE_INVALID;
@@ -109,7 +127,7 @@ static bool tig_window_initialized;
 static int tig_window_num_windows;
 
 // 0x60F12C
-static TigRectListNode* tig_window_dirty_rects;
+static TigWindowRegion tig_window_dirty_region;
 
 // 0x60F130
 static tig_font_handle_t tig_window_modal_dialog_font;
@@ -120,7 +138,7 @@ int tig_window_init(TigInitInfo* init_info)
     int index;
 
     tig_window_num_windows = 0;
-    tig_window_dirty_rects = NULL;
+    tig_window_dirty_region.count = 0;
 
     tig_window_screen_rect.x = 0;
     tig_window_screen_rect.y = 0;
@@ -142,7 +160,6 @@ void tig_window_exit(void)
 {
     int window_index;
     tig_window_handle_t window_handle;
-    TigRectListNode* curr;
 
     for (window_index = 0; window_index < TIG_WINDOW_MAX; window_index++) {
         if ((windows[window_index].usage & TIG_WINDOW_USAGE_FREE) == 0) {
@@ -151,11 +168,7 @@ void tig_window_exit(void)
         }
     }
 
-    while (tig_window_dirty_rects != NULL) {
-        curr = tig_window_dirty_rects;
-        tig_window_dirty_rects = curr->next;
-        tig_rect_node_destroy(curr);
-    }
+    tig_window_dirty_region.count = 0;
 
     tig_window_initialized = false;
 }
@@ -378,29 +391,26 @@ int tig_window_data(tig_window_handle_t window_handle, TigWindowData* window_dat
 int tig_window_display(void)
 {
     int rc;
-    TigRectListNode* node;
+    int index;
     TigMouseState mouse_state;
 
     if (!tig_window_initialized) {
         return TIG_ERR_NOT_INITIALIZED;
     }
 
-    if (tig_window_dirty_rects != NULL) {
+    if (tig_window_dirty_region.count != 0) {
         rc = tig_mouse_get_state(&mouse_state);
         if (rc != TIG_OK) {
             return rc;
         }
 
-        node = tig_window_dirty_rects;
-        while (node != NULL) {
-            tig_window_dirty_rects = node->next;
-
-            sub_51D050(&(node->rect), NULL, 0, 0, TIG_WINDOW_TOP);
-            tig_rect_node_destroy(node);
-
-            node = tig_window_dirty_rects;
+        // Dirty rects never overlap, every pixel is composited once.
+        for (index = 0; index < tig_window_dirty_region.count; index++) {
+            tig_window_compose(&(tig_window_dirty_region.rects[index]), NULL, 0, 0, tig_window_num_windows - 1);
         }
 
+        tig_window_dirty_region.count = 0;
+
         if ((mouse_state.flags & TIG_MOUSE_STATE_HIDDEN) == 0) {
             tig_mouse_display();
         }
@@ -416,177 +426,182 @@ int tig_window_display(void)
 // 0x51D050
 void sub_51D050(TigRect* src_rect, TigVideoBuffer* dst_video_buffer, int dx, int dy, int top_window_index)
 {
-    TigVideoBufferBlitInfo vb_blit_info;
-    TigRectListNode* head;
-    TigRectListNode* node;
-    TigRect dirty_rect;
-    TigRect clips[4];
-    TigRect blt_src_rect;
-    TigRect blt_dst_rect;
-    TigWindow* wins[20];
-    TigRect rects[20];
-    int rc;
-    int v45;
-    int v47;
-    int num_clips;
-    int index;
-    int v38 = 0;
-
-    rc = tig_rect_intersection(src_rect, &tig_window_screen_rect, &dirty_rect);
-    if (rc != TIG_OK) {
-        return;
-    }
+    int origin_x;
+    int origin_y;
 
     if (dst_video_buffer != NULL) {
-        v45 = src_rect->x - dx;
-        v47 = src_rect->y - dy;
+        origin_x = src_rect->x - dx;
+        origin_y = src_rect->y - dy;
     } else {
-        v45 = 0;
-        v47 = 0;
+        origin_x = 0;
+        origin_y = 0;
     }
 
-    head = tig_rect_node_create();
-    if (head == NULL) {
-        return;
+    if (top_window_index == TIG_WINDOW_TOP) {
+        top_window_index = tig_window_num_windows - 1;
     }
 
-    head->rect = dirty_rect;
-    head->next = NULL;
+    tig_window_compose(src_rect, dst_video_buffer, origin_x, origin_y, top_window_index);
+}
+
+// Composites windows at `top_window_index` (in the window stack) and below
+// into `rect` (in screen coordinates) of `dst_video_buffer`, or the screen if
+// it's `NULL`. The screen point (x, y) lands at (x - origin_x, y - origin_y).
+//
+// The region which is not yet covered by opaque windows is tracked as a set of
+// disjoint rects on the stack. Every window is blitted into the parts of the
+// region it covers, which are then cut out of the region, so every pixel is
+// written by exactly one opaque window. What's left is filled with black.
+void tig_window_compose(const TigRect* rect, TigVideoBuffer* dst_video_buffer, int origin_x, int origin_y, int top_window_index)
+{
+    TigWindowRegion region;
+    TigWindow* deferred_wins[TIG_WINDOW_DEFERRED_MAX];
+    TigRect deferred_rects[TIG_WINDOW_DEFERRED_MAX];
+    int deferred_count = 0;
+    TigRect dirty_rect;
+    TigRect clips[4];
+    TigVideoBuffer* src_video_buffer;
+    TigWindow* win;
+    int num_clips;
+    int index;
+    int clip_index;
 
-    if (top_window_index == TIG_WINDOW_TOP) {
-        top_window_index = tig_window_num_windows - 1;
+    if (tig_rect_intersection(rect, &tig_window_screen_rect, &dirty_rect) != TIG_OK) {
+        return;
     }
 
-    while (top_window_index >= 0 && head != NULL) {
-        tig_window_handle_t window_handle = tig_window_stack[top_window_index];
-        unsigned int window_index = tig_window_handle_to_index(window_handle);
-        TigWindow* win = &(windows[window_index]);
+    region.rects[0] = dirty_rect;
+    region.count = 1;
+
+    while (top_window_index >= 0 && region.count != 0) {
+        win = &(windows[tig_window_handle_to_index(tig_window_stack[top_window_index])]);
 
         if ((win->flags & TIG_WINDOW_HIDDEN) == 0) {
-            TigRectListNode* curr = head;
-            TigRectListNode* prev = NULL;
-
-            while (curr != NULL) {
-                rc = tig_rect_intersection(&(curr->rect), &(win->frame), &dirty_rect);
-                if (rc == TIG_OK) {
-                    // TODO: Not sure how to represent it one to one.
-                    bool cont;
-                    TigVideoBuffer* src_video_buffer = win->video_buffer;
-                    if ((win->flags & TIG_WINDOW_TRANSPARENT) == 0) {
-                        cont = true;
-                    } else if ((tig_window_ctx_flags & TIG_INITIALIZE_SCRATCH_BUFFER) != 0) {
-                        sub_51D050(&dirty_rect,
+            index = 0;
+            while (index < region.count) {
+                if (tig_rect_intersection(&(region.rects[index]), &(win->frame), &dirty_rect) != TIG_OK) {
+                    index++;
+                    continue;
+                }
+
+                src_video_buffer = win->video_buffer;
+                if ((win->flags & TIG_WINDOW_TRANSPARENT) != 0) {
+                    if ((tig_window_ctx_flags & TIG_INITIALIZE_SCRATCH_BUFFER) != 0) {
+                        // Assemble whatever is below in the scratch buffer
+                        // and put the window on top of it.
+                        //
+                        // FIX: The original code passes index of the window in
+                        // `windows` rather than in the window stack.
+                        tig_window_compose(&dirty_rect,
                             win->secondary_video_buffer,
-                            dirty_rect.x - win->frame.x,
-                            dirty_rect.y - win->frame.y,
-                            window_index - 1);
+                            win->frame.x,
+                            win->frame.y,
+                            top_window_index - 1);
+                        tig_window_copy_rect(win->video_buffer,
+                            win->frame.x,
+                            win->frame.y,
+                            win->secondary_video_buffer,
+                            win->frame.x,
+                            win->frame.y,
+                            &dirty_rect);
                         src_video_buffer = win->secondary_video_buffer;
-                        cont = true;
-                    } else if (v38 < 20) {
-                        wins[v38] = win;
-                        rects[v38] = dirty_rect;
-                        v38++;
-                        cont = false;
-                    } else {
-                        cont = true;
+                    } else if (deferred_count < TIG_WINDOW_DEFERRED_MAX) {
+                        // Draw it on top of the windows below once they are
+                        // done, the area stays in the region.
+                        deferred_wins[deferred_count] = win;
+                        deferred_rects[deferred_count] = dirty_rect;
+                        deferred_count++;
+                        index++;
+                        continue;
                     }
+                }
 
-                    if (cont) {
-                        blt_src_rect.x = dirty_rect.x - win->frame.x;
-                        blt_src_rect.y = dirty_rect.y - win->frame.y;
-                        blt_src_rect.width = dirty_rect.width;
-                        blt_src_rect.height = dirty_rect.height;
-
-                        if ((win->flags & TIG_WINDOW_TRANSPARENT) != 0
-                            && (tig_window_ctx_flags & TIG_INITIALIZE_SCRATCH_BUFFER) != 0) {
-                            vb_blit_info.flags = 0;
-                            vb_blit_info.src_video_buffer = win->video_buffer;
-                            vb_blit_info.src_rect = &blt_src_rect;
-                            vb_blit_info.dst_video_buffer = win->secondary_video_buffer;
-                            vb_blit_info.dst_rect = &blt_src_rect;
-                            tig_video_buffer_blit(&vb_blit_info);
-                        }
-
-                        blt_dst_rect.x = dirty_rect.x - v45;
-                        blt_dst_rect.y = dirty_rect.y - v47;
-                        blt_dst_rect.width = blt_src_rect.width;
-                        blt_dst_rect.height = blt_src_rect.height;
-
-                        if (dst_video_buffer != NULL) {
-                            vb_blit_info.flags = 0;
-                            vb_blit_info.src_video_buffer = src_video_buffer;
-                            vb_blit_info.src_rect = &blt_src_rect;
-                            vb_blit_info.dst_video_buffer = dst_video_buffer;
-                            vb_blit_info.dst_rect = &blt_dst_rect;
-                            tig_video_buffer_blit(&vb_blit_info);
-                        } else {
-                            tig_video_blit(src_video_buffer, &blt_src_rect, &blt_dst_rect);
-                        }
-
-                        num_clips = tig_rect_clip(&(curr->rect), &(win->frame), clips);
-                        for (index = 0; index < num_clips; index++) {
-                            node = tig_rect_node_create();
-                            if (node == NULL) {
-                                break;
-                            }
-
-                            node->rect = clips[index];
-                            node->next = curr->next;
-                            curr->next = node;
-                        }
-
-                        if (curr == head) {
-                            head = curr->next;
-                            tig_rect_node_destroy(curr);
-                            curr = head;
-                        } else {
-                            prev->next = curr->next;
-                            tig_rect_node_destroy(curr);
-                            curr = prev->next;
-                        }
+                tig_window_copy_rect(src_video_buffer,
+                    win->frame.x,
+                    win->frame.y,
+                    dst_video_buffer,
+                    origin_x,
+                    origin_y,
+                    &dirty_rect);
+
+                // Replace the rect with the parts outside of the window. The
+                // first one takes its slot, the rest are appended (they don't
+                // intersect with this window, so it's safe to visit them).
+                num_clips = tig_rect_clip(&(region.rects[index]), &(win->frame), clips);
+                if (num_clips == 0) {
+                    region.rects[index] = region.rects[--region.count];
+                    continue;
+                }
 
-                        continue;
+                region.rects[index] = clips[0];
+                for (clip_index = 1; clip_index < num_clips; clip_index++) {
+                    if (region.count < TIG_WINDOW_REGION_MAX) {
+                        region.rects[region.count++] = clips[clip_index];
+                    } else {
+                        // Out of room, this part is composited separately.
+                        tig_window_compose(&(clips[clip_index]), dst_video_buffer, origin_x, origin_y, top_window_index - 1);
                     }
                 }
-                prev = curr;
-                curr = curr->next;
+                index++;
             }
         }
 
         top_window_index--;
     }
 
-    while (head != NULL) {
-        node = head;
-        head = head->next;
-        tig_video_fill(&(node->rect), 0);
-        tig_rect_node_destroy(node);
+    // FIX: The original code always fills the screen, even when compositing
+    // into the scratch buffer.
+    for (index = 0; index < region.count; index++) {
+        if (dst_video_buffer != NULL) {
+            dirty_rect = region.rects[index];
+            dirty_rect.x -= origin_x;
+            dirty_rect.y -= origin_y;
+            tig_video_buffer_fill(dst_video_buffer, &dirty_rect, 0);
+        } else {
+            tig_video_fill(&(region.rects[index]), 0);
+        }
     }
 
-    --v38;
-    while (v38 >= 0) {
-        blt_src_rect.x = rects[v38].x - wins[v38]->frame.x;
-        blt_src_rect.y = rects[v38].y - wins[v38]->frame.y;
-        blt_src_rect.width = rects[v38].width;
-        blt_src_rect.height = rects[v38].height;
+    // Transparent windows go bottom to top.
+    while (--deferred_count >= 0) {
+        tig_window_copy_rect(deferred_wins[deferred_count]->video_buffer,
+            deferred_wins[deferred_count]->frame.x,
+            deferred_wins[deferred_count]->frame.y,
+            dst_video_buffer,
+            origin_x,
+            origin_y,
+            &(deferred_rects[deferred_count]));
+    }
+}
 
-        blt_dst_rect.x = rects[v38].x - v45;
-        blt_dst_rect.y = rects[v38].y - v47;
-        blt_dst_rect.width = rects[v38].width;
-        blt_dst_rect.height = rects[v38].height;
+// Copies `rect` (in screen coordinates) from `src_video_buffer` placed at
+// (`src_x`, `src_y`) to `dst_video_buffer` placed at (`dst_x`, `dst_y`), or
+// the screen if it's `NULL`.
+void tig_window_copy_rect(TigVideoBuffer* src_video_buffer, int src_x, int src_y, TigVideoBuffer* dst_video_buffer, int dst_x, int dst_y, const TigRect* rect)
+{
+    TigVideoBufferBlitInfo vb_blit_info;
+    TigRect blt_src_rect;
+    TigRect blt_dst_rect;
 
-        if (dst_video_buffer != NULL) {
-            vb_blit_info.flags = 0;
-            vb_blit_info.src_video_buffer = wins[v38]->video_buffer;
-            vb_blit_info.dst_video_buffer = dst_video_buffer;
-            vb_blit_info.src_rect = &blt_src_rect;
-            vb_blit_info.dst_rect = &blt_dst_rect;
-            tig_video_buffer_blit(&vb_blit_info);
-        } else {
-            tig_video_blit(wins[v38]->video_buffer, &blt_src_rect, &blt_dst_rect);
-        }
+    blt_src_rect.x = rect->x - src_x;
+    blt_src_rect.y = rect->y - src_y;
+    blt_src_rect.width = rect->width;
+    blt_src_rect.height = rect->height;
 
-        v38--;
+    blt_dst_rect.x = rect->x - dst_x;
+    blt_dst_rect.y = rect->y - dst_y;
+    blt_dst_rect.width = rect->width;
+    blt_dst_rect.height = rect->height;
+
+    if (dst_video_buffer != NULL) {
+        vb_blit_info.flags = 0;
+        vb_blit_info.src_video_buffer = src_video_buffer;
+        vb_blit_info.src_rect = &blt_src_rect;
+        vb_blit_info.dst_video_buffer = dst_video_buffer;
+        vb_blit_info.dst_rect = &blt_dst_rect;
+        tig_video_buffer_blit(&vb_blit_info);
+    } else {
+        tig_video_blit(src_video_buffer, &blt_src_rect, &blt_dst_rect);
     }
 }
 
@@ -1231,7 +1246,6 @@ bool pop_window_stack(tig_window_handle_t window_handle)
 void tig_window_invalidate_rect(TigRect* rect)
 {
     TigRect dirty_rect;
-    TigRectListNode* node;
 
     if (!tig_window_initialized) {
         return;
@@ -1246,18 +1260,95 @@ void tig_window_invalidate_rect(TigRect* rect)
         dirty_rect = tig_window_screen_rect;
     }
 
-    if (tig_window_dirty_rects != NULL) {
-        node = tig_rect_node_create();
-        node->rect = dirty_rect;
-        node->next = tig_window_dirty_rects;
-        tig_window_dirty_rects = node;
-    } else {
-        tig_window_dirty_rects = tig_rect_node_create();
-        if (tig_window_dirty_rects != NULL) {
-            tig_window_dirty_rects->rect = dirty_rect;
-            tig_window_dirty_rects->next = NULL;
+    tig_window_region_add(&tig_window_dirty_region, &dirty_rect);
+}
+
+// Adds `rect` to the region keeping the rects disjoint.
+void tig_window_region_add(TigWindowRegion* region, const TigRect* rect)
+{
+    TigWindowRegion pieces;
+    TigRect clips[4];
+    TigRect tmp;
+    int num_clips;
+    int index;
+    int piece_index;
+    int clip_index;
+
+    // Drop rects which are covered by the new one, bail out if the new one is
+    // already covered.
+    index = 0;
+    while (index < region->count) {
+        tmp = region->rects[index];
+        if (rect->x >= tmp.x
+            && rect->y >= tmp.y
+            && rect->x + rect->width <= tmp.x + tmp.width
+            && rect->y + rect->height <= tmp.y + tmp.height) {
+            return;
+        }
+
+        if (tmp.x >= rect->x
+            && tmp.y >= rect->y
+            && tmp.x + tmp.width <= rect->x + rect->width
+            && tmp.y + tmp.height <= rect->y + rect->height) {
+            region->rects[index] = region->rects[--region->count];
+        } else {
+            index++;
+        }
+    }
+
+    // Cut the parts which are already in the region.
+    pieces.rects[0] = *rect;
+    pieces.count = 1;
+
+    for (index = 0; index < region->count; index++) {
+        piece_index = 0;
+        while (piece_index < pieces.count) {
+            if (tig_rect_intersection(&(pieces.rects[piece_index]), &(region->rects[index]), &tmp) != TIG_OK) {
+                piece_index++;
+                continue;
+            }
+
+            num_clips = tig_rect_clip(&(pieces.rects[piece_index]), &(region->rects[index]), clips);
+            if (num_clips == 0) {
+                pieces.rects[piece_index] = pieces.rects[--pieces.count];
+                continue;
+            }
+
+            pieces.rects[piece_index] = clips[0];
+            for (clip_index = 1; clip_index < num_clips; clip_index++) {
+                if (pieces.count == TIG_WINDOW_REGION_MAX) {
+                    tig_window_region_collapse(region, rect);
+                    return;
+                }
+                pieces.rects[pieces.count++] = clips[clip_index];
+            }
+            piece_index++;
         }
     }
+
+    if (region->count + pieces.count > TIG_WINDOW_REGION_MAX) {
+        tig_window_region_collapse(region, rect);
+        return;
+    }
+
+    for (piece_index = 0; piece_index < pieces.count; piece_index++) {
+        region->rects[region->count++] = pieces.rects[piece_index];
+    }
+}
+
+// Replaces the region with a single rect bounding it and `rect`.
+void tig_window_region_collapse(TigWindowRegion* region, const TigRect* rect)
+{
+    TigRect bounds;
+    int index;
+
+    bounds = *rect;
+    for (index = 0; index < region->count; index++) {
+        tig_rect_union(&bounds, &(region->rects[index]), &bounds);
+    }
+
+    region->rects[0] = bounds;
+    region->count = 1;
 }
 
 // 0x51E530
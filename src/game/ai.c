@@ -3061,7 +3061,7 @@ void sub_4AD790(int64_t obj, int a2)
 void ai_timeevent_clear(int64_t obj)
 {
     ai_test_obj = obj;
-    timeevent_clear_one_ex(TIMEEVENT_TYPE_AI, ai_timeevent_check);
+    timeevent_clear_one_obj_ex(TIMEEVENT_TYPE_AI, obj, ai_timeevent_check);
 }
 
 // 0x4AD800
@@ -5613,8 +5613,10 @@ bool sub_427110(AnimRunInfo* run_info, int64_t obj, int64_t loc)
     tig_art_id_t art_id;
     int rot;
     int64_t adjacent_loc;
-    ObjectList objects;
-    ObjectNode* node;
+    ObjectArray objects;
+    int64_t storage[OBJECT_ARRAY_STORAGE_SIZE];
+    int index;
+    bool spotted;
 
     art_id = obj_field_int32_get(obj, OBJ_F_CURRENT_AID);
 
@@ -5633,16 +5635,15 @@ bool sub_427110(AnimRunInfo* run_info, int64_t obj, int64_t loc)
     }
 
     if (run_info->path.curr > run_info->path.max - 2) {
-        object_list_location(adjacent_loc, OBJ_TM_CRITTER, &objects);
-        node = objects.head;
-        while (node != NULL) {
-            if (!critter_is_dead(node->obj)) {
-                run_info->cur_stack_data->params[AGDATA_SCRATCH_OBJ].obj = node->obj;
+        object_array_init(&objects, storage, SDL_arraysize(storage));
+        object_array_location(adjacent_loc, OBJ_TM_CRITTER, &objects);
+        for (index = 0; index < objects.cnt; index++) {
+            if (!critter_is_dead(objects.objs[index])) {
+                run_info->cur_stack_data->params[AGDATA_SCRATCH_OBJ].obj = objects.objs[index];
                 break;
             }
-            node = node->next;
         }
-        object_list_destroy(&objects);
+        object_array_destroy(&objects);
     }
 
     if ((run_info->flags & 0x400) != 0
@@ -5651,18 +5652,19 @@ bool sub_427110(AnimRunInfo* run_info, int64_t obj, int64_t loc)
     }
 
     if (run_info->path.curr < run_info->path.max) {
-        object_list_location(adjacent_loc, OBJ_TM_TRAP, &objects);
-        node = objects.head;
-        while (node != NULL) {
-            if (!trap_is_spotted(obj, node->obj)
-                && trap_attempt_spot(obj, node->obj)) {
+        object_array_init(&objects, storage, SDL_arraysize(storage));
+        object_array_location(adjacent_loc, OBJ_TM_TRAP, &objects);
+        spotted = false;
+        for (index = 0; index < objects.cnt; index++) {
+            if (!trap_is_spotted(obj, objects.objs[index])
+                && trap_attempt_spot(obj, objects.objs[index])) {
+                spotted = true;
                 break;
             }
-            node = node->next;
         }
-        object_list_destroy(&objects);
+        object_array_destroy(&objects);
 
-        if (node != NULL) {
+        if (spotted) {
             return true;
         }
     }
@@ -1391,7 +1391,7 @@ bool critter_fatigue_timeevent_schedule(int64_t obj, int type, int delay)
     // Check for existing event to avoid duplicates.
     critter_test_obj = obj;
     critter_test_fatigue_type = type;
-    if (timeevent_any(TIMEEVENT_TYPE_FATIGUE, fatigue_timeevent_check)) {
+    if (timeevent_any_obj(TIMEEVENT_TYPE_FATIGUE, obj, fatigue_timeevent_check)) {
         return true;
     }
 
@@ -1513,7 +1513,7 @@ bool critter_resting_timeevent_schedule(int64_t obj)
 
     // Check for existing event.
     critter_test_obj = obj;
-    if (timeevent_any(TIMEEVENT_TYPE_RESTING, resting_timeevent_check)) {
+    if (timeevent_any_obj(TIMEEVENT_TYPE_RESTING, obj, resting_timeevent_check)) {
         return true;
     }
 
@@ -1594,7 +1594,7 @@ bool critter_decay_timeevent_schedule(int64_t obj)
 void critter_decay_timeevent_cancel(int64_t obj)
 {
     critter_decay_test_obj = obj;
-    timeevent_clear_one_ex(TIMEEVENT_TYPE_DECAY_DEAD_BODIE, decay_timeevent_check);
+    timeevent_clear_one_obj_ex(TIMEEVENT_TYPE_DECAY_DEAD_BODIE, obj, decay_timeevent_check);
 }
 
 /**
@@ -857,6 +857,8 @@ bool gamelib_draw(void)
             sector_rect_from_loc_rect(&loc_rect, &sector_rect);
         }
 
+        sector_prefetch_view(&loc_rect);
+
         sectors = sector_list_create(&loc_rect);
         draw_info.screen_rect = &gamelib_iso_content_rect_ex;
         draw_info.loc_rect = &loc_rect;
@@ -1090,19 +1092,12 @@ bool gamelib_load(const char* name)
 
     snprintf(path, sizeof(path), "save\\%s", name);
 
-    tig_debug_printf("gamelib_load: begin removing files...");
-    tig_timer_now(&time);
-    if (!tig_file_empty_directory("Save\\Current")) {
-        tig_debug_printf("gamelib_load(): Error clearing folder %s\n", "Save\\Current");
-        in_load = false;
-        return false;
-    }
-    duration = tig_timer_elapsed(time);
-    tig_debug_printf("done.  Time (ms): %d\n", duration);
-
+    // NOTE: Files which are already up to date (typically when reloading the
+    // save which was just written) are left intact, the rest of the folder is
+    // rewritten to match the archive.
     tig_debug_printf("gamelib_load: begin restoring folder archive...");
     tig_timer_now(&time);
-    if (!tig_file_unarchive(path, "Save\\Current")) {
+    if (!tig_file_unarchive_sync(path, "Save\\Current")) {
         tig_debug_printf("gamelib_load(): error restoring archive %s to save\\test\n", path);
         in_load = false;
         return false;
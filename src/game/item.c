@@ -4532,7 +4532,7 @@ bool item_decay(int64_t obj, int ms)
     }
 
     item_decay_test_obj = obj;
-    timeevent_clear_all_ex(TIMEEVENT_TYPE_ITEM_DECAY, item_decay_timeevent_check);
+    timeevent_clear_all_obj_ex(TIMEEVENT_TYPE_ITEM_DECAY, obj, item_decay_timeevent_check);
 
     timeevent.type = TIMEEVENT_TYPE_ITEM_DECAY;
     timeevent.params[0].object_value = obj;
@@ -4549,7 +4549,7 @@ bool item_cancel_decay(int64_t obj)
     }
 
     item_decay_test_obj = obj;
-    timeevent_clear_all_ex(TIMEEVENT_TYPE_ITEM_DECAY, item_decay_timeevent_check);
+    timeevent_clear_all_obj_ex(TIMEEVENT_TYPE_ITEM_DECAY, obj, item_decay_timeevent_check);
 
     return true;
 }
@@ -45,6 +45,20 @@ typedef struct LightSerializedData {
 // Serializeable.
 static_assert(sizeof(LightSerializedData) == 0x30, "wrong size");
 
+// Number of sectors with cached luminance.
+#define LIGHT_LUMINANCE_GRIDS 16
+
+// Luminance of tiles of a sector as returned by `sub_4D9240`. Values are
+// computed on demand, and dropped whenever lights around them change (see
+// `light_invalidate_rect`). Each row of 64 tiles has its own validity mask.
+typedef struct LightLuminanceGrid {
+    bool used;
+    int64_t sector_id;
+    unsigned int timestamp;
+    uint64_t valid[64];
+    tig_color_t values[64 * 64];
+} LightLuminanceGrid;
+
 static bool sub_4D89E0(int64_t loc, int a2, int a3, int a4, tig_color_t* color_ptr);
 static void sub_4D9310(LightCreateInfo* create_info, Light** light_ptr);
 static void sub_4D93B0(Light* light);
@@ -75,6 +89,8 @@ static bool sub_4DE820(TimeEvent* timeevent);
 static void sub_4DE870(LightCreateInfo* create_info, Light** light_ptr);
 static void light_render_internal(GameDrawInfo* draw_info);
 static void sub_4DF1D0(TigRect* rect);
+static LightLuminanceGrid* light_luminance_grid(int64_t sector_id);
+static void light_luminance_invalidate(TigRect* rect);
 
 // 0x5B9044
 static int dword_5B9044[] = {
@@ -187,6 +203,9 @@ static int dword_603418;
 // 0x60341C
 static int dword_60341C;
 
+static LightLuminanceGrid* light_luminance_grids;
+static unsigned int light_luminance_timestamp;
+
 // 0x4D7F30
 bool light_init(GameInitInfo* init_info)
 {
@@ -233,6 +252,8 @@ bool light_init(GameInitInfo* init_info)
     sub_5022B0(sub_4DE0B0);
     sub_5022D0();
 
+    light_luminance_grids = (LightLuminanceGrid*)CALLOC(LIGHT_LUMINANCE_GRIDS, sizeof(*light_luminance_grids));
+
     return true;
 }
 
@@ -246,6 +267,7 @@ void light_exit(void)
     light_iso_window_invalidate_rect = NULL;
     sub_4F8340();
     FREE(dword_602E58);
+    FREE(light_luminance_grids);
 }
 
 // 0x4D8160
@@ -264,6 +286,14 @@ void light_resize(GameResizeInfo* resize_info)
 void light_update_view(ViewOptions* view_options)
 {
     light_view_options = *view_options;
+
+    // Light art is sampled in screen space, which depends on the view.
+    light_luminance_invalidate(NULL);
+}
+
+void light_map_close(void)
+{
+    light_luminance_invalidate(NULL);
 }
 
 // 0x4D81F0
@@ -365,6 +395,10 @@ void light_set_colors(tig_color_t indoor_color, tig_color_t outdoor_color)
     light_outdoor_color = outdoor_color;
     light_ambient_palettes_init();
 
+    // Cached luminance includes ambient colors, it's stale regardless of
+    // whether lighting is enabled.
+    light_luminance_invalidate(NULL);
+
     if (light_enabled) {
         if (!light_hardware_accelerated) {
             sub_5022D0();
@@ -533,13 +567,37 @@ bool sub_4D89E0(int64_t loc, int offset_x, int offset_y, int a4, tig_color_t* co
 tig_color_t sub_4D9240(int64_t loc, int offset_x, int offset_y)
 {
     tig_color_t color;
+    LightLuminanceGrid* grid = NULL;
+    int x;
+    int y;
+
+    // Only tile centers are cached. Editor is excluded since it changes tiles
+    // (which decide between indoor and outdoor ambient color) on the fly.
+    if (offset_x == 0 && offset_y == 0 && !light_editor) {
+        grid = light_luminance_grid(sector_id_from_loc(loc));
+        x = (int)(LOCATION_GET_X(loc) & 63);
+        y = (int)(LOCATION_GET_Y(loc) & 63);
+        if ((grid->valid[y] & (1ULL << x)) != 0) {
+            return grid->values[y * 64 + x];
+        }
+    }
 
     if (!sub_4D89E0(loc, offset_x, offset_y, true, &color)) {
         color = tig_color_make(255, 255, 255);
+
+        // The location is too far from the view to be measured.
+        grid = NULL;
     }
 
     // TODO: Probably wrong, might return uint8_t, check.
-    return tig_color_rgb_to_grayscale(color);
+    color = tig_color_rgb_to_grayscale(color);
+
+    if (grid != NULL) {
+        grid->values[y * 64 + x] = color;
+        grid->valid[y] |= 1ULL << x;
+    }
+
+    return color;
 }
 
 // 0x4D9310
@@ -2534,6 +2592,8 @@ void light_invalidate_rect(TigRect* rect, bool invalidate_objects)
 {
     TigRect dirty_rect;
 
+    light_luminance_invalidate(rect);
+
     if (rect != NULL) {
         dirty_rect = *rect;
     } else {
@@ -2550,3 +2610,109 @@ void light_invalidate_rect(TigRect* rect, bool invalidate_objects)
         object_invalidate_rect(&dirty_rect);
     }
 }
+
+// Returns luminance grid of the specified sector, recycling the least recently
+// used one when the sector has none.
+LightLuminanceGrid* light_luminance_grid(int64_t sector_id)
+{
+    int index;
+    int oldest = 0;
+    LightLuminanceGrid* grid;
+
+    light_luminance_timestamp++;
+
+    for (index = 0; index < LIGHT_LUMINANCE_GRIDS; index++) {
+        grid = &(light_luminance_grids[index]);
+        if (grid->used && grid->sector_id == sector_id) {
+            grid->timestamp = light_luminance_timestamp;
+            return grid;
+        }
+
+        if (!grid->used
+            || (light_luminance_grids[oldest].used && grid->timestamp < light_luminance_grids[oldest].timestamp)) {
+            oldest = index;
+        }
+    }
+
+    grid = &(light_luminance_grids[oldest]);
+    grid->used = true;
+    grid->sector_id = sector_id;
+    grid->timestamp = light_luminance_timestamp;
+    memset(grid->valid, 0, sizeof(grid->valid));
+
+    return grid;
+}
+
+// Drops cached luminance of tiles affected by the change of lights in the
+// specified screen rect, or everything when `rect` is `NULL`.
+void light_luminance_invalidate(TigRect* rect)
+{
+    TigRect expanded_rect;
+    LocRect loc_rect;
+    int index;
+    LightLuminanceGrid* grid;
+    int64_t min_x;
+    int64_t min_y;
+    int64_t max_x;
+    int64_t max_y;
+    int64_t y;
+    uint64_t mask;
+
+    if (light_luminance_grids == NULL) {
+        return;
+    }
+
+    if (rect != NULL) {
+        // Luminance is sampled at tile centers, grow the rect by a tile to
+        // cover rounding in screen to location conversion.
+        expanded_rect.x = rect->x - 80;
+        expanded_rect.y = rect->y - 40;
+        expanded_rect.width = rect->width + 160;
+        expanded_rect.height = rect->height + 80;
+        if (!location_screen_rect_to_loc_rect(&expanded_rect, &loc_rect)) {
+            rect = NULL;
+        }
+    }
+
+    for (index = 0; index < LIGHT_LUMINANCE_GRIDS; index++) {
+        grid = &(light_luminance_grids[index]);
+        if (!grid->used) {
+            continue;
+        }
+
+        if (rect == NULL) {
+            memset(grid->valid, 0, sizeof(grid->valid));
+            continue;
+        }
+
+        min_x = SECTOR_X(grid->sector_id) * 64;
+        min_y = SECTOR_Y(grid->sector_id) * 64;
+        max_x = min_x + 63;
+        max_y = min_y + 63;
+
+        if (loc_rect.x2 < min_x || loc_rect.x1 > max_x
+            || loc_rect.y2 < min_y || loc_rect.y1 > max_y) {
+            continue;
+        }
+
+        if (loc_rect.x1 > min_x) {
+            min_x = loc_rect.x1;
+        }
+        if (loc_rect.x2 < max_x) {
+            max_x = loc_rect.x2;
+        }
+        if (loc_rect.y1 > min_y) {
+            min_y = loc_rect.y1;
+        }
+        if (loc_rect.y2 < max_y) {
+            max_y = loc_rect.y2;
+        }
+
+        mask = max_x - min_x == 63
+            ? ~0ULL
+            : ((1ULL << (max_x - min_x + 1)) - 1) << (min_x & 63);
+        for (y = min_y; y <= max_y; y++) {
+            grid->valid[y & 63] &= ~mask;
+        }
+    }
+}
@@ -47,6 +47,7 @@ bool light_init(GameInitInfo* init_info);
 void light_exit(void);
 void light_resize(GameResizeInfo* resize_info);
 void light_update_view(ViewOptions* view_options);
+void light_map_close(void);
 void light_toggle(void);
 void light_buffers_lock(void);
 void light_buffers_unlock(void);
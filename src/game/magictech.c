@@ -6591,7 +6591,7 @@ bool magictech_recharge_timeevent_schedule(int64_t item_obj, int mana_cost, bool
     dword_5E760C = sub_45A7F0();
 
     if (add) {
-        if (timeevent_any(TIMEEVENT_TYPE_RECHARGE_MAGIC_ITEM, magictech_recharge_timeevent_add)) {
+        if (timeevent_any_obj(TIMEEVENT_TYPE_RECHARGE_MAGIC_ITEM, item_obj, magictech_recharge_timeevent_add)) {
             return true;
         }
     }
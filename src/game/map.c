@@ -114,7 +114,7 @@ static const char* off_59F058[MAP_TYPE_COUNT] = {
 static MapModule map_modules[MAP_MODULE_COUNT] = {
     { "Scroll", scroll_init, scroll_reset, NULL, NULL, scroll_exit, NULL, scroll_update_view, NULL, NULL, NULL, NULL, scroll_resize },
     { "Location", location_init, NULL, NULL, NULL, location_exit, NULL, location_update_view, NULL, NULL, NULL, NULL, location_resize },
-    { "Light", light_init, NULL, NULL, NULL, light_exit, NULL, light_update_view, NULL, NULL, NULL, NULL, light_resize },
+    { "Light", light_init, NULL, NULL, NULL, light_exit, NULL, light_update_view, NULL, NULL, NULL, light_map_close, light_resize },
     { "Tile", tile_init, NULL, NULL, NULL, tile_exit, NULL, tile_update_view, NULL, NULL, NULL, NULL, tile_resize },
     { "Roof", roof_init, NULL, NULL, NULL, roof_exit, NULL, roof_update_view, NULL, NULL, NULL, NULL, roof_resize },
     { "Effect", effect_init, NULL, effect_mod_load, effect_mod_unload, effect_exit, NULL, NULL, NULL, NULL, NULL, NULL, NULL },
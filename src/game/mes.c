@@ -14,8 +14,43 @@ typedef struct MesFile {
     /* 0110 */ MesFileEntry* entries;
     /* 0114 */ char* data;
     /* 0118 */ size_t size;
+    unsigned int hash;
 } MesFile;
 
+#define MES_CACHE_MAGIC 0x4353454D /* 'MESC' */
+#define MES_CACHE_VERSION 2
+
+/**
+ * Header of the compiled message file.
+ *
+ * The header is followed by the table of `MesCacheEntry` (sorted by number)
+ * and the string pool, so that the whole file can be loaded with a single read
+ * without parsing.
+ */
+typedef struct MesCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t source_size;
+    uint32_t source_checksum;
+    int64_t source_modify_time;
+    int32_t num_entries;
+    uint32_t data_size;
+    char source_path[TIG_MAX_PATH];
+
+    // Identity of the archive entry the source was read from (if any).
+    uint64_t archive_size;
+    int64_t archive_modify_time;
+    uint32_t entry_offset;
+    uint32_t entry_compressed_size;
+    uint32_t entry_flags;
+    char archive_path[TIG_MAX_PATH];
+} MesCacheHeader;
+
+typedef struct MesCacheEntry {
+    int32_t num;
+    uint32_t offset;
+} MesCacheEntry;
+
 static bool find_mes_file(const char* path, int* index_ptr);
 static void mes_load_internal(MesFile* mes_file);
 static bool parse_entry(TigFile* stream, MesFileEntry* mes_file_entry);
@@ -26,6 +61,13 @@ static int consume_next_char(TigFile* stream);
 static int compare_mes_file_entry(const void* a, const void* b);
 static void copy_mes_file_entry(MesFileEntry* dst, MesFileEntry* src, char* str);
 static void check_duplicates(MesFile* mes_file);
+static unsigned int mes_file_hash(const char* path);
+static void mes_file_bucket_insert(int index);
+static void mes_file_rehash(void);
+static bool mes_cache_path(const char* path, char* cache_path);
+static bool mes_cache_checksum(const char* path, uint32_t* checksum_ptr);
+static bool mes_cache_load(MesFile* mes_file, const MesCacheHeader* key);
+static void mes_cache_save(MesFile* mes_file, const MesCacheHeader* key);
 
 /**
  * Current line number during parsing, used for error reporting.
@@ -93,6 +135,18 @@ static int mes_files_capacity;
  */
 static MesFile* mes_files;
 
+/**
+ * Open-addressing index of loaded message files keyed by path (see
+ * `mes_file_hash`), each slot holds index in `mes_files` plus one (zero denotes
+ * an empty slot).
+ */
+static int* mes_files_buckets;
+
+/**
+ * The capacity of the `mes_files_buckets` array (power of two).
+ */
+static int mes_files_buckets_capacity;
+
 /**
  * Loads a message file and assigns a handle for accessing it.
  *
@@ -113,6 +167,7 @@ bool mes_load(const char* path, mes_file_handle_t* mes_file_handle_ptr)
 
     // Initialize new mes file object.
     strcpy(mes_file.path, path);
+    mes_file.hash = mes_file_hash(path);
     mes_file.refcount = 1;
     mes_file.num_entries = 0;
     mes_file.max_entries = 0;
@@ -132,6 +187,7 @@ bool mes_load(const char* path, mes_file_handle_t* mes_file_handle_ptr)
 
     mes_files[index] = mes_file;
     mes_files_length++;
+    mes_file_bucket_insert(index);
 
     *mes_file_handle_ptr = (mes_file_handle_t)index;
 
@@ -320,6 +376,7 @@ bool mes_unload(mes_file_handle_t mes_file_handle)
             FREE(mes_files[mes_file_handle].entries);
             FREE(mes_files[mes_file_handle].data);
             mes_files_length--;
+            mes_file_rehash();
         }
 
         // Free the global array if no open files remain.
@@ -327,6 +384,12 @@ bool mes_unload(mes_file_handle_t mes_file_handle)
             FREE(mes_files);
             mes_files = NULL;
             mes_files_capacity = 0;
+
+            if (mes_files_buckets != NULL) {
+                FREE(mes_files_buckets);
+                mes_files_buckets = NULL;
+                mes_files_buckets_capacity = 0;
+            }
         }
     }
 
@@ -410,27 +473,33 @@ void mes_merge(mes_file_handle_t dst, mes_file_handle_t src)
 bool find_mes_file(const char* path, int* index_ptr)
 {
     int index;
-    int candidate = -1;
-
-    // Iterate through the message files array to find a matching path or a
-    // first free slot.
-    for (index = 0; index < mes_files_capacity; index++) {
-        if (mes_files[index].refcount != 0) {
-            if (SDL_strcasecmp(path, mes_files[index].path) == 0) {
-                *index_ptr = index;
+    unsigned int hash;
+    unsigned int mask;
+    unsigned int bucket;
+    int slot;
+
+    // CE: Look up loaded files through the path index rather than comparing
+    // the path against every slot.
+    if (mes_files_buckets_capacity != 0) {
+        hash = mes_file_hash(path);
+        mask = mes_files_buckets_capacity - 1;
+        bucket = hash & mask;
+        while ((slot = mes_files_buckets[bucket]) != 0) {
+            if (mes_files[slot - 1].hash == hash
+                && SDL_strcasecmp(path, mes_files[slot - 1].path) == 0) {
+                *index_ptr = slot - 1;
                 return true;
             }
-        } else {
-            if (candidate == -1) {
-                candidate = index;
-            }
+            bucket = (bucket + 1) & mask;
         }
     }
 
-    // Use the free slot if found.
-    if (candidate != -1) {
-        *index_ptr = candidate;
-        return false;
+    // Find the first free slot.
+    for (index = 0; index < mes_files_capacity; index++) {
+        if (mes_files[index].refcount == 0) {
+            *index_ptr = index;
+            return false;
+        }
     }
 
     *index_ptr = index;
@@ -444,6 +513,8 @@ bool find_mes_file(const char* path, int* index_ptr)
         mes_files[index++].refcount = 0;
     }
 
+    mes_file_rehash();
+
     return false;
 }
 
@@ -458,6 +529,47 @@ void mes_load_internal(MesFile* mes_file)
     MesFileEntry mes_file_entry;
     char buffer[MAX_STRING];
     int offset;
+    TigFileInfo info;
+    TigFileLocation location;
+    MesCacheHeader key;
+    bool cacheable;
+
+    // CE: Try compiled message file first, it's only valid for the exact
+    // source it was built from.
+    info.modify_time = 0;
+    cacheable = tig_file_exists(mes_file->path, &info);
+    if (cacheable) {
+        memset(&key, 0, sizeof(key));
+        key.magic = MES_CACHE_MAGIC;
+        key.version = MES_CACHE_VERSION;
+        key.source_size = (uint32_t)info.size;
+        key.source_modify_time = (int64_t)info.modify_time;
+
+        // Archive entries have no timestamp, and the same path can come from
+        // another archive of the same size (e.g. after switching modules).
+        // Key them on the archive and the entry within it, which is enough
+        // to tell them apart without reading the contents. The checksum is
+        // only a fallback for sources which cannot be located.
+        if (key.source_modify_time == 0) {
+            if (tig_file_locate(mes_file->path, &location)) {
+                key.archive_size = location.archive_size;
+                key.archive_modify_time = (int64_t)location.archive_modify_time;
+                key.entry_offset = location.offset;
+                key.entry_compressed_size = location.compressed_size;
+                key.entry_flags = location.flags;
+                snprintf(key.archive_path, sizeof(key.archive_path), "%s", location.archive_path);
+            } else if (!mes_cache_checksum(mes_file->path, &(key.source_checksum))) {
+                cacheable = false;
+            }
+        }
+
+        snprintf(key.source_path, sizeof(key.source_path), "%s", mes_file->path);
+
+        if (cacheable && mes_cache_load(mes_file, &key)) {
+            check_duplicates(mes_file);
+            return;
+        }
+    }
 
     stream = mes_file_open(mes_file->path, "rt");
     if (stream == NULL) {
@@ -506,6 +618,10 @@ void mes_load_internal(MesFile* mes_file)
 
     // Check for duplicate entry numbers.
     check_duplicates(mes_file);
+
+    if (cacheable && mes_file->num_entries != 0) {
+        mes_cache_save(mes_file, &key);
+    }
 }
 
 /**
@@ -703,20 +819,15 @@ void copy_mes_file_entry(MesFileEntry* dst, MesFileEntry* src, char* str)
  */
 void check_duplicates(MesFile* mes_file)
 {
-    int index1;
-    int index2;
-
-    // NOTE: It seems the Troika developers were in a hurry when writing this
-    // check. This is a quick-and-dirty O(n^2) algorithm, which may be slow for
-    // large files. Since the entries are guaranteed to be sorted, duplicates
-    // should be adjacent, which is O(n).
-    for (index1 = 0; index1 < mes_file->num_entries; index1++) {
-        for (index2 = 0; index2 < index1; index2++) {
-            if (mes_file->entries[index1].num == mes_file->entries[index2].num) {
-                tig_debug_printf("%s: two lines numbered %d\n",
-                    mes_file->path,
-                    mes_file->entries[index1].num);
-            }
+    int index;
+
+    // CE: Entries are sorted, so duplicates are adjacent. Original code
+    // compares every pair of entries, which is O(n^2).
+    for (index = 1; index < mes_file->num_entries; index++) {
+        if (mes_file->entries[index].num == mes_file->entries[index - 1].num) {
+            tig_debug_printf("%s: two lines numbered %d\n",
+                mes_file->path,
+                mes_file->entries[index].num);
         }
     }
 }
@@ -738,3 +849,265 @@ void mes_stats(void)
         }
     }
 }
+
+/**
+ * Computes case-insensitive hash of the message file path for the path index.
+ */
+unsigned int mes_file_hash(const char* path)
+{
+    unsigned int hash = 2166136261u;
+
+    while (*path != '\0') {
+        hash ^= (unsigned char)SDL_tolower((unsigned char)*path++);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * Adds the loaded message file at `index` to the path index.
+ */
+void mes_file_bucket_insert(int index)
+{
+    unsigned int mask;
+    unsigned int bucket;
+
+    mask = mes_files_buckets_capacity - 1;
+    bucket = mes_files[index].hash & mask;
+    while (mes_files_buckets[bucket] != 0) {
+        bucket = (bucket + 1) & mask;
+    }
+
+    mes_files_buckets[bucket] = index + 1;
+}
+
+/**
+ * Rebuilds the path index from scratch, growing it to keep at most half of
+ * the slots in use.
+ *
+ * Loading and unloading message files is rare compared to lookups, so there
+ * is no need for removing individual entries.
+ */
+void mes_file_rehash(void)
+{
+    int capacity;
+    int index;
+
+    capacity = mes_files_buckets_capacity != 0 ? mes_files_buckets_capacity : 16;
+    while (capacity < mes_files_capacity * 2) {
+        capacity *= 2;
+    }
+
+    if (capacity != mes_files_buckets_capacity) {
+        mes_files_buckets = (int*)REALLOC(mes_files_buckets, sizeof(*mes_files_buckets) * capacity);
+        mes_files_buckets_capacity = capacity;
+    }
+
+    memset(mes_files_buckets, 0, sizeof(*mes_files_buckets) * mes_files_buckets_capacity);
+
+    for (index = 0; index < mes_files_capacity; index++) {
+        if (mes_files[index].refcount != 0) {
+            mes_file_bucket_insert(index);
+        }
+    }
+}
+
+/**
+ * Builds the path of the compiled message file for the given source path.
+ *
+ * All compiled files are kept in a single directory, the source path is
+ * flattened into a file name.
+ *
+ * Returns `false` if the resulting path is too long.
+ */
+bool mes_cache_path(const char* path, char* cache_path)
+{
+    size_t len;
+    char* pch;
+
+    len = strlen(path);
+    if (len + sizeof("cache\\mes\\.bin") > TIG_MAX_PATH) {
+        return false;
+    }
+
+    strcpy(cache_path, "cache\\mes\\");
+    pch = cache_path + strlen(cache_path);
+    while (*path != '\0') {
+        if (*path == '\\' || *path == '/' || *path == ':') {
+            *pch++ = '_';
+        } else {
+            *pch++ = (char)SDL_tolower((unsigned char)*path);
+        }
+        path++;
+    }
+    strcpy(pch, ".bin");
+
+    return true;
+}
+
+/**
+ * Computes checksum (FNV-1a) of the message file contents.
+ */
+bool mes_cache_checksum(const char* path, uint32_t* checksum_ptr)
+{
+    TigFileMapping mapping;
+    const unsigned char* data;
+    size_t index;
+    uint32_t checksum = 2166136261u;
+
+    if (!tig_file_map_contents(path, &mapping)) {
+        return false;
+    }
+
+    data = (const unsigned char*)mapping.data;
+    for (index = 0; index < mapping.size; index++) {
+        checksum ^= data[index];
+        checksum *= 16777619u;
+    }
+
+    tig_file_unmap_contents(&mapping);
+
+    *checksum_ptr = checksum;
+
+    return true;
+}
+
+/**
+ * Loads entries from the compiled message file, provided it was built from the
+ * source described by `key`.
+ *
+ * Returns `false` if the compiled file is missing, outdated, or malformed, in
+ * which case the source has to be parsed.
+ */
+bool mes_cache_load(MesFile* mes_file, const MesCacheHeader* key)
+{
+    char path[TIG_MAX_PATH];
+    TigFileMapping mapping;
+    MesCacheHeader hdr;
+    MesCacheEntry entry;
+    const unsigned char* table;
+    const char* pool;
+    int index;
+
+    if (!mes_cache_path(mes_file->path, path)) {
+        return false;
+    }
+
+    if (!tig_file_map_contents(path, &mapping)) {
+        return false;
+    }
+
+    // NOTE: Contents are not guaranteed to be aligned (the compiled file might
+    // end up in an archive), so everything is copied out.
+    if (mapping.size < sizeof(hdr)) {
+        tig_file_unmap_contents(&mapping);
+        return false;
+    }
+
+    memcpy(&hdr, mapping.data, sizeof(hdr));
+    if (hdr.magic != key->magic
+        || hdr.version != key->version
+        || hdr.source_size != key->source_size
+        || hdr.source_checksum != key->source_checksum
+        || hdr.source_modify_time != key->source_modify_time
+        || hdr.archive_size != key->archive_size
+        || hdr.archive_modify_time != key->archive_modify_time
+        || hdr.entry_offset != key->entry_offset
+        || hdr.entry_compressed_size != key->entry_compressed_size
+        || hdr.entry_flags != key->entry_flags
+        || hdr.num_entries <= 0
+        || hdr.data_size == 0
+        || mapping.size != sizeof(hdr) + sizeof(entry) * (size_t)hdr.num_entries + hdr.data_size
+        || SDL_strncasecmp(hdr.source_path, key->source_path, sizeof(hdr.source_path)) != 0
+        || SDL_strncasecmp(hdr.archive_path, key->archive_path, sizeof(hdr.archive_path)) != 0) {
+        tig_file_unmap_contents(&mapping);
+        return false;
+    }
+
+    table = (const unsigned char*)mapping.data + sizeof(hdr);
+    pool = (const char*)(table + sizeof(entry) * hdr.num_entries);
+
+    // Every string must be terminated within the pool.
+    if (pool[hdr.data_size - 1] != '\0') {
+        tig_file_unmap_contents(&mapping);
+        return false;
+    }
+
+    mes_file->size = hdr.data_size;
+    mes_file->data = (char*)MALLOC(mes_file->size);
+    memcpy(mes_file->data, pool, mes_file->size);
+
+    mes_file->num_entries = hdr.num_entries;
+    mes_file->max_entries = hdr.num_entries;
+    mes_file->entries = (MesFileEntry*)MALLOC(sizeof(MesFileEntry) * mes_file->max_entries);
+    for (index = 0; index < mes_file->num_entries; index++) {
+        memcpy(&entry, table + sizeof(entry) * index, sizeof(entry));
+        if (entry.offset >= hdr.data_size) {
+            break;
+        }
+
+        mes_file->entries[index].num = entry.num;
+        mes_file->entries[index].str = &(mes_file->data[entry.offset]);
+    }
+
+    tig_file_unmap_contents(&mapping);
+
+    // Malformed table, discard everything.
+    if (index < mes_file->num_entries) {
+        FREE(mes_file->entries);
+        FREE(mes_file->data);
+        mes_file->entries = NULL;
+        mes_file->data = NULL;
+        mes_file->num_entries = 0;
+        mes_file->max_entries = 0;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Writes compiled message file for the just parsed `mes_file`.
+ *
+ * Failures are not fatal, the source will be parsed again next time.
+ */
+void mes_cache_save(MesFile* mes_file, const MesCacheHeader* key)
+{
+    char path[TIG_MAX_PATH];
+    MesCacheHeader hdr;
+    MesCacheEntry* table;
+    TigFile* stream;
+    int index;
+    bool success;
+
+    if (!mes_cache_path(mes_file->path, path)) {
+        return;
+    }
+
+    hdr = *key;
+    hdr.num_entries = mes_file->num_entries;
+    hdr.data_size = (uint32_t)mes_file->size;
+
+    table = (MesCacheEntry*)MALLOC(sizeof(*table) * mes_file->num_entries);
+    for (index = 0; index < mes_file->num_entries; index++) {
+        table[index].num = mes_file->entries[index].num;
+        table[index].offset = (uint32_t)(mes_file->entries[index].str - mes_file->data);
+    }
+
+    tig_file_mkdir("cache\\mes");
+
+    stream = tig_file_fopen(path, "wb");
+    if (stream != NULL) {
+        success = tig_file_fwrite(&hdr, sizeof(hdr), 1, stream) == 1
+            && tig_file_fwrite(table, sizeof(*table), mes_file->num_entries, stream) == (size_t)mes_file->num_entries
+            && tig_file_fwrite(mes_file->data, mes_file->size, 1, stream) == 1;
+        tig_file_fclose(stream);
+
+        if (!success) {
+            tig_file_remove(path);
+        }
+    }
+
+    FREE(table);
+}
@@ -14,6 +14,12 @@
 
 #define OBJ_FILE_VERSION 119
 
+// Fields mirrored in `Object` (see `obj_hot_fetch`). `OBJ_F_TYPE` does not need
+// a mirror since it's always available as `Object::type`.
+#define OBJ_HOT_LOCATION 0x01
+#define OBJ_HOT_FLAGS 0x02
+#define OBJ_HOT_CURRENT_AID 0x04
+
 // CE: The type of `data` and `transient_properties` is changed to `intptr_t` to
 // handle complex fields (virtually everything besides plain integers is stored
 // as pointers).
@@ -29,6 +35,11 @@ typedef struct Object {
     /* 004C */ int* field_4C;
     /* 0050 */ intptr_t* data;
     /* 0054 */ intptr_t transient_properties[19];
+    unsigned int hot_serial;
+    unsigned int hot_mask;
+    int hot_flags;
+    int hot_current_aid;
+    int64_t hot_location;
 } Object;
 
 typedef bool (*ObjectProtoEnumerateFieldsCallback)(Object* object, int fld);
@@ -131,6 +142,9 @@ static void obj_version_write_mem(WriteBuffer* wb);
 static bool obj_version_read_mem(uint8_t** data);
 static bool sub_40D670(Object* object, int a2, ObjectFieldInfo* field_info);
 static int64_t obj_get_prototype_handle(Object* object);
+static bool obj_hot_fetch(Object* object, int fld, void* value_ptr);
+static void obj_hot_store(Object* object, int fld, void* value_ptr);
+static void obj_hot_invalidate_all(void);
 
 // 0x59BE00
 static int dword_59BE00[] = {
@@ -567,6 +581,11 @@ static int obj_scalar_handle_field_cnt;
 // 0x5D1134
 static int obj_array_handle_field_cnt;
 
+// Current generation of hot field mirrors. Mirrors of objects with a different
+// `hot_serial` are considered empty. Never `0`, which is the serial of a newly
+// allocated object.
+static unsigned int obj_hot_serial = 1;
+
 // 0x405110
 bool obj_init(GameInitInfo* init_info)
 {
@@ -1027,6 +1046,7 @@ void sub_405D60(int64_t* new_obj_ptr, int64_t obj)
 
     obj_unlock(obj);
     obj_unlock(new_obj);
+    obj_hot_invalidate_all();
     sub_464470(new_obj, NULL, NULL);
 
     *new_obj_ptr = new_obj;
@@ -1104,6 +1124,7 @@ void obj_perm_dup(int64_t* copy_obj_ptr, int64_t existing_obj)
 
     *copy_obj_ptr = copy_obj;
 
+    obj_hot_invalidate_all();
     obj_find_add(copy_obj);
 }
 
@@ -1249,6 +1270,8 @@ bool obj_read(TigFile* stream, int64_t* obj_handle_ptr)
         ret = obj_inst_read_file(stream, obj_handle_ptr, oid);
     }
 
+    obj_hot_invalidate_all();
+
     return ret;
 }
 
@@ -1294,6 +1317,8 @@ bool obj_read_mem(uint8_t* data, int64_t* obj_ptr)
         ret = obj_inst_read_mem(data, obj_ptr);
     }
 
+    obj_hot_invalidate_all();
+
     return ret;
 }
 
@@ -1448,6 +1473,7 @@ bool obj_dif_read(TigFile* stream, int64_t obj)
         return false;
     }
 
+    obj_hot_invalidate_all();
     obj_find_move(obj);
 
     return true;
@@ -2071,6 +2097,7 @@ void obj_field_reset(int64_t obj, int fld)
         if (object->prototype_oid.type == OID_TYPE_BLOCKED) {
             object_proto_field_dealloc(object, fld);
             sub_40D400(object, fld, true);
+            obj_hot_invalidate_all();
             obj_unlock(obj);
         } else if (fld > OBJ_F_TRANSIENT_BEGIN) {
             object_transient_field_dealloc(object, fld);
@@ -2085,6 +2112,7 @@ void obj_field_reset(int64_t obj, int fld)
                 sub_40D400(object, fld, true);
             }
             object->modified = true;
+            object->hot_mask = 0;
             obj_unlock(obj);
         }
     } else {
@@ -2294,7 +2322,16 @@ void obj_debug_aid(tig_art_id_t aid)
 // 0x408710
 Object* obj_allocate(int64_t* obj_ptr)
 {
-    return obj_pool_allocate(obj_ptr);
+    Object* object;
+
+    object = obj_pool_allocate(obj_ptr);
+
+    // CE: Pool slots are reused, make sure the mirror of the previous object
+    // is not picked up.
+    object->hot_serial = 0;
+    object->hot_mask = 0;
+
+    return object;
 }
 
 // 0x408020
@@ -2425,6 +2462,14 @@ void obj_field_store(Object* object, int fld, void* value_ptr)
     }
 
     obj_data_store(&store_op);
+
+    // Instances inherit non-overridden fields from prototype, so changing
+    // prototype can affect any mirror.
+    if (object->prototype_oid.type == OID_TYPE_BLOCKED) {
+        obj_hot_invalidate_all();
+    } else {
+        obj_hot_store(object, fld, value_ptr);
+    }
 }
 
 // 0x4088B0
@@ -2492,6 +2537,10 @@ void obj_field_fetch(Object* object, int fld, void* value_ptr)
         return;
     }
 
+    if (obj_hot_fetch(object, fld, value_ptr)) {
+        return;
+    }
+
     fetch_op.type = object_fields[fld].type;
     if (object->prototype_oid.type == OID_TYPE_BLOCKED) {
         storage_idx = sub_40CB40(object, fld);
@@ -2533,6 +2582,8 @@ void obj_field_fetch(Object* object, int fld, void* value_ptr)
         *(intptr_t*)value_ptr = fetch_op.storage.ptr;
         break;
     }
+
+    obj_hot_store(object, fld, value_ptr);
 }
 
 // 0x408BB0
@@ -5221,3 +5272,103 @@ void obj_arrayfield_ptr_set(int64_t obj, int fld, int index, void* value)
     obj_arrayfield_store(object, fld, index, &value);
     obj_unlock(obj);
 }
+
+// Fetches `cnt` scalar fields of the object under a single lock. Each value is
+// written to the corresponding pointer in `value_ptrs` exactly like the
+// respective `obj_field_int32_get`/`obj_field_int64_get` would return it.
+//
+// Handle and string fields are not supported.
+void obj_fields_get(int64_t obj, int cnt, const int* flds, void** value_ptrs)
+{
+    Object* object;
+    int idx;
+    int fld;
+
+    object = obj_lock(obj);
+    for (idx = 0; idx < cnt; idx++) {
+        fld = flds[idx];
+        if (!object_field_valid(object->type, fld)) {
+            object_field_not_exists(object, fld);
+            if (object_fields[fld].type == OD_TYPE_INT64) {
+                *(int64_t*)value_ptrs[idx] = 0;
+            } else {
+                *(int*)value_ptrs[idx] = 0;
+            }
+            continue;
+        }
+
+        obj_field_fetch(object, fld, value_ptrs[idx]);
+    }
+    obj_unlock(obj);
+}
+
+// Serves the field from the object's mirror, if it's there.
+bool obj_hot_fetch(Object* object, int fld, void* value_ptr)
+{
+    if (object->hot_serial != obj_hot_serial) {
+        return false;
+    }
+
+    switch (fld) {
+    case OBJ_F_LOCATION:
+        if ((object->hot_mask & OBJ_HOT_LOCATION) != 0) {
+            *(int64_t*)value_ptr = object->hot_location;
+            return true;
+        }
+        break;
+    case OBJ_F_FLAGS:
+        if ((object->hot_mask & OBJ_HOT_FLAGS) != 0) {
+            *(int*)value_ptr = object->hot_flags;
+            return true;
+        }
+        break;
+    case OBJ_F_CURRENT_AID:
+        if ((object->hot_mask & OBJ_HOT_CURRENT_AID) != 0) {
+            *(int*)value_ptr = object->hot_current_aid;
+            return true;
+        }
+        break;
+    }
+
+    return false;
+}
+
+// Updates the object's mirror with the value that was just fetched or stored.
+void obj_hot_store(Object* object, int fld, void* value_ptr)
+{
+    if (fld != OBJ_F_LOCATION
+        && fld != OBJ_F_FLAGS
+        && fld != OBJ_F_CURRENT_AID) {
+        return;
+    }
+
+    if (object->hot_serial != obj_hot_serial) {
+        object->hot_serial = obj_hot_serial;
+        object->hot_mask = 0;
+    }
+
+    switch (fld) {
+    case OBJ_F_LOCATION:
+        object->hot_location = *(int64_t*)value_ptr;
+        object->hot_mask |= OBJ_HOT_LOCATION;
+        break;
+    case OBJ_F_FLAGS:
+        object->hot_flags = *(int*)value_ptr;
+        object->hot_mask |= OBJ_HOT_FLAGS;
+        break;
+    case OBJ_F_CURRENT_AID:
+        object->hot_current_aid = *(int*)value_ptr;
+        object->hot_mask |= OBJ_HOT_CURRENT_AID;
+        break;
+    }
+}
+
+// Drops mirrors of all objects. Used when object data is changed in bulk (i.e.
+// read from file, duplicated) or a prototype is changed.
+void obj_hot_invalidate_all(void)
+{
+    obj_hot_serial++;
+    if (obj_hot_serial == 0) {
+        obj_hot_serial = 1;
+    }
+}
@@ -434,6 +434,7 @@ void* obj_field_ptr_get(int64_t obj, int field);
 void obj_field_ptr_set(int64_t obj, int field, void* value);
 void* obj_arrayfield_ptr_get(int64_t obj, int fld, int index);
 void obj_arrayfield_ptr_set(int64_t obj, int fld, int index, void* value);
+void obj_fields_get(int64_t obj, int cnt, const int* flds, void** value_ptrs);
 
 // NOTE: Seen in some assertions in `anim.c`.
 static inline bool obj_type_is_critter(int type)
@@ -12,6 +12,9 @@ typedef struct FindNode {
     /* 0010 */ struct FindNode* prev;
     /* 0014 */ struct FindNode* next;
     /* 0018 */ int64_t sec;
+
+    // Type of `obj`, which never changes (see `obj_find_walk_first_typed`).
+    int type;
 } FindNode;
 
 typedef struct FindSector {
@@ -137,6 +140,7 @@ void obj_find_add(int64_t obj)
 
     obj_find_node_allocate(&find_node);
     find_node->obj = obj;
+    find_node->type = obj_field_int32_get(obj, OBJ_F_TYPE);
 
     obj_find_sector_allocate(sec, &find_sector);
     obj_find_node_attach(find_sector, find_node);
@@ -268,6 +272,50 @@ bool obj_find_walk_next(int64_t* obj_ptr, FindNode** iter_ptr)
     }
 }
 
+/**
+ * Same as `obj_find_walk_first`, but also returns the object's type, which is
+ * kept in the find node.
+ */
+bool obj_find_walk_first_typed(int64_t sec, int64_t* obj_ptr, int* type_ptr, FindNode** iter_ptr)
+{
+    int index;
+    FindNode* node;
+
+    if (!obj_find_sector_find(sec, &index)) {
+        *obj_ptr = OBJ_HANDLE_NULL;
+        return false;
+    }
+
+    node = find_sectors[index].head;
+    if (node == NULL) {
+        tig_debug_println("Found empty sector in obj_find_walk_first_typed.");
+        *obj_ptr = OBJ_HANDLE_NULL;
+        return false;
+    }
+
+    *obj_ptr = node->obj;
+    *type_ptr = node->type;
+    *iter_ptr = node->next;
+
+    return true;
+}
+
+/**
+ * Same as `obj_find_walk_next`, but also returns the object's type.
+ */
+bool obj_find_walk_next_typed(int64_t* obj_ptr, int* type_ptr, FindNode** iter_ptr)
+{
+    if (*iter_ptr != NULL) {
+        *obj_ptr = (*iter_ptr)->obj;
+        *type_ptr = (*iter_ptr)->type;
+        *iter_ptr = (*iter_ptr)->next;
+        return true;
+    } else {
+        *obj_ptr = OBJ_HANDLE_NULL;
+        return false;
+    }
+}
+
 /**
  * Allocates a new bucket of `FindNode` instances and adds them to the free
  * list.
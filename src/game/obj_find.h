@@ -12,5 +12,7 @@ void obj_find_remove(int64_t obj);
 void obj_find_move(int64_t obj);
 bool obj_find_walk_first(int64_t sec, int64_t* obj_ptr, FindNode** iter_ptr);
 bool obj_find_walk_next(int64_t* obj_ptr, FindNode** iter_ptr);
+bool obj_find_walk_first_typed(int64_t sec, int64_t* obj_ptr, int* type_ptr, FindNode** iter_ptr);
+bool obj_find_walk_next_typed(int64_t* obj_ptr, int* type_ptr, FindNode** iter_ptr);
 
 #endif /* ARCANUM_GAME_OBJ_FIND_H_ */
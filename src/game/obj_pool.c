@@ -40,6 +40,11 @@
 #define OBJ_POOL_PERM_OID_TABLE_INITIAL_CAPACITY 1024
 #define OBJ_POOL_PERM_OID_TABLE_GROW_STEP 512
 
+/**
+ * Minimum capacity of the handle-indexed reverse table.
+ */
+#define OBJ_POOL_PERM_REVERSE_TABLE_INITIAL_CAPACITY 4096
+
 /**
  * Object handle bit-field layout.
  *
@@ -96,8 +101,8 @@ typedef struct ObjPoolEntryHeader {
  * One entry in the permanent OID lookup table.
  *
  * Maps a persistent `ObjectID` to the live pool handle of the in-memory
- * object it corresponds to. The table is kept sorted by oid to allow binary
- * search.
+ * object it corresponds to. Entries are stored in insertion order, lookups go
+ * through `obj_pool_perm_oid_buckets` and `obj_pool_perm_reverse_table`.
  */
 typedef struct PermOidLookupEntry {
     /* 0000 */ ObjectID oid;
@@ -109,6 +114,11 @@ static void release_index(int index);
 static bool grow_pool(void);
 static void recycle_index(int index);
 static bool find_perm_oid(ObjectID oid, int* index_ptr);
+static unsigned int perm_oid_hash(const ObjectID* oid);
+static bool perm_oid_equal(const ObjectID* a, const ObjectID* b);
+static void perm_oid_bucket_insert(int index);
+static void perm_oid_rebuild(void);
+static void perm_reverse_set(int index);
 static int64_t make_handle(int index, int seq);
 static int index_from_handle(int64_t obj);
 static ObjPoolEntryHeader* element_hdr_at_index(int index);
@@ -152,7 +162,7 @@ static int obj_pool_next_seq;
 static bool obj_pool_editor;
 
 /**
- * Sorted array of oid-to-obj pairs for permanent object lookups.
+ * Array of oid-to-obj pairs for permanent object lookups.
  *
  * Capacity: `obj_pool_perm_oid_table_capacity`
  * Size: `obj_pool_perm_oid_table_size`
@@ -161,6 +171,32 @@ static bool obj_pool_editor;
  */
 static PermOidLookupEntry* obj_pool_perm_oid_table;
 
+/**
+ * Open-addressing (linear probing) hash table of `obj_pool_perm_oid_table`
+ * entries keyed by oid.
+ *
+ * Every slot holds entry index plus one, `0` marks an empty slot. Entries are
+ * never removed one by one (only in bulk by `obj_pool_perm_clear`), so there
+ * is no need for tombstones.
+ *
+ * Capacity: `obj_pool_perm_oid_buckets_capacity` (power of two, at least twice
+ * the capacity of `obj_pool_perm_oid_table`)
+ */
+static int* obj_pool_perm_oid_buckets;
+static int obj_pool_perm_oid_buckets_capacity;
+
+/**
+ * Reverse index of `obj_pool_perm_oid_table` entries by pool index of their
+ * handle.
+ *
+ * Every element holds entry index plus one, `0` means there is no entry. Grown
+ * on demand to cover the largest pool index seen.
+ *
+ * Capacity: `obj_pool_perm_reverse_table_capacity`
+ */
+static int* obj_pool_perm_reverse_table;
+static int obj_pool_perm_reverse_table_capacity;
+
 /**
  * Pointer to the array of bucket pointers.
  *
@@ -329,6 +365,12 @@ void obj_pool_init(int size, bool editor)
     obj_handle_requested = OBJ_HANDLE_NULL;
     obj_pool_perm_oid_table = (PermOidLookupEntry*)MALLOC(sizeof(*obj_pool_perm_oid_table) * obj_pool_perm_oid_table_capacity);
 
+    obj_pool_perm_oid_buckets = NULL;
+    obj_pool_perm_oid_buckets_capacity = 0;
+    obj_pool_perm_reverse_table = NULL;
+    obj_pool_perm_reverse_table_capacity = 0;
+    perm_oid_rebuild();
+
     obj_pool_initialized = true;
 }
 
@@ -364,6 +406,8 @@ void obj_pool_exit(void)
     // Release remaining storage.
     FREE(obj_pool_freed_indexes);
     FREE(obj_pool_perm_oid_table);
+    FREE(obj_pool_perm_oid_buckets);
+    FREE(obj_pool_perm_reverse_table);
     FREE(obj_pool_buckets);
 
     obj_pool_initialized = false;
@@ -475,41 +519,76 @@ void obj_pool_deallocate(int64_t obj)
  * Inserts or updates the oid-to-obj pair in the permanent OID lookup table.
  *
  * If `oid` is already present its handle is updated in place. Otherwise a new
- * entry is inserted at the position determined by `find_perm_oid` so the table
- * stays.
+ * entry is appended to the table and added to the hash and reverse indexes.
  *
  * 0x4E4FD0
  */
 void obj_pool_perm_oid_set(ObjectID oid, int64_t obj)
 {
     int index;
+    int reverse_index;
+    int other;
+    int64_t old_obj;
 
     if (find_perm_oid(oid, &index)) {
-        // Entry already exists - just update the handle.
-        obj_pool_perm_oid_table[index].obj = obj;
+        // Entry already exists - just update the handle. Drop the reverse
+        // mapping of the old handle if it refers to this entry.
+        if (obj_pool_perm_oid_table[index].obj != obj) {
+            old_obj = obj_pool_perm_oid_table[index].obj;
+            obj_pool_perm_oid_table[index].obj = obj;
+
+            reverse_index = index_from_handle(old_obj);
+            if (old_obj != OBJ_HANDLE_NULL
+                && reverse_index >= 0
+                && reverse_index < obj_pool_perm_reverse_table_capacity
+                && obj_pool_perm_reverse_table[reverse_index] == index + 1) {
+                obj_pool_perm_reverse_table[reverse_index] = 0;
+
+                // The old handle is still alive (its oid has been reassigned)
+                // and might be known under another oid. This is rare, so just
+                // scan the table.
+                if (obj_handle_is_valid(old_obj)) {
+                    for (other = 0; other < obj_pool_perm_oid_table_size; other++) {
+                        if (obj_pool_perm_oid_table[other].obj == old_obj) {
+                            perm_reverse_set(other);
+                        }
+                    }
+                }
+            }
+
+            perm_reverse_set(index);
+        }
         return;
     }
 
     // Grow the table if it is at capacity.
     if (obj_pool_perm_oid_table_size == obj_pool_perm_oid_table_capacity) {
-        obj_pool_perm_oid_table_capacity += OBJ_POOL_PERM_OID_TABLE_GROW_STEP;
-        if (obj_pool_perm_oid_table_capacity > OBJ_POOL_CAP) {
+        if (obj_pool_perm_oid_table_capacity >= OBJ_POOL_CAP) {
             return;
         }
 
-        obj_pool_perm_oid_table = (PermOidLookupEntry*)REALLOC(obj_pool_perm_oid_table, sizeof(*obj_pool_perm_oid_table) * obj_pool_perm_oid_table_capacity);
-    }
+        // Grow geometrically, maps and saves add entries by thousands.
+        obj_pool_perm_oid_table_capacity += obj_pool_perm_oid_table_capacity > OBJ_POOL_PERM_OID_TABLE_GROW_STEP
+            ? obj_pool_perm_oid_table_capacity
+            : OBJ_POOL_PERM_OID_TABLE_GROW_STEP;
+        if (obj_pool_perm_oid_table_capacity > OBJ_POOL_CAP) {
+            obj_pool_perm_oid_table_capacity = OBJ_POOL_CAP;
+        }
 
-    // Shift entries from `index` onward to make room, preserving sort order.
-    if (index != obj_pool_perm_oid_table_size) {
-        memmove(&(obj_pool_perm_oid_table[index + 1]),
-            &(obj_pool_perm_oid_table[index]),
-            sizeof(*obj_pool_perm_oid_table) * (obj_pool_perm_oid_table_size - index));
+        obj_pool_perm_oid_table = (PermOidLookupEntry*)REALLOC(obj_pool_perm_oid_table, sizeof(*obj_pool_perm_oid_table) * obj_pool_perm_oid_table_capacity);
     }
 
+    index = obj_pool_perm_oid_table_size++;
     obj_pool_perm_oid_table[index].oid = oid;
     obj_pool_perm_oid_table[index].obj = obj;
-    obj_pool_perm_oid_table_size++;
+
+    if (obj_pool_perm_oid_buckets_capacity < obj_pool_perm_oid_table_capacity * 2) {
+        // Rehash everything (including the new entry) into a larger table.
+        perm_oid_rebuild();
+    } else {
+        perm_oid_bucket_insert(index);
+        perm_reverse_set(index);
+    }
 }
 
 /**
@@ -526,8 +605,9 @@ void obj_pool_perm_oid_set(ObjectID oid, int64_t obj)
 int64_t obj_pool_perm_lookup(ObjectID oid)
 {
     int idx;
-    ObjectList objects;
-    ObjectNode* node;
+    ObjectArray objects;
+    int64_t storage[OBJECT_ARRAY_STORAGE_SIZE];
+    int index;
 
     // Fast path: the OID is already cached and the handle is still valid.
     if (find_perm_oid(oid, &idx)) {
@@ -552,34 +632,35 @@ int64_t obj_pool_perm_lookup(ObjectID oid)
         return OBJ_HANDLE_NULL;
     }
 
-    // Retrieve all static objects at the stored tile location.
-    object_list_location(oid.d.p.location, OBJ_TM_TRAP | OBJ_TM_WALL | OBJ_TM_PORTAL | OBJ_TM_SCENERY, &objects);
+    // Retrieve all static objects at the stored tile location. This runs for
+    // every positional OID during map and save loading, so collect handles
+    // into stack storage rather than building a linked list.
+    object_array_init(&objects, storage, SDL_arraysize(storage));
+    object_array_location(oid.d.p.location, OBJ_TM_TRAP | OBJ_TM_WALL | OBJ_TM_PORTAL | OBJ_TM_SCENERY, &objects);
 
     if (objects.num_sectors != 1) {
         tig_debug_println("Warning: objp_perm_lookup found sectors != 1");
-        object_list_destroy(&objects);
+        object_array_destroy(&objects);
         return OBJ_HANDLE_NULL;
     }
 
     // Find the specific object by its temporary ID within the tile.
-    node = objects.head;
-    while (node != NULL) {
-        if (obj_field_int32_get(node->obj, OBJ_F_TEMP_ID) == oid.d.p.temp_id) {
+    for (index = 0; index < objects.cnt; index++) {
+        if (obj_field_int32_get(objects.objs[index], OBJ_F_TEMP_ID) == oid.d.p.temp_id) {
             break;
         }
-        node = node->next;
     }
 
-    if (node == NULL) {
+    if (index == objects.cnt) {
         // Object not found.
-        object_list_destroy(&objects);
+        object_array_destroy(&objects);
         return OBJ_HANDLE_NULL;
     }
 
     // Cache the result so subsequent lookups hit the fast path.
-    obj_pool_perm_oid_set(oid, node->obj);
+    obj_pool_perm_oid_set(oid, objects.objs[index]);
 
-    object_list_destroy(&objects);
+    object_array_destroy(&objects);
 
     // Sanity check - it has to work.
     if (!find_perm_oid(oid, &idx)) {
@@ -593,8 +674,8 @@ int64_t obj_pool_perm_lookup(ObjectID oid)
 /**
  * Reverse-looks up the `ObjectID` registered for a given handle.
  *
- * Performs a linear scan of the permanent OID table. Returns an `ObjectID` with
- * type `OID_TYPE_NULL` if the handle is not found.
+ * Uses the handle-indexed reverse table. Returns an `ObjectID` with type
+ * `OID_TYPE_NULL` if the handle is not found.
  *
  * 0x4E5280
  */
@@ -602,10 +683,17 @@ ObjectID obj_pool_perm_reverse_lookup(int64_t obj)
 {
     ObjectID oid;
     int index;
+    int entry_index;
 
-    for (index = 0; index < obj_pool_perm_oid_table_size; index++) {
-        if (obj_pool_perm_oid_table[index].obj == obj) {
-            return obj_pool_perm_oid_table[index].oid;
+    if (obj != OBJ_HANDLE_NULL) {
+        index = index_from_handle(obj);
+        if (index >= 0 && index < obj_pool_perm_reverse_table_capacity) {
+            entry_index = obj_pool_perm_reverse_table[index] - 1;
+
+            // The slot could have been reused by a newer handle.
+            if (entry_index >= 0 && obj_pool_perm_oid_table[entry_index].obj == obj) {
+                return obj_pool_perm_oid_table[entry_index].oid;
+            }
         }
     }
 
@@ -630,36 +718,27 @@ void obj_pool_perm_oid_remove(ObjectID oid)
  * Clears permanent OID lookup table, retaining only entries whose OID type is
  * `OID_TYPE_A`.
  *
+ * The retained entries are compacted in place (preserving their order) and
+ * both indexes are rebuilt in one pass.
+ *
  * 0x4E5300
  */
 void obj_pool_perm_clear(void)
 {
-    PermOidLookupEntry* scratch;
     int cnt;
     int read_idx;
-    int write_idx;
 
     cnt = 0;
-    scratch = MALLOC(sizeof(*scratch) * obj_pool_perm_oid_table_size);
-
-    // Walk backward through the table, collecting `OID_TYPE_A` entries into the
-    // tail of scratch (also backward) so their original order is preserved.
-    read_idx = obj_pool_perm_oid_table_size - 1;
-    write_idx = read_idx;
-    while (read_idx >= 0) {
+    for (read_idx = 0; read_idx < obj_pool_perm_oid_table_size; read_idx++) {
         if (obj_pool_perm_oid_table[read_idx].oid.type == OID_TYPE_A) {
-            scratch[write_idx] = obj_pool_perm_oid_table[read_idx];
-            write_idx--;
-            cnt++;
+            obj_pool_perm_oid_table[cnt++] = obj_pool_perm_oid_table[read_idx];
         }
-        read_idx--;
     }
 
-    // Replace the table contents with only the retained entries.
-    memset(obj_pool_perm_oid_table, 0, sizeof(*obj_pool_perm_oid_table) * obj_pool_perm_oid_table_size);
-    memcpy(obj_pool_perm_oid_table, &(scratch[write_idx + 1]), sizeof(*obj_pool_perm_oid_table) * cnt);
-    FREE(scratch);
+    memset(&(obj_pool_perm_oid_table[cnt]), 0, sizeof(*obj_pool_perm_oid_table) * (obj_pool_perm_oid_table_size - cnt));
     obj_pool_perm_oid_table_size = cnt;
+
+    perm_oid_rebuild();
 }
 
 /**
@@ -941,41 +1020,199 @@ void recycle_index(int index)
 }
 
 /**
- * Binary-searches the permanent OID table for `oid`.
+ * Looks up `oid` in the permanent OID hash table.
  *
  * On a hit writes the entry's index into `*index_ptr` and returns `true`.
- * On a miss writes the insertion point (the index at which `oid` should be
- * inserted to keep the table sorted) into `*index_ptr` and returns `false`.
  *
  * 0x4E57E0
  */
 bool find_perm_oid(ObjectID oid, int* index_ptr)
 {
-    int l;
-    int r;
-    int m;
-
-    l = 0;
-    r = obj_pool_perm_oid_table_size - 1;
-    while (l <= r) {
-        m = (l + r) / 2;
-        // FIXME: Unnecessary copying.
-        if (objid_compare(obj_pool_perm_oid_table[m].oid, oid)) {
-            l = m + 1;
-        } else if (objid_compare(oid, obj_pool_perm_oid_table[m].oid)) {
-            r = m - 1;
-        } else {
-            // Exact match.
-            *index_ptr = m;
+    unsigned int mask;
+    unsigned int slot;
+    int index;
+
+    mask = (unsigned int)obj_pool_perm_oid_buckets_capacity - 1;
+    slot = perm_oid_hash(&oid) & mask;
+    while ((index = obj_pool_perm_oid_buckets[slot]) != 0) {
+        if (perm_oid_equal(&(obj_pool_perm_oid_table[index - 1].oid), &oid)) {
+            *index_ptr = index - 1;
             return true;
         }
+        slot = (slot + 1) & mask;
     }
 
-    // Not found, `l` is the correct insertion point to maintain sort order.
-    *index_ptr = l;
     return false;
 }
 
+/**
+ * Hashes the significant part of `oid` (the same fields `objid_compare`
+ * looks at, the rest may contain garbage).
+ */
+unsigned int perm_oid_hash(const ObjectID* oid)
+{
+    uint64_t hash;
+    int index;
+
+    hash = (uint64_t)(uint16_t)oid->type * 0x9E3779B97F4A7C15ULL;
+
+    switch (oid->type) {
+    case OID_TYPE_A:
+        hash ^= (uint32_t)oid->d.a;
+        break;
+    case OID_TYPE_GUID:
+        for (index = 0; index < 16; index++) {
+            hash = (hash ^ oid->d.g.data[index]) * 0x100000001B3ULL;
+        }
+        break;
+    case OID_TYPE_P:
+        hash ^= (uint64_t)oid->d.p.location;
+        hash = (hash ^ (uint32_t)oid->d.p.temp_id) * 0x100000001B3ULL;
+        hash = (hash ^ (uint32_t)oid->d.p.map) * 0x100000001B3ULL;
+        break;
+    }
+
+    // Final mix (splitmix64).
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBULL;
+    hash ^= hash >> 31;
+
+    return (unsigned int)hash;
+}
+
+/**
+ * Returns `true` if `a` and `b` denote the same oid, that is neither of them
+ * is less than the other according to `objid_compare`.
+ */
+bool perm_oid_equal(const ObjectID* a, const ObjectID* b)
+{
+    if (a->type != b->type) {
+        return false;
+    }
+
+    switch (a->type) {
+    case OID_TYPE_A:
+        return a->d.a == b->d.a;
+    case OID_TYPE_GUID:
+        return memcmp(a->d.g.data, b->d.g.data, sizeof(a->d.g.data)) == 0;
+    case OID_TYPE_P:
+        return a->d.p.location == b->d.p.location
+            && a->d.p.temp_id == b->d.p.temp_id
+            && a->d.p.map == b->d.p.map;
+    }
+
+    return true;
+}
+
+/**
+ * Adds the entry at `index` to the hash table. The entry must not be there
+ * yet, and the table must have free slots.
+ */
+void perm_oid_bucket_insert(int index)
+{
+    unsigned int mask;
+    unsigned int slot;
+
+    mask = (unsigned int)obj_pool_perm_oid_buckets_capacity - 1;
+    slot = perm_oid_hash(&(obj_pool_perm_oid_table[index].oid)) & mask;
+    while (obj_pool_perm_oid_buckets[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+
+    obj_pool_perm_oid_buckets[slot] = index + 1;
+}
+
+/**
+ * Rebuilds the hash table and the reverse table from scratch, resizing the
+ * hash table to match the capacity of `obj_pool_perm_oid_table`.
+ */
+void perm_oid_rebuild(void)
+{
+    int capacity;
+    int index;
+
+    capacity = 16;
+    while (capacity < obj_pool_perm_oid_table_capacity * 2) {
+        capacity *= 2;
+    }
+
+    if (capacity != obj_pool_perm_oid_buckets_capacity) {
+        FREE(obj_pool_perm_oid_buckets);
+        obj_pool_perm_oid_buckets = (int*)MALLOC(sizeof(*obj_pool_perm_oid_buckets) * capacity);
+        obj_pool_perm_oid_buckets_capacity = capacity;
+    }
+
+    memset(obj_pool_perm_oid_buckets, 0, sizeof(*obj_pool_perm_oid_buckets) * obj_pool_perm_oid_buckets_capacity);
+
+    if (obj_pool_perm_reverse_table != NULL) {
+        memset(obj_pool_perm_reverse_table, 0, sizeof(*obj_pool_perm_reverse_table) * obj_pool_perm_reverse_table_capacity);
+    }
+
+    for (index = 0; index < obj_pool_perm_oid_table_size; index++) {
+        perm_oid_bucket_insert(index);
+        perm_reverse_set(index);
+    }
+}
+
+/**
+ * Points the reverse table slot of the entry's handle to the entry at `index`.
+ *
+ * When several oids share the same handle the one that is the least according
+ * to `objid_compare` wins (this is what the linear scan of the sorted table
+ * used to return). An entry of the live object occupying the same pool slot is
+ * never replaced by a stale entry.
+ */
+void perm_reverse_set(int index)
+{
+    int64_t obj;
+    int reverse_index;
+    int capacity;
+    int other;
+
+    obj = obj_pool_perm_oid_table[index].obj;
+    if (obj == OBJ_HANDLE_NULL) {
+        return;
+    }
+
+    reverse_index = index_from_handle(obj);
+    if (reverse_index < 0 || reverse_index >= OBJ_POOL_CAP) {
+        return;
+    }
+
+    if (reverse_index >= obj_pool_perm_reverse_table_capacity) {
+        capacity = obj_pool_perm_reverse_table_capacity > 0
+            ? obj_pool_perm_reverse_table_capacity
+            : OBJ_POOL_PERM_REVERSE_TABLE_INITIAL_CAPACITY;
+        while (capacity <= reverse_index) {
+            capacity *= 2;
+        }
+        if (capacity > OBJ_POOL_CAP) {
+            capacity = OBJ_POOL_CAP;
+        }
+
+        obj_pool_perm_reverse_table = (int*)REALLOC(obj_pool_perm_reverse_table, sizeof(*obj_pool_perm_reverse_table) * capacity);
+        memset(&(obj_pool_perm_reverse_table[obj_pool_perm_reverse_table_capacity]),
+            0,
+            sizeof(*obj_pool_perm_reverse_table) * (capacity - obj_pool_perm_reverse_table_capacity));
+        obj_pool_perm_reverse_table_capacity = capacity;
+    }
+
+    other = obj_pool_perm_reverse_table[reverse_index] - 1;
+    if (other >= 0 && other != index) {
+        if (obj_pool_perm_oid_table[other].obj == obj) {
+            if (objid_compare(obj_pool_perm_oid_table[other].oid, obj_pool_perm_oid_table[index].oid)) {
+                return;
+            }
+        } else if (obj_handle_is_valid(obj_pool_perm_oid_table[other].obj)) {
+            return;
+        }
+    }
+
+    obj_pool_perm_reverse_table[reverse_index] = index + 1;
+}
+
 /**
  * Encodes `index` and `seq` into a 64-bit handle.
  *
@@ -72,6 +72,13 @@ static int sub_43D690(int64_t obj);
 static int sub_43D630(int64_t obj);
 static int object_calc_traversal_cost_func(int64_t obj, int64_t loc, int rot, int orig_rot, unsigned int flags, int64_t* block_obj_ptr, int* block_obj_type_ptr, bool* is_window_ptr);
 static void object_list_vicinity_loc(int64_t loc, unsigned int flags, ObjectList* objects);
+static void object_query_types(unsigned int flags, bool* types);
+static bool object_query_match(ObjectNode* node, bool* types);
+static bool object_query_match_unlocked(int64_t obj, int type, bool* types, int64_t* loc_ptr);
+static void object_query_location(int64_t loc, unsigned int flags, ObjectArray* objects);
+static void object_query_rect(LocRect* loc_rect, unsigned int flags, ObjectArray* objects);
+static void object_array_append(ObjectArray* objects, int64_t obj);
+static void object_list_from_array(ObjectArray* array, ObjectList* objects);
 static bool object_create_func(int64_t proto_obj, int64_t loc, int64_t* obj_ptr, ObjectID oid);
 static bool object_duplicate_func(int64_t proto_obj, int64_t loc, ObjectID* oids, int64_t* obj_ptr);
 static bool sub_442260(int64_t obj, int64_t loc);
@@ -514,6 +521,8 @@ void object_draw(GameDrawInfo* draw_info)
     int64_t loc_x;
     int64_t loc_y;
     int scale;
+    int offset_x;
+    int offset_y;
     int idx;
     tig_art_id_t art_id;
     TigRect eye_candy_rect;
@@ -522,6 +531,8 @@ void object_draw(GameDrawInfo* draw_info)
     TigRect src_rect;
     TigRect dst_rect;
     TigRect tmp_rect;
+    static const int draw_flds[] = { OBJ_F_OFFSET_X, OBJ_F_OFFSET_Y, OBJ_F_BLIT_SCALE };
+    void* draw_values[] = { &offset_x, &offset_y, &scale };
     int underlay_order = 0;
     int flat_order = 200000000;
     int shadow_order = 400000000;
@@ -568,9 +579,9 @@ void object_draw(GameDrawInfo* draw_info)
                                                 || object_render_check_rotation(obj_node->obj)
                                                 || !roof_is_faded(loc)) {
                                                 location_xy(loc, &loc_x, &loc_y);
-                                                loc_x += obj_field_int32_get(obj_node->obj, OBJ_F_OFFSET_X);
-                                                loc_y += obj_field_int32_get(obj_node->obj, OBJ_F_OFFSET_Y);
-                                                scale = obj_field_int32_get(obj_node->obj, OBJ_F_BLIT_SCALE);
+                                                obj_fields_get(obj_node->obj, SDL_arraysize(draw_flds), draw_flds, draw_values);
+                                                loc_x += offset_x;
+                                                loc_y += offset_y;
 
                                                 loc_x += 40;
                                                 loc_y += 20;
@@ -1762,27 +1773,28 @@ int object_get_ac(int64_t obj, bool a2)
     return ac;
 }
 
+/**
+ * Checks if objects of the given type are static (i.e. never move, so they
+ * are not tracked in sector find lists).
+ */
+bool object_type_is_static(int type)
+{
+    return type != OBJ_TYPE_PROJECTILE
+        && type != OBJ_TYPE_CONTAINER
+        && !obj_type_is_critter(type)
+        && !obj_type_is_item(type);
+}
+
 // 0x43D940
 bool sub_43D940(int64_t obj)
 {
-    int obj_type = obj_field_int32_get(obj, OBJ_F_TYPE);
-    if (obj_type == OBJ_TYPE_PROJECTILE
-        || obj_type == OBJ_TYPE_CONTAINER
-        || obj_type_is_critter(obj_type)
-        || obj_type_is_item(obj_type)) {
-        return false;
-    }
-    return true;
+    return object_type_is_static(obj_field_int32_get(obj, OBJ_F_TYPE));
 }
 
 // 0x43D990
 bool object_is_static(int64_t obj)
 {
-    int obj_type = obj_field_int32_get(obj, OBJ_F_TYPE);
-    if (obj_type == OBJ_TYPE_PROJECTILE
-        || obj_type == OBJ_TYPE_CONTAINER
-        || obj_type_is_critter(obj_type)
-        || obj_type_is_item(obj_type)) {
+    if (!object_type_is_static(obj_field_int32_get(obj, OBJ_F_TYPE))) {
         return false;
     }
     return (obj_field_int32_get(obj, OBJ_F_FLAGS) & OF_DYNAMIC) == 0;
@@ -3303,15 +3315,101 @@ bool object_traversal_check_blocking_door(int64_t obj, int64_t loc, int rot, uns
 // 0x4407C0
 void object_list_location(int64_t loc, unsigned int flags, ObjectList* objects)
 {
-    bool types[18];
-    int64_t sector_id;
-    int64_t limit_x;
-    int64_t limit_y;
-    Sector* sector;
-    ObjectNode* new_node;
-    ObjectNode** parent_ptr;
+    ObjectArray array;
+    int64_t storage[OBJECT_ARRAY_STORAGE_SIZE];
+
+    object_array_init(&array, storage, SDL_arraysize(storage));
+    object_query_location(loc, flags, &array);
+    object_list_from_array(&array, objects);
+
+    dword_5E2F98++;
+    return;
+}
+
+// 0x440B40
+void object_list_rect(LocRect* loc_rect, unsigned int flags, ObjectList* objects)
+{
+    ObjectArray array;
+    int64_t storage[OBJECT_ARRAY_STORAGE_SIZE];
+
+    object_array_init(&array, storage, SDL_arraysize(storage));
+    object_query_rect(loc_rect, flags, &array);
+    object_list_from_array(&array, objects);
+
+    dword_5E2F98++;
+}
+
+/**
+ * Prepares `objects` to receive results of `object_array_location` or
+ * `object_array_rect`.
+ *
+ * Results are written into `storage` (which may be `NULL`) as long as they fit
+ * in `capacity`, then the array switches to the heap. The storage must outlive
+ * the array.
+ */
+void object_array_init(ObjectArray* objects, int64_t* storage, int capacity)
+{
+    objects->num_sectors = 0;
+    objects->cnt = 0;
+    objects->capacity = storage != NULL ? capacity : 0;
+    objects->objs = storage;
+    objects->heap = NULL;
+}
+
+/**
+ * Collects objects of types specified by `flags` at the given location.
+ *
+ * Array-based counterpart of `object_list_location` (same results in the same
+ * order). The sectors are kept locked until `object_array_destroy`.
+ */
+void object_array_location(int64_t loc, unsigned int flags, ObjectArray* objects)
+{
+    object_query_location(loc, flags, objects);
+    dword_5E2F98++;
+}
+
+/**
+ * Collects objects of types specified by `flags` within the given rect.
+ *
+ * Array-based counterpart of `object_list_rect` (same results in the same
+ * order). The sectors are kept locked until `object_array_destroy`.
+ */
+void object_array_rect(LocRect* loc_rect, unsigned int flags, ObjectArray* objects)
+{
+    object_query_rect(loc_rect, flags, objects);
+    dword_5E2F98++;
+}
+
+/**
+ * Releases sectors locked by the query and the heap storage (if any).
+ */
+void object_array_destroy(ObjectArray* objects)
+{
+    int index;
+
+    for (index = 0; index < objects->num_sectors; index++) {
+        sector_unlock(objects->sectors[index]);
+    }
+
+    if (objects->heap != NULL) {
+        FREE(objects->heap);
+    }
+
+    objects->num_sectors = 0;
+    objects->cnt = 0;
+    objects->capacity = 0;
+    objects->objs = NULL;
+    objects->heap = NULL;
 
-    memset(types, 0, sizeof(types));
+    --dword_5E2F98;
+}
+
+/**
+ * Converts `OBJ_TM_*` mask into the lookup table indexed by object type.
+ */
+void object_query_types(unsigned int flags, bool* types)
+{
+    memset(types, 0, sizeof(*types) * 18);
     if ((flags & OBJ_TM_WALL) != 0) types[OBJ_TYPE_WALL] = true;
     if ((flags & OBJ_TM_PORTAL) != 0) types[OBJ_TYPE_PORTAL] = true;
     if ((flags & OBJ_TM_CONTAINER) != 0) types[OBJ_TYPE_CONTAINER] = true;
@@ -3330,10 +3428,59 @@ void object_list_location(int64_t loc, unsigned int flags, ObjectList* objects)
     if ((flags & OBJ_TM_PC) != 0) types[OBJ_TYPE_PC] = true;
     if ((flags & OBJ_TM_NPC) != 0) types[OBJ_TYPE_NPC] = true;
     if ((flags & OBJ_TM_TRAP) != 0) types[OBJ_TYPE_TRAP] = true;
+}
 
-    objects->num_sectors = 0;
-    objects->head = NULL;
-    parent_ptr = &(objects->head);
+/**
+ * Checks object in a sector's tile list against the query (type and
+ * visibility flags). The type is taken from the list node, so objects of other
+ * types are rejected without being touched. Flags change all the time without
+ * the list knowing, they are only fetched for candidates.
+ */
+bool object_query_match(ObjectNode* node, bool* types)
+{
+    if (!types[node->type]) {
+        return false;
+    }
+
+    return (dword_5E2F88 & obj_field_int32_get(node->obj, OBJ_F_FLAGS)) == 0;
+}
+
+/**
+ * Checks object from the unlocked sector's find list against the query. In
+ * addition to `object_query_match` rejects static objects (see `object_type_is_static`)
+ * and objects in inventories. The type comes from the find node, flags and
+ * location (returned in `loc_ptr`) are fetched with a single lock for
+ * candidates only.
+ */
+bool object_query_match_unlocked(int64_t obj, int type, bool* types, int64_t* loc_ptr)
+{
+    static const int flds[] = { OBJ_F_FLAGS, OBJ_F_LOCATION };
+    unsigned int flags;
+    void* values[] = { &flags, loc_ptr };
+
+    if (!types[type]) {
+        return false;
+    }
+
+    if (object_type_is_static(type)) {
+        return false;
+    }
+
+    obj_fields_get(obj, SDL_arraysize(flds), flds, values);
+
+    return (flags & OF_INVENTORY) == 0
+        && (dword_5E2F88 & flags) == 0;
+}
+
+void object_query_location(int64_t loc, unsigned int flags, ObjectArray* objects)
+{
+    bool types[18];
+    int64_t sector_id;
+    int64_t limit_x;
+    int64_t limit_y;
+    Sector* sector;
+
+    object_query_types(flags, types);
 
     sector_id = sector_id_from_loc(loc);
     sector_limits_get(&limit_x, &limit_y);
@@ -3355,46 +3502,30 @@ void object_list_location(int64_t loc, unsigned int flags, ObjectList* objects)
 
             node = sector->objects.heads[tile_id_from_loc(loc)];
             while (node != NULL) {
-                if ((dword_5E2F88 & obj_field_int32_get(node->obj, OBJ_F_FLAGS)) == 0
-                    && types[obj_field_int32_get(node->obj, OBJ_F_TYPE)]) {
-                    new_node = object_node_create();
-                    new_node->obj = node->obj;
-                    new_node->next = NULL;
-
-                    *parent_ptr = new_node;
-                    parent_ptr = &((*parent_ptr)->next);
+                if (object_query_match(node, types)) {
+                    object_array_append(objects, node->obj);
                 }
                 node = node->next;
             }
         }
     } else {
         int64_t obj;
+        int64_t obj_loc;
+        int obj_type;
         FindNode* iter;
 
-        if (obj_find_walk_first(sector_id, &obj, &iter)) {
+        if (obj_find_walk_first_typed(sector_id, &obj, &obj_type, &iter)) {
             do {
-                if (!sub_43D940(obj)
-                    && (obj_field_int32_get(obj, OBJ_F_FLAGS) & OF_INVENTORY) == 0
-                    && obj_field_int64_get(obj, OBJ_F_LOCATION) == loc
-                    && (dword_5E2F88 & obj_field_int32_get(obj, OBJ_F_FLAGS)) == 0
-                    && types[obj_field_int32_get(obj, OBJ_F_TYPE)]) {
-                    new_node = object_node_create();
-                    new_node->obj = obj;
-                    new_node->next = NULL;
-
-                    *parent_ptr = new_node;
-                    parent_ptr = &((*parent_ptr)->next);
+                if (object_query_match_unlocked(obj, obj_type, types, &obj_loc)
+                    && obj_loc == loc) {
+                    object_array_append(objects, obj);
                 }
-            } while (obj_find_walk_next(&obj, &iter));
+            } while (obj_find_walk_next_typed(&obj, &obj_type, &iter));
         }
     }
-
-    dword_5E2F98++;
-    return;
 }
 
-// 0x440B40
-void object_list_rect(LocRect* loc_rect, unsigned int flags, ObjectList* objects)
+void object_query_rect(LocRect* loc_rect, unsigned int flags, ObjectArray* objects)
 {
     bool types[18];
     SectorRect v1;
@@ -3402,10 +3533,9 @@ void object_list_rect(LocRect* loc_rect, unsigned int flags, ObjectList* objects
     int col;
     int row;
     int64_t obj;
+    int obj_type;
     FindNode* iter;
     int64_t loc;
-    ObjectNode** prev_ptr;
-    ObjectNode* new_node;
     ObjectNode* obj_node;
     int indexes[3];
     int widths[3];
@@ -3414,30 +3544,7 @@ void object_list_rect(LocRect* loc_rect, unsigned int flags, ObjectList* objects
     int v3;
     int v4;
 
-    memset(types, 0, sizeof(types));
-    if ((flags & OBJ_TM_WALL) != 0) types[OBJ_TYPE_WALL] = true;
-    if ((flags & OBJ_TM_PORTAL) != 0) types[OBJ_TYPE_PORTAL] = true;
-    if ((flags & OBJ_TM_CONTAINER) != 0) types[OBJ_TYPE_CONTAINER] = true;
-    if ((flags & OBJ_TM_SCENERY) != 0) types[OBJ_TYPE_SCENERY] = true;
-    if ((flags & OBJ_TM_PROJECTILE) != 0) types[OBJ_TYPE_PROJECTILE] = true;
-    if ((flags & OBJ_TM_WEAPON) != 0) types[OBJ_TYPE_WEAPON] = true;
-    if ((flags & OBJ_TM_AMMO) != 0) types[OBJ_TYPE_AMMO] = true;
-    if ((flags & OBJ_TM_ARMOR) != 0) types[OBJ_TYPE_ARMOR] = true;
-    if ((flags & OBJ_TM_GOLD) != 0) types[OBJ_TYPE_GOLD] = true;
-    if ((flags & OBJ_TM_FOOD) != 0) types[OBJ_TYPE_FOOD] = true;
-    if ((flags & OBJ_TM_SCROLL) != 0) types[OBJ_TYPE_SCROLL] = true;
-    if ((flags & OBJ_TM_KEY) != 0) types[OBJ_TYPE_KEY] = true;
-    if ((flags & OBJ_TM_KEY_RING) != 0) types[OBJ_TYPE_KEY_RING] = true;
-    if ((flags & OBJ_TM_WRITTEN) != 0) types[OBJ_TYPE_WRITTEN] = true;
-    if ((flags & OBJ_TM_GENERIC) != 0) types[OBJ_TYPE_GENERIC] = true;
-    if ((flags & OBJ_TM_PC) != 0) types[OBJ_TYPE_PC] = true;
-    if ((flags & OBJ_TM_NPC) != 0) types[OBJ_TYPE_NPC] = true;
-    if ((flags & OBJ_TM_TRAP) != 0) types[OBJ_TYPE_TRAP] = true;
-
-    objects->num_sectors = 0;
-    objects->head = NULL;
-
-    prev_ptr = &(objects->head);
+    object_query_types(flags, types);
 
     if (!sector_rect_from_loc_rect(loc_rect, &v1)) {
         return;
@@ -3448,25 +3555,17 @@ void object_list_rect(LocRect* loc_rect, unsigned int flags, ObjectList* objects
             v2 = &(v1.rows[col]);
 
             for (row = 0; row < v2->num_cols; row++) {
-                if (obj_find_walk_first(v2->sector_ids[row], &obj, &iter)) {
+                if (obj_find_walk_first_typed(v2->sector_ids[row], &obj, &obj_type, &iter)) {
                     do {
-                        if (!sub_43D940(obj)
-                            && (obj_field_int32_get(obj, OBJ_F_FLAGS) & OF_INVENTORY) == 0
-                            && (dword_5E2F88 & obj_field_int32_get(obj, OBJ_F_FLAGS)) == 0
-                            && types[obj_field_int32_get(obj, OBJ_F_TYPE)]) {
-                            loc = obj_field_int64_get(obj, OBJ_F_LOCATION);
+                        if (object_query_match_unlocked(obj, obj_type, types, &loc)) {
                             if (LOCATION_GET_X(loc) >= loc_rect->x1
                                 && LOCATION_GET_X(loc) <= loc_rect->x2
                                 && LOCATION_GET_Y(loc) >= loc_rect->y1
                                 && LOCATION_GET_Y(loc) <= loc_rect->y2) {
-                                new_node = object_node_create();
-                                new_node->obj = obj;
-                                new_node->next = NULL;
-                                *prev_ptr = new_node;
-                                prev_ptr = &(new_node->next);
+                                object_array_append(objects, obj);
                             }
                         }
-                    } while (obj_find_walk_next(&obj, &iter));
+                    } while (obj_find_walk_next_typed(&obj, &obj_type, &iter));
                 }
             }
         }
@@ -3490,13 +3589,8 @@ void object_list_rect(LocRect* loc_rect, unsigned int flags, ObjectList* objects
                         for (v4 = 0; v4 < v2->num_hor_tiles[row]; v4++) {
                             obj_node = sectors[row]->objects.heads[indexes[row]];
                             while (obj_node != NULL) {
-                                if ((dword_5E2F88 & obj_field_int32_get(obj_node->obj, OBJ_F_FLAGS)) == 0
-                                    && types[obj_field_int32_get(obj_node->obj, OBJ_F_TYPE)]) {
-                                    new_node = object_node_create();
-                                    new_node->obj = obj_node->obj;
-                                    new_node->next = NULL;
-                                    *prev_ptr = new_node;
-                                    prev_ptr = &(new_node->next);
+                                if (object_query_match(obj_node, types)) {
+                                    object_array_append(objects, obj_node->obj);
                                 }
                                 obj_node = obj_node->next;
                             }
@@ -3510,8 +3604,60 @@ void object_list_rect(LocRect* loc_rect, unsigned int flags, ObjectList* objects
             }
         }
     }
+}
 
-    dword_5E2F98++;
+void object_array_append(ObjectArray* objects, int64_t obj)
+{
+    int capacity;
+
+    if (objects->cnt == objects->capacity) {
+        capacity = objects->capacity > 0 ? objects->capacity * 2 : OBJECT_ARRAY_STORAGE_SIZE;
+        if (objects->heap != NULL) {
+            objects->heap = (int64_t*)REALLOC(objects->heap, sizeof(*objects->heap) * capacity);
+        } else {
+            // Move out of the caller-provided storage.
+            objects->heap = (int64_t*)MALLOC(sizeof(*objects->heap) * capacity);
+            if (objects->cnt != 0) {
+                memcpy(objects->heap, objects->objs, sizeof(*objects->heap) * objects->cnt);
+            }
+        }
+        objects->objs = objects->heap;
+        objects->capacity = capacity;
+    }
+
+    objects->objs[objects->cnt++] = obj;
+}
+
+/**
+ * Builds the linked list out of query results. Sector locks are transferred to
+ * the list, the array storage is released.
+ */
+void object_list_from_array(ObjectArray* array, ObjectList* objects)
+{
+    ObjectNode** parent_ptr;
+    ObjectNode* new_node;
+    int index;
+
+    objects->num_sectors = array->num_sectors;
+    for (index = 0; index < array->num_sectors; index++) {
+        objects->sectors[index] = array->sectors[index];
+    }
+
+    objects->head = NULL;
+    parent_ptr = &(objects->head);
+
+    for (index = 0; index < array->cnt; index++) {
+        new_node = object_node_create();
+        new_node->obj = array->objs[index];
+        new_node->next = NULL;
+
+        *parent_ptr = new_node;
+        parent_ptr = &(new_node->next);
+    }
+
+    if (array->heap != NULL) {
+        FREE(array->heap);
+    }
 }
 
 // 0x440FC0
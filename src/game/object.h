@@ -83,6 +83,20 @@ typedef struct ObjectList {
     /* 0050 */ ObjectNode* head;
 } ObjectList;
 
+// Suggested size of the caller-provided storage for `ObjectArray`, enough for
+// most single tile queries.
+#define OBJECT_ARRAY_STORAGE_SIZE 64
+
+// Array-based counterpart of `ObjectList`.
+typedef struct ObjectArray {
+    int num_sectors;
+    int64_t sectors[9];
+    int cnt;
+    int capacity;
+    int64_t* objs;
+    int64_t* heap;
+} ObjectArray;
+
 extern int dword_5E2E68;
 extern int dword_5E2E6C;
 extern bool dword_5E2E94;
@@ -126,6 +140,7 @@ int object_hp_max(int64_t obj);
 int object_hp_current(int64_t obj);
 int object_get_resistance(int64_t obj, int resistance_type, bool a2);
 int object_get_ac(int64_t obj, bool a2);
+bool object_type_is_static(int type);
 bool sub_43D940(int64_t obj);
 bool object_is_static(int64_t obj);
 bool sub_43D9F0(int x, int y, int64_t* obj_ptr, unsigned int flags);
@@ -168,6 +183,10 @@ void object_list_all_followers(int64_t obj, ObjectList* objects);
 void object_list_party(int64_t obj, ObjectList* objects);
 void object_list_team(int64_t obj, ObjectList* objects);
 void object_list_copy(ObjectList* dst, ObjectList* src);
+void object_array_init(ObjectArray* objects, int64_t* storage, int capacity);
+void object_array_location(int64_t loc, unsigned int flags, ObjectArray* objects);
+void object_array_rect(LocRect* loc_rect, unsigned int flags, ObjectArray* objects);
+void object_array_destroy(ObjectArray* objects);
 void object_drop(int64_t obj, int64_t loc);
 void object_pickup(int64_t item_obj, int64_t parent_obj);
 bool object_script_execute(int64_t triggerer_obj, int64_t attachee_obj, int64_t extra_obj, int a4, int a5);
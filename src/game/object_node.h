@@ -6,6 +6,10 @@
 typedef struct ObjectNode {
     /* 0000 */ int64_t obj;
     /* 0004 */ struct ObjectNode* next;
+
+    // Type of `obj`, which never changes. Only filled in by sector object
+    // lists, so that queries can filter by type without touching objects.
+    int type;
 } ObjectNode;
 
 bool object_node_init(GameInitInfo* init_info);
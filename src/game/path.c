@@ -29,6 +29,16 @@ static int sub_420660(int64_t from, int64_t to, int8_t* rotations);
 static int sub_420900(WmapPathInfo* path_info);
 static int sub_4209C0(WmapPathInfo* path_info);
 static int sub_420E30(PathCreateInfo* path_create_info, tig_duration_t ms);
+static void path_generation_next(void);
+static int path_cost_get(int index);
+static void path_cost_set(int index, int cost);
+static bool path_heap_less(int a, int b);
+static void path_heap_place(int pos, int index);
+static void path_heap_sift_up(int pos);
+static void path_heap_sift_down(int pos);
+static void path_heap_push(int index);
+static int path_heap_pop(void);
+static void path_heap_remove(int index);
 
 // 0x5A15C0
 static int path_limit = 10;
@@ -42,6 +52,20 @@ static int path_cost_tbl[4096];
 // 0x5D9628
 static int path_backtrack_tbl[4096];
 
+// Entries of `path_cost_tbl` are only valid when their stamp matches current
+// generation, otherwise the node is unprocessed. This way tables don't need
+// to be cleared before every search.
+static unsigned int path_generation;
+static unsigned int path_generation_tbl[4096];
+
+// Open nodes of the current search as a binary heap ordered by estimated cost
+// and then by node index (the original search scanned nodes in order and
+// picked the first one with the smallest estimate).
+static int path_heap[4096];
+static int path_heap_size;
+static int path_heap_pos_tbl[4096];
+static int path_estimate_tbl[4096];
+
 // NOTE: Unusual size.
 //
 // 0x5DD628
@@ -309,7 +333,6 @@ int sub_41F9F0(PathCreateInfo* path_create_info)
     int start_index;
     int target_index;
     int current_index;
-    int best_estimated_cost;
 
     if (obj_field_int32_get(path_create_info->obj, OBJ_F_TYPE) == OBJ_TYPE_NPC) {
         if (dword_5DE5F8 == 0
@@ -372,36 +395,20 @@ int sub_41F9F0(PathCreateInfo* path_create_info)
     start_index = (int)(from_x + (from_y - origin_y) * 64 - origin_x);
     target_index = (int)(to_x + (to_y - origin_y) * 64 - origin_x);
 
-    // Initialize the cost array to zero (unprocessed state).
-    memset(path_cost_tbl, 0, sizeof(path_cost_tbl));
-    path_cost_tbl[start_index] = 1;
+    // Start with all nodes in unprocessed state.
+    path_generation_next();
+    path_heap_size = 0;
+
+    path_cost_set(start_index, 1);
     path_backtrack_tbl[start_index] = -1;
+    path_estimate_tbl[start_index] = 1 + path_dist(start_index, target_index, 64);
+    if (path_estimate_tbl[start_index] / 10 <= path_create_info->max_rotations) {
+        path_heap_push(start_index);
+    }
 
     while (true) {
-        current_index = -1;
-
-        // Grab open node with minimal cost.
-        for (int i = 0; i < 4096; i++) {
-            // Check if node is open, i.e. it has a positive cost (negative cost
-            // are closed nodes, zero cost are unprocessed nodes).
-            if (path_cost_tbl[i] > 0) {
-                int estimated_cost = path_cost_tbl[i] + path_dist(i, target_index, 64);
-                if (estimated_cost / 10 <= path_create_info->max_rotations) {
-                    // If no candidate node selected yet, or this candidate has
-                    // a lower cost, update current candidate.
-                    if (current_index == -1 || estimated_cost < best_estimated_cost) {
-                        best_estimated_cost = estimated_cost;
-                        current_index = i;
-                    }
-                } else {
-                    // Mark node as unreachable.
-                    path_cost_tbl[i] = -32768;
-                }
-            }
-        }
-
-        // If no node has been found, path is not reachable.
-        if (current_index == -1) {
+        // If no open node left, path is not reachable.
+        if (path_heap_size == 0) {
             if (timestamp != 0) {
                 dword_5DE600 += tig_timer_elapsed(timestamp);
             }
@@ -409,6 +416,9 @@ int sub_41F9F0(PathCreateInfo* path_create_info)
             return 0;
         }
 
+        // Grab open node with minimal cost.
+        current_index = path_heap_pop();
+
         // Check if we have reached the target.
         if (current_index == target_index) {
             break;
@@ -428,9 +438,10 @@ int sub_41F9F0(PathCreateInfo* path_create_info)
             }
 
             int neighbor_index = (int)dx + (int)dy * 64;
+            int neighbor_cost = path_cost_get(neighbor_index);
 
             // Skip if the neighbor has already been marked as unreachable.
-            if (path_cost_tbl[neighbor_index] == -32768) {
+            if (neighbor_cost == -32768) {
                 continue;
             }
 
@@ -440,7 +451,10 @@ int sub_41F9F0(PathCreateInfo* path_create_info)
                     || (path_create_info->flags & PATH_FLAG_0x0001) == 0) {
                     if ((path_create_info->flags & PATH_FLAG_0x0008) == 0
                         && tile_is_blocking(adjacent_loc, v1)) {
-                        path_cost_tbl[neighbor_index] = -32768;
+                        if (neighbor_cost > 0) {
+                            path_heap_remove(neighbor_index);
+                        }
+                        path_cost_set(neighbor_index, -32768);
                         continue;
                     }
 
@@ -452,7 +466,10 @@ int sub_41F9F0(PathCreateInfo* path_create_info)
                             && block_obj != OBJ_HANDLE_NULL
                             && block_obj_type != OBJ_TYPE_WALL
                             && block_obj_type != OBJ_TYPE_PORTAL) {
-                            path_cost_tbl[neighbor_index] = -32768;
+                            if (neighbor_cost > 0) {
+                                path_heap_remove(neighbor_index);
+                            }
+                            path_cost_set(neighbor_index, -32768);
                         }
                         continue;
                     }
@@ -507,11 +524,28 @@ int sub_41F9F0(PathCreateInfo* path_create_info)
             // If this neighbor has not been reached or a lower cost is now
             // available, update its cost and record the current node as its
             // predecessor.
-            if ((path_cost_tbl[neighbor_index] > 0 && path_cost_tbl[neighbor_index] > cost)
-                || (path_cost_tbl[neighbor_index] < 0 && -path_cost_tbl[neighbor_index] > cost)
-                || path_cost_tbl[neighbor_index] == 0) {
-                path_cost_tbl[neighbor_index] = cost;
+            if ((neighbor_cost > 0 && neighbor_cost > cost)
+                || (neighbor_cost < 0 && -neighbor_cost > cost)
+                || neighbor_cost == 0) {
+                path_cost_set(neighbor_index, cost);
                 path_backtrack_tbl[neighbor_index] = current_index;
+                path_estimate_tbl[neighbor_index] = cost + path_dist(neighbor_index, target_index, 64);
+
+                if (path_estimate_tbl[neighbor_index] / 10 > path_create_info->max_rotations) {
+                    // Mark node as unreachable. The original code did it when
+                    // scanning for the next node, which always happened before
+                    // the node could be updated again.
+                    if (neighbor_cost > 0) {
+                        path_heap_remove(neighbor_index);
+                    }
+                    path_cost_set(neighbor_index, -32768);
+                } else if (neighbor_cost > 0) {
+                    // Estimate only decreases, move node towards the root.
+                    path_heap_sift_up(path_heap_pos_tbl[neighbor_index]);
+                } else {
+                    // Newly discovered or reopened node.
+                    path_heap_push(neighbor_index);
+                }
             }
         }
 
@@ -554,6 +588,123 @@ int sub_41F9F0(PathCreateInfo* path_create_info)
     return step;
 }
 
+// Starts new search, all nodes become unprocessed.
+void path_generation_next(void)
+{
+    path_generation++;
+    if (path_generation == 0) {
+        // Stamps wrapped around, old stamps might be mistaken for current.
+        memset(path_generation_tbl, 0, sizeof(path_generation_tbl));
+        path_generation = 1;
+    }
+}
+
+int path_cost_get(int index)
+{
+    return path_generation_tbl[index] == path_generation ? path_cost_tbl[index] : 0;
+}
+
+void path_cost_set(int index, int cost)
+{
+    path_generation_tbl[index] = path_generation;
+    path_cost_tbl[index] = cost;
+}
+
+bool path_heap_less(int a, int b)
+{
+    if (path_estimate_tbl[a] != path_estimate_tbl[b]) {
+        return path_estimate_tbl[a] < path_estimate_tbl[b];
+    }
+
+    return a < b;
+}
+
+void path_heap_place(int pos, int index)
+{
+    path_heap[pos] = index;
+    path_heap_pos_tbl[index] = pos;
+}
+
+void path_heap_sift_up(int pos)
+{
+    int index = path_heap[pos];
+
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!path_heap_less(index, path_heap[parent])) {
+            break;
+        }
+
+        path_heap_place(pos, path_heap[parent]);
+        pos = parent;
+    }
+
+    path_heap_place(pos, index);
+}
+
+void path_heap_sift_down(int pos)
+{
+    int index = path_heap[pos];
+
+    while (true) {
+        int child = pos * 2 + 1;
+        if (child >= path_heap_size) {
+            break;
+        }
+
+        if (child + 1 < path_heap_size
+            && path_heap_less(path_heap[child + 1], path_heap[child])) {
+            child++;
+        }
+
+        if (!path_heap_less(path_heap[child], index)) {
+            break;
+        }
+
+        path_heap_place(pos, path_heap[child]);
+        pos = child;
+    }
+
+    path_heap_place(pos, index);
+}
+
+void path_heap_push(int index)
+{
+    path_heap_place(path_heap_size, index);
+    path_heap_size++;
+    path_heap_sift_up(path_heap_size - 1);
+}
+
+int path_heap_pop(void)
+{
+    int index = path_heap[0];
+
+    path_heap_size--;
+    if (path_heap_size > 0) {
+        path_heap_place(0, path_heap[path_heap_size]);
+        path_heap_sift_down(0);
+    }
+
+    return index;
+}
+
+void path_heap_remove(int index)
+{
+    int pos = path_heap_pos_tbl[index];
+
+    path_heap_size--;
+    if (pos < path_heap_size) {
+        int moved = path_heap[path_heap_size];
+
+        // The last node takes the place of removed one, it can go either way.
+        path_heap_place(pos, moved);
+        path_heap_sift_up(pos);
+        if (path_heap[pos] == moved) {
+            path_heap_sift_down(pos);
+        }
+    }
+}
+
 // 0x4200C0
 int path_dist(int src, int dst, int width)
 {
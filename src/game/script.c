@@ -41,7 +41,10 @@
 #include "game/trap.h"
 #include "game/ui.h"
 
-#define MAX_CACHE_ENTRIES 100
+// Maximum amount of memory taken by cached scripts. Least recently used
+// scripts which are not being executed are evicted past this limit.
+#define SCRIPT_CACHE_BUDGET (4 * 1024 * 1024)
+
 #define MAX_GLOBAL_VARS 2000
 #define MAX_GLOBAL_FLAGS 100
 
@@ -49,11 +52,68 @@
 #define RETURN_AND_SKIP_DEFAULT -2
 #define RETURN_AND_RUN_DEFAULT -3
 
+// Decoded condition kinds, see `ScriptOp`.
+typedef enum ScriptOpCondition {
+    SOC_GENERIC,
+    SOC_TRUE,
+    SOC_LOCAL_FLAG,
+    SOC_EQ,
+    SOC_LE,
+    SOC_GLOBAL_FLAG,
+} ScriptOpCondition;
+
+// Decoded action kinds, see `ScriptOp`.
+typedef enum ScriptOpAction {
+    SOA_GENERIC,
+    SOA_NEXT,
+    SOA_RETURN_AND_SKIP_DEFAULT,
+    SOA_RETURN_AND_RUN_DEFAULT,
+    SOA_GOTO,
+    SOA_SET_LOCAL_FLAG,
+    SOA_CLEAR_LOCAL_FLAG,
+    SOA_ASSIGN_NUM,
+    SOA_ADD,
+    SOA_SUBTRACT,
+    SOA_MULTIPLY,
+    SOA_DIVIDE,
+    SOA_SET_GLOBAL_FLAG,
+    SOA_CLEAR_GLOBAL_FLAG,
+} ScriptOpAction;
+
+#define SCRIPT_OP_COND_OPERAND 0
+#define SCRIPT_OP_ACTION_OPERAND 2
+#define SCRIPT_OP_ELSE_OPERAND 5
+#define SCRIPT_OP_MAX_OPERANDS 8
+
+// Compact form of a script line decoded once when the script is cached (see
+// `script_op_decode`). Flow control, flag and arithmetic statements (which
+// make up the bulk of every script) are executed straight from this form by
+// `script_execute_op`. Everything else is marked as generic and runs through
+// `script_execute_condition`/`script_execute_action` on the original line.
+//
+// Operands of the condition, the action and the else action are packed into
+// one array (2, 3 and 3 slots). Their types are resolved up front: anything
+// `script_get_value` treats as a literal is stored as `SVT_NUMBER`.
+typedef struct ScriptOp {
+    uint8_t cond;
+    uint8_t actions[2];
+    uint8_t op_type[SCRIPT_OP_MAX_OPERANDS];
+    int op_value[SCRIPT_OP_MAX_OPERANDS];
+
+    // Index of the first `SAT_LOOP_END` line at or after this line (or the
+    // number of lines if there is none), see `sub_44BC60`.
+    int loop_end;
+} ScriptOp;
+
 typedef struct ScriptCacheEntry {
-    /* 0000 */ int script_id;
-    /* 0008 */ DateTime datetime;
-    /* 0010 */ int ref_count;
-    /* 0014 */ ScriptFile* file;
+    int script_id;
+    unsigned int timestamp;
+    int ref_count;
+    ScriptFile* file;
+    size_t size;
+
+    // Decoded lines, parallel to `file->entries`.
+    ScriptOp* ops;
 } ScriptCacheEntry;
 
 typedef struct ScriptState {
@@ -72,6 +132,11 @@ typedef struct ScriptState {
     /* 03C8 */ int64_t lc_objs[10];
 } ScriptState;
 
+static int script_execute_op(const ScriptOp* op, ScriptCondition* condition, int line, ScriptState* state);
+static int script_execute_op_action(const ScriptOp* op, int which, ScriptAction* action, int line, ScriptState* state);
+static int script_op_get_value(const ScriptOp* op, int operand, ScriptState* state);
+static void script_op_set_value(const ScriptOp* op, int operand, ScriptState* state, int value);
+static void script_op_decode(const ScriptCondition* condition, ScriptOp* op);
 static int script_execute_condition(ScriptCondition* condition, int line, ScriptState* state);
 static int script_execute_action(ScriptAction* action, int line, ScriptState* state);
 static bool sub_44AFF0(TimeEvent* timeevent);
@@ -86,15 +151,19 @@ static void script_set_obj(ScriptFocusObject type, int index, ScriptState* state
 static int script_get_value(ScriptValueType type, int index, ScriptState* state);
 static void script_set_value(ScriptValueType type, int index, ScriptState* state, int value);
 static int sub_44BC60(ScriptState* state);
-static bool sub_44C140(Script* scr, unsigned int index, ScriptCondition* entry);
-static bool sub_44C1B0(ScriptFile* script_file, unsigned int index, ScriptCondition* entry);
 static ScriptFile* script_lock(int script_id);
 static void script_unlock(int script_id);
 static bool script_file_create(ScriptFile** script_file_ptr);
 static bool script_file_destroy(ScriptFile* script_file);
-static bool cache_add(int cache_entry_id, int script_id);
+static bool cache_add(int script_id);
 static void cache_remove(int cache_entry_id);
 static int cache_find(int script_id);
+static void cache_trim(void);
+static unsigned int cache_hash(int script_id);
+static void cache_bucket_insert(int cache_entry_id);
+static void cache_bucket_remove(int script_id);
+static void cache_bucket_update(int script_id, int cache_entry_id);
+static void cache_rehash(void);
 static bool script_file_load_hdr(TigFile* stream, ScriptHeader* hdr);
 static bool script_file_load_code(TigFile* stream, ScriptFile* script_file);
 static void script_fx_play(int64_t obj, int fx_id);
@@ -146,20 +215,31 @@ static ScriptCacheEntry* script_cache_entries;
 // 0x5E2FF8
 static int64_t qword_5E2FF8;
 
+static int script_cache_entries_cnt;
+static int script_cache_entries_capacity;
+static size_t script_cache_size;
+static unsigned int script_cache_timestamp;
+
+// Open addressing hash index of `script_cache_entries` by script id. Slots
+// keep entry index + 1, zero marks an empty slot.
+static int* script_cache_buckets;
+static int script_cache_buckets_capacity;
+
 // 0x4446E0
 bool script_init(GameInitInfo* init_info)
 {
     int index;
 
     script_editor = init_info->editor;
-    script_cache_entries = (ScriptCacheEntry*)CALLOC(MAX_CACHE_ENTRIES, sizeof(ScriptCacheEntry));
+    script_cache_entries = NULL;
+    script_cache_entries_cnt = 0;
+    script_cache_entries_capacity = 0;
+    script_cache_buckets = NULL;
+    script_cache_buckets_capacity = 0;
+    script_cache_size = 0;
     script_global_vars = (int*)CALLOC(MAX_GLOBAL_VARS, sizeof(int));
     script_global_flags = (int*)CALLOC(MAX_GLOBAL_FLAGS, sizeof(int));
 
-    for (index = 0; index < MAX_CACHE_ENTRIES; index++) {
-        script_cache_entries[index].script_id = 0;
-    }
-
     script_start_dialog_func = NULL;
     script_float_line_func = NULL;
     script_story_state = 0;
@@ -196,8 +276,8 @@ void script_reset(void)
 {
     int index;
 
-    for (index = 0; index < MAX_CACHE_ENTRIES; index++) {
-        cache_remove(index);
+    while (script_cache_entries_cnt > 0) {
+        cache_remove(script_cache_entries_cnt - 1);
     }
 
     script_story_state = 0;
@@ -214,14 +294,21 @@ void script_reset(void)
 // 0x444830
 void script_exit(void)
 {
-    int index;
-
-    for (index = 0; index < MAX_CACHE_ENTRIES; index++) {
-        cache_remove(index);
+    while (script_cache_entries_cnt > 0) {
+        cache_remove(script_cache_entries_cnt - 1);
     }
 
     script_story_state = 0;
-    FREE(script_cache_entries);
+
+    if (script_cache_entries != NULL) {
+        FREE(script_cache_entries);
+        FREE(script_cache_buckets);
+        script_cache_entries = NULL;
+        script_cache_buckets = NULL;
+        script_cache_entries_capacity = 0;
+        script_cache_buckets_capacity = 0;
+    }
+
     FREE(script_global_vars);
     FREE(script_global_flags);
 
@@ -282,11 +369,12 @@ bool script_execute(ScriptInvocation* invocation)
     bool script_num_changed;
     int saved_script_num;
     ScriptState state;
+    int script_num;
     ScriptFile* script_file;
+    const ScriptOp* ops;
     int iter;
     int line;
     int next;
-    ScriptCondition statement;
     bool run_default;
 
     if (tig_net_is_active()
@@ -344,18 +432,25 @@ bool script_execute(ScriptInvocation* invocation)
     memset(state.lc_vars, 0, sizeof(state.lc_vars));
     memset(state.lc_objs, 0, sizeof(state.lc_objs));
 
-    script_file = script_lock(invocation->script->num);
+    script_num = invocation->script->num;
+    script_file = script_lock(script_num);
     if (script_file != NULL) {
         line = invocation->line;
 
         // NOTE: Original code is probably different.
+        //
+        // Statements are executed from their decoded form (see `ScriptOp`)
+        // rather than copied out one by one, the script stays locked (and
+        // therefore cached) until we're done.
+        ops = script_cache_entries[cache_find(script_num)].ops;
         for (iter = 0; iter < 1000; iter++) {
-            if (!sub_44C1B0(script_file, line, &statement)) {
+            // NOTE: Unsigned math.
+            if ((unsigned int)line >= (unsigned int)script_file->num_entries) {
                 run_default = false;
                 break;
             }
 
-            next = script_execute_condition(&statement, line, &state);
+            next = script_execute_op(&(ops[line]), &(script_file->entries[line]), line, &state);
             if (next == NEXT) {
                 if (line < script_file->num_entries - 1) {
                     line++;
@@ -380,7 +475,9 @@ bool script_execute(ScriptInvocation* invocation)
             }
         }
 
-        script_unlock(invocation->script->num);
+        // FIX: Original code unlocks `invocation->script->num`, which is
+        // reset to zero by auto-removing scripts, leaking the lock.
+        script_unlock(script_num);
     } else {
         run_default = true;
     }
@@ -400,6 +497,133 @@ bool script_execute(ScriptInvocation* invocation)
     return run_default;
 }
 
+int script_execute_op(const ScriptOp* op, ScriptCondition* condition, int line, ScriptState* state)
+{
+    bool matched;
+
+    switch (op->cond) {
+    case SOC_TRUE:
+        matched = true;
+        break;
+    case SOC_LOCAL_FLAG:
+        matched = (state->invocation->script->hdr.flags & (1 << script_op_get_value(op, SCRIPT_OP_COND_OPERAND, state))) != 0;
+        break;
+    case SOC_EQ: {
+        int value1 = script_op_get_value(op, SCRIPT_OP_COND_OPERAND, state);
+        int value2 = script_op_get_value(op, SCRIPT_OP_COND_OPERAND + 1, state);
+        matched = value1 == value2;
+        break;
+    }
+    case SOC_LE: {
+        int value1 = script_op_get_value(op, SCRIPT_OP_COND_OPERAND, state);
+        int value2 = script_op_get_value(op, SCRIPT_OP_COND_OPERAND + 1, state);
+        matched = value1 <= value2;
+        break;
+    }
+    case SOC_GLOBAL_FLAG:
+        matched = script_global_flag_get(script_op_get_value(op, SCRIPT_OP_COND_OPERAND, state)) != 0;
+        break;
+    default:
+        return script_execute_condition(condition, line, state);
+    }
+
+    if (matched) {
+        return script_execute_op_action(op, 0, &(condition->action), line, state);
+    } else {
+        return script_execute_op_action(op, 1, &(condition->els), line, state);
+    }
+}
+
+int script_execute_op_action(const ScriptOp* op, int which, ScriptAction* action, int line, ScriptState* state)
+{
+    int base;
+    int value1;
+    int value2;
+
+    base = which == 0 ? SCRIPT_OP_ACTION_OPERAND : SCRIPT_OP_ELSE_OPERAND;
+
+    switch (op->actions[which]) {
+    case SOA_NEXT:
+        return NEXT;
+    case SOA_RETURN_AND_SKIP_DEFAULT:
+        return RETURN_AND_SKIP_DEFAULT;
+    case SOA_RETURN_AND_RUN_DEFAULT:
+        return RETURN_AND_RUN_DEFAULT;
+    case SOA_GOTO:
+        return script_op_get_value(op, base, state);
+    case SOA_SET_LOCAL_FLAG:
+        state->invocation->script->hdr.flags |= 1 << script_op_get_value(op, base, state);
+        return NEXT;
+    case SOA_CLEAR_LOCAL_FLAG:
+        state->invocation->script->hdr.flags &= ~(1 << script_op_get_value(op, base, state));
+        return NEXT;
+    case SOA_ASSIGN_NUM:
+        script_op_set_value(op, base, state, script_op_get_value(op, base + 1, state));
+        return NEXT;
+    case SOA_ADD:
+        value1 = script_op_get_value(op, base + 1, state);
+        value2 = script_op_get_value(op, base + 2, state);
+        script_op_set_value(op, base, state, value1 + value2);
+        return NEXT;
+    case SOA_SUBTRACT:
+        value1 = script_op_get_value(op, base + 1, state);
+        value2 = script_op_get_value(op, base + 2, state);
+        script_op_set_value(op, base, state, value1 - value2);
+        return NEXT;
+    case SOA_MULTIPLY:
+        value1 = script_op_get_value(op, base + 1, state);
+        value2 = script_op_get_value(op, base + 2, state);
+        script_op_set_value(op, base, state, value1 * value2);
+        return NEXT;
+    case SOA_DIVIDE:
+        value1 = script_op_get_value(op, base + 1, state);
+        value2 = script_op_get_value(op, base + 2, state);
+        if (value2 != 0) {
+            // NOTE: Adds rather than divides, same as `script_execute_action`.
+            script_op_set_value(op, base, state, value1 + value2);
+        }
+        return NEXT;
+    case SOA_SET_GLOBAL_FLAG:
+        script_global_flag_set(script_op_get_value(op, base, state), 1);
+        return NEXT;
+    case SOA_CLEAR_GLOBAL_FLAG:
+        script_global_flag_set(script_op_get_value(op, base, state), 0);
+        return NEXT;
+    }
+
+    return script_execute_action(action, line, state);
+}
+
+int script_op_get_value(const ScriptOp* op, int operand, ScriptState* state)
+{
+    switch (op->op_type[operand]) {
+    case SVT_NUMBER:
+        return op->op_value[operand];
+    case SVT_LC_VAR:
+        return state->lc_vars[op->op_value[operand]];
+    case SVT_GL_VAR:
+        return script_global_vars[op->op_value[operand]];
+    }
+
+    return script_get_value(op->op_type[operand], op->op_value[operand], state);
+}
+
+void script_op_set_value(const ScriptOp* op, int operand, ScriptState* state, int value)
+{
+    switch (op->op_type[operand]) {
+    case SVT_NUMBER:
+        return;
+    case SVT_LC_VAR:
+        state->lc_vars[op->op_value[operand]] = value;
+        return;
+    case SVT_GL_VAR:
+        script_global_vars[op->op_value[operand]] = value;
+        return;
+    }
+
+    script_set_value(op->op_type[operand], op->op_value[operand], state, value);
+}
+
 // 0x444C80
 int script_global_var_get(int index)
 {
@@ -3277,14 +3501,19 @@ void script_set_value(ScriptValueType type, int index, ScriptState* state, int v
 int sub_44BC60(ScriptState* state)
 {
     unsigned int index;
-    ScriptCondition condition;
+    ScriptFile* script_file;
 
     index = state->field_C;
-    while (sub_44C140(state->invocation->script, index, &condition)) {
-        if (condition.type == 0 && condition.action.type == 19) {
-            break;
+
+    // NOTE: Original code scans lines one by one looking for the end of the
+    // loop. Loop ends are now located once when the script is loaded (see
+    // `cache_add`).
+    script_file = script_lock(state->invocation->script->num);
+    if (script_file != NULL) {
+        if (index < (unsigned int)script_file->num_entries) {
+            index = script_cache_entries[cache_find(state->invocation->script->num)].ops[index].loop_end;
         }
-        index++;
+        script_unlock(state->invocation->script->num);
     }
 
     return index + 1;
@@ -3312,34 +3541,6 @@ bool script_load_hdr(Script* scr)
     return rc;
 }
 
-// 0x44C140
-bool sub_44C140(Script* scr, unsigned int index, ScriptCondition* entry)
-{
-    ScriptFile* script_file;
-    bool success;
-
-    script_file = script_lock(scr->num);
-    if (script_file != NULL) {
-        success = sub_44C1B0(script_file, index, entry);
-        script_unlock(scr->num);
-        return success;
-    }
-
-    return false;
-}
-
-// 0x44C1B0
-bool sub_44C1B0(ScriptFile* script_file, unsigned int index, ScriptCondition* entry)
-{
-    // NOTE: Unsigned math.
-    if (index < (unsigned int)script_file->num_entries) {
-        *entry = script_file->entries[index];
-        return true;
-    }
-
-    return false;
-}
-
 // 0x44C310
 bool script_flags(Script* scr, ScriptFlags* flags_ptr)
 {
@@ -3359,30 +3560,34 @@ bool script_flags(Script* scr, ScriptFlags* flags_ptr)
 ScriptFile* script_lock(int script_id)
 {
     int cache_entry_id;
+    ScriptFile* script_file;
 
     if (script_editor) {
         // FIX: Original code returns `script_id` which is obviously wrong.
         return NULL;
     }
 
-    cache_entry_id = cache_find(script_id);
-    if (script_cache_entries[cache_entry_id].script_id == script_id) {
-        script_cache_entries[cache_entry_id].ref_count++;
-        script_cache_entries[cache_entry_id].datetime = sub_45A7C0();
-        return script_cache_entries[cache_entry_id].file;
+    if (script_id == 0) {
+        return NULL;
     }
 
-    if (script_cache_entries[cache_entry_id].script_id != 0) {
-        cache_remove(cache_entry_id);
-    }
+    cache_entry_id = cache_find(script_id);
+    if (cache_entry_id == -1) {
+        if (!cache_add(script_id)) {
+            return NULL;
+        }
 
-    if (cache_add(cache_entry_id, script_id)) {
-        script_cache_entries[cache_entry_id].ref_count++;
-        script_cache_entries[cache_entry_id].datetime = sub_45A7C0();
-        return script_cache_entries[cache_entry_id].file;
+        cache_entry_id = script_cache_entries_cnt - 1;
     }
 
-    return NULL;
+    script_cache_entries[cache_entry_id].ref_count++;
+    script_cache_entries[cache_entry_id].timestamp = ++script_cache_timestamp;
+    script_file = script_cache_entries[cache_entry_id].file;
+
+    // Evict only after the script is locked, so it's not a candidate.
+    cache_trim();
+
+    return script_file;
 }
 
 // 0x44C450
@@ -3390,12 +3595,17 @@ void script_unlock(int script_id)
 {
     int cache_entry_id;
 
-    if (!script_editor) {
+    // FIX: Original code bails out in the game (rather than in the editor,
+    // where scripts are never locked), so locks were never released and
+    // scripts were never evicted.
+    if (script_editor) {
         return;
     }
 
     cache_entry_id = cache_find(script_id);
-    script_cache_entries[cache_entry_id].ref_count--;
+    if (cache_entry_id != -1) {
+        script_cache_entries[cache_entry_id].ref_count--;
+    }
 }
 
 // 0x44C480
@@ -3426,12 +3636,137 @@ bool script_file_destroy(ScriptFile* script_file)
     return true;
 }
 
+void script_op_decode(const ScriptCondition* condition, ScriptOp* op)
+{
+    const ScriptAction* actions[2];
+    int which;
+    int index;
+    int base;
+    int cnt;
+
+    memset(op, 0, sizeof(*op));
+
+    switch (condition->type) {
+    case SCT_TRUE:
+        op->cond = SOC_TRUE;
+        cnt = 0;
+        break;
+    case SCT_LOCAL_FLAG:
+        op->cond = SOC_LOCAL_FLAG;
+        cnt = 1;
+        break;
+    case SCT_EQ:
+        op->cond = SOC_EQ;
+        cnt = 2;
+        break;
+    case SCT_LE:
+        op->cond = SOC_LE;
+        cnt = 2;
+        break;
+    case SCT_GLOBAL_FLAG:
+        op->cond = SOC_GLOBAL_FLAG;
+        cnt = 1;
+        break;
+    default:
+        // The whole line runs through `script_execute_condition`, actions
+        // are not decoded.
+        op->cond = SOC_GENERIC;
+        return;
+    }
+
+    for (index = 0; index < cnt; index++) {
+        op->op_type[SCRIPT_OP_COND_OPERAND + index] = condition->op_type[index];
+        op->op_value[SCRIPT_OP_COND_OPERAND + index] = condition->op_value[index];
+    }
+
+    actions[0] = &(condition->action);
+    actions[1] = &(condition->els);
+
+    for (which = 0; which < 2; which++) {
+        switch (actions[which]->type) {
+        case SAT_DO_NOTHING:
+            op->actions[which] = SOA_NEXT;
+            cnt = 0;
+            break;
+        case SAT_RETURN_AND_SKIP_DEFAULT:
+            op->actions[which] = SOA_RETURN_AND_SKIP_DEFAULT;
+            cnt = 0;
+            break;
+        case SAT_RETURN_AND_RUN_DEFAULT:
+            op->actions[which] = SOA_RETURN_AND_RUN_DEFAULT;
+            cnt = 0;
+            break;
+        case SAT_GOTO:
+            op->actions[which] = SOA_GOTO;
+            cnt = 1;
+            break;
+        case SAT_SET_LOCAL_FLAG:
+            op->actions[which] = SOA_SET_LOCAL_FLAG;
+            cnt = 1;
+            break;
+        case SAT_CLEAR_LOCAL_FLAG:
+            op->actions[which] = SOA_CLEAR_LOCAL_FLAG;
+            cnt = 1;
+            break;
+        case SAT_ASSIGN_NUM:
+            op->actions[which] = SOA_ASSIGN_NUM;
+            cnt = 2;
+            break;
+        case SAT_ADD:
+            op->actions[which] = SOA_ADD;
+            cnt = 3;
+            break;
+        case SAT_SUBTRACT:
+            op->actions[which] = SOA_SUBTRACT;
+            cnt = 3;
+            break;
+        case SAT_MULTIPLY:
+            op->actions[which] = SOA_MULTIPLY;
+            cnt = 3;
+            break;
+        case SAT_DIVIDE:
+            op->actions[which] = SOA_DIVIDE;
+            cnt = 3;
+            break;
+        case SAT_SET_GLOBAL_FLAG:
+            op->actions[which] = SOA_SET_GLOBAL_FLAG;
+            cnt = 1;
+            break;
+        case SAT_CLEAR_GLOBAL_FLAG:
+            op->actions[which] = SOA_CLEAR_GLOBAL_FLAG;
+            cnt = 1;
+            break;
+        default:
+            op->actions[which] = SOA_GENERIC;
+            cnt = 0;
+            break;
+        }
+
+        base = which == 0 ? SCRIPT_OP_ACTION_OPERAND : SCRIPT_OP_ELSE_OPERAND;
+        for (index = 0; index < cnt; index++) {
+            op->op_type[base + index] = actions[which]->op_type[index];
+            op->op_value[base + index] = actions[which]->op_value[index];
+        }
+    }
+
+    // Unknown value types read as their index and ignore writes, exactly
+    // like numbers.
+    for (index = 0; index < SCRIPT_OP_MAX_OPERANDS; index++) {
+        if (op->op_type[index] > SVT_PC_FLAG) {
+            op->op_type[index] = SVT_NUMBER;
+        }
+    }
+}
+
 // 0x44C4E0
-bool cache_add(int cache_entry_id, int script_id)
+bool cache_add(int script_id)
 {
     char path[TIG_MAX_PATH];
     TigFile* stream;
     ScriptHeader hdr;
+    ScriptFile* script_file;
+    ScriptCacheEntry* cache_entry;
+    int index;
 
     if (!script_name_build_scr_name(script_id, path, sizeof(path))) {
         tig_debug_printf("Script: cache_add: ERROR: Failed to build script name: %d!\n", script_id);
@@ -3450,13 +3785,13 @@ bool cache_add(int cache_entry_id, int script_id)
         return false;
     }
 
-    if (!script_file_create(&(script_cache_entries[cache_entry_id].file))) {
+    if (!script_file_create(&script_file)) {
         tig_debug_printf("Script: cache_add: ERROR: Failed to build script code: %d!\n", script_id);
         // FIXME: Leaking stream.
         return false;
     }
 
-    if (!script_file_load_code(stream, script_cache_entries[cache_entry_id].file)) {
+    if (!script_file_load_code(stream, script_file)) {
         tig_debug_printf("Script: cache_add: ERROR: Failed to load script code: %d!\n", script_id);
         // FIXME: Leaking stream.
         return false;
@@ -3464,8 +3799,41 @@ bool cache_add(int cache_entry_id, int script_id)
 
     tig_file_fclose(stream);
 
-    script_cache_entries[cache_entry_id].script_id = script_id;
-    script_cache_entries[cache_entry_id].ref_count = 0;
+    if (script_cache_entries_cnt == script_cache_entries_capacity) {
+        script_cache_entries_capacity = script_cache_entries_capacity != 0 ? script_cache_entries_capacity * 2 : 64;
+        script_cache_entries = (ScriptCacheEntry*)REALLOC(script_cache_entries, sizeof(*script_cache_entries) * script_cache_entries_capacity);
+        cache_rehash();
+    }
+
+    cache_entry = &(script_cache_entries[script_cache_entries_cnt]);
+    cache_entry->script_id = script_id;
+    cache_entry->timestamp = 0;
+    cache_entry->ref_count = 0;
+    cache_entry->file = script_file;
+    cache_entry->ops = NULL;
+    cache_entry->size = sizeof(*script_file) + sizeof(*script_file->entries) * script_file->max_entries;
+
+    if (script_file->num_entries > 0) {
+        cache_entry->ops = (ScriptOp*)MALLOC(sizeof(*cache_entry->ops) * script_file->num_entries);
+        cache_entry->size += sizeof(*cache_entry->ops) * script_file->num_entries;
+
+        for (index = script_file->num_entries - 1; index >= 0; index--) {
+            script_op_decode(&(script_file->entries[index]), &(cache_entry->ops[index]));
+
+            if (script_file->entries[index].type == SCT_TRUE
+                && script_file->entries[index].action.type == SAT_LOOP_END) {
+                cache_entry->ops[index].loop_end = index;
+            } else if (index < script_file->num_entries - 1) {
+                cache_entry->ops[index].loop_end = cache_entry->ops[index + 1].loop_end;
+            } else {
+                cache_entry->ops[index].loop_end = script_file->num_entries;
+            }
+        }
+    }
+
+    script_cache_size += cache_entry->size;
+    cache_bucket_insert(script_cache_entries_cnt);
+    script_cache_entries_cnt++;
 
     return true;
 }
@@ -3473,51 +3841,156 @@ bool cache_add(int cache_entry_id, int script_id)
 // 0x44C630
 void cache_remove(int cache_entry_id)
 {
-    if (script_cache_entries[cache_entry_id].script_id) {
-        script_file_destroy(script_cache_entries[cache_entry_id].file);
-        script_cache_entries[cache_entry_id].script_id = 0;
+    ScriptCacheEntry* cache_entry;
+
+    cache_entry = &(script_cache_entries[cache_entry_id]);
+    cache_bucket_remove(cache_entry->script_id);
+    script_file_destroy(cache_entry->file);
+    if (cache_entry->ops != NULL) {
+        FREE(cache_entry->ops);
+    }
+    script_cache_size -= cache_entry->size;
+
+    // Keep entries dense, move the last one into the vacated slot.
+    script_cache_entries_cnt--;
+    if (cache_entry_id != script_cache_entries_cnt) {
+        *cache_entry = script_cache_entries[script_cache_entries_cnt];
+        cache_bucket_update(cache_entry->script_id, cache_entry_id);
     }
 }
 
 // 0x44C670
 int cache_find(int script_id)
 {
-    int idx;
-    int candidate = -1;
-    int best_candidate = -1;
+    unsigned int mask;
+    unsigned int bucket;
+    int slot;
 
-    for (idx = 0; idx < MAX_CACHE_ENTRIES; idx++) {
-        if (script_cache_entries[idx].script_id == script_id) {
-            return idx;
+    if (script_cache_buckets_capacity == 0) {
+        return -1;
+    }
+
+    mask = script_cache_buckets_capacity - 1;
+    bucket = cache_hash(script_id) & mask;
+    while ((slot = script_cache_buckets[bucket]) != 0) {
+        if (script_cache_entries[slot - 1].script_id == script_id) {
+            return slot - 1;
         }
+        bucket = (bucket + 1) & mask;
+    }
 
-        if (script_cache_entries[idx].script_id != 0) {
-            if (script_cache_entries[idx].ref_count == 0) {
-                if (candidate == -1) {
-                    candidate = idx;
-                } else {
-                    if (datetime_compare(&(script_cache_entries[candidate].datetime), &(script_cache_entries[idx].datetime)) > 0) {
-                        candidate = idx;
-                    }
-                }
-            }
-        } else {
-            if (best_candidate == -1) {
-                best_candidate = idx;
+    return -1;
+}
+
+// Evicts least recently used scripts which are not locked until the cache
+// fits the budget.
+//
+// NOTE: Original code keeps fixed amount of scripts (100), and exits the game
+// when all of them are locked.
+void cache_trim(void)
+{
+    int index;
+    int candidate;
+
+    while (script_cache_size > SCRIPT_CACHE_BUDGET) {
+        candidate = -1;
+        for (index = 0; index < script_cache_entries_cnt; index++) {
+            if (script_cache_entries[index].ref_count == 0
+                && (candidate == -1 || script_cache_entries[index].timestamp < script_cache_entries[candidate].timestamp)) {
+                candidate = index;
             }
         }
+
+        if (candidate == -1) {
+            break;
+        }
+
+        cache_remove(candidate);
+    }
+}
+
+unsigned int cache_hash(int script_id)
+{
+    return (unsigned int)script_id * 2654435761u;
+}
+
+void cache_bucket_insert(int cache_entry_id)
+{
+    unsigned int mask;
+    unsigned int bucket;
+
+    mask = script_cache_buckets_capacity - 1;
+    bucket = cache_hash(script_cache_entries[cache_entry_id].script_id) & mask;
+    while (script_cache_buckets[bucket] != 0) {
+        bucket = (bucket + 1) & mask;
+    }
+
+    script_cache_buckets[bucket] = cache_entry_id + 1;
+}
+
+void cache_bucket_remove(int script_id)
+{
+    unsigned int mask;
+    unsigned int bucket;
+    unsigned int next;
+    unsigned int home;
+    int slot;
+
+    mask = script_cache_buckets_capacity - 1;
+    bucket = cache_hash(script_id) & mask;
+    while (script_cache_entries[script_cache_buckets[bucket] - 1].script_id != script_id) {
+        bucket = (bucket + 1) & mask;
+    }
+
+    // Shift following entries of the cluster back, so that lookups never
+    // stop at the hole before reaching them.
+    next = bucket;
+    for (;;) {
+        next = (next + 1) & mask;
+        slot = script_cache_buckets[next];
+        if (slot == 0) {
+            break;
+        }
+
+        home = cache_hash(script_cache_entries[slot - 1].script_id) & mask;
+        if (((next - home) & mask) >= ((next - bucket) & mask)) {
+            script_cache_buckets[bucket] = slot;
+            bucket = next;
+        }
     }
 
-    if (best_candidate != -1) {
-        return best_candidate;
+    script_cache_buckets[bucket] = 0;
+}
+
+void cache_bucket_update(int script_id, int cache_entry_id)
+{
+    unsigned int mask;
+    unsigned int bucket;
+
+    mask = script_cache_buckets_capacity - 1;
+    bucket = cache_hash(script_id) & mask;
+    while (script_cache_entries[script_cache_buckets[bucket] - 1].script_id != script_id) {
+        bucket = (bucket + 1) & mask;
     }
 
-    if (candidate != -1) {
-        return candidate;
+    script_cache_buckets[bucket] = cache_entry_id + 1;
+}
+
+// Rebuilds hash index to match the capacity of `script_cache_entries` (the
+// index is kept at most half full).
+void cache_rehash(void)
+{
+    int index;
+
+    script_cache_buckets_capacity = script_cache_entries_capacity * 2;
+    if (script_cache_buckets != NULL) {
+        FREE(script_cache_buckets);
     }
+    script_cache_buckets = (int*)CALLOC(script_cache_buckets_capacity, sizeof(*script_cache_buckets));
 
-    tig_debug_printf("cache_find: Error: failed to find cache item!\n");
-    exit(EXIT_SUCCESS); // FIXME: Should be `EXIT_FAILURE`.
+    for (index = 0; index < script_cache_entries_cnt; index++) {
+        cache_bucket_insert(index);
+    }
 }
 
 // 0x44C710
@@ -27,6 +27,10 @@ typedef uint32_t DifferenceFileFlags;
 #define DIF_HAVE_SOUND_LIST 0x0200u
 #define DIF_HAVE_BLOCK_LIST 0x0400u
 
+// Number of slots in the sector cache hash index. Must be a power of two and
+// at least twice the maximum cache capacity (see `sector_cache_init`).
+#define SECTOR_CACHE_BUCKETS 256
+
 typedef bool (*SectorSaveFunc)(Sector* sector);
 typedef bool (*SectorLoadFunc)(int64_t id, Sector* sector);
 
@@ -73,6 +77,11 @@ static void sector_block_add(int64_t sec);
 static void sector_block_remove(int idx);
 static bool sector_block_save_internal(void);
 static bool sector_block_load_internal(const char* base_map_name, const char* current_map_name);
+static unsigned int sector_cache_hash(int64_t id);
+static SectorCacheEntry* sector_cache_lookup(int64_t id);
+static void sector_cache_bucket_insert(int index);
+static void sector_cache_rehash(void);
+static void sector_prefetch_at(int64_t x, int64_t y);
 
 // 0x5B7CD0
 static DateTime qword_5B7CD0 = { .days = -1, .milliseconds = -1 };
@@ -197,6 +206,19 @@ static unsigned int sector_history_size;
 // 0x601838
 static int sector_refcount;
 
+// Open addressing hash index of the used cache entries by sector id. Slots
+// keep entry index + 1, zero marks an empty slot.
+static int sector_cache_buckets[SECTOR_CACHE_BUCKETS];
+
+// Center of the view (in locations) seen by the last `sector_prefetch_view`.
+static bool sector_prefetch_center_valid;
+static int64_t sector_prefetch_center_x;
+static int64_t sector_prefetch_center_y;
+
+// Visible sectors and the direction of the last prefetch, used to request
+// every band of sectors only once.
+static int64_t sector_prefetch_band[6];
+
 // 0x4CEF70
 bool sector_init(GameInitInfo* init_info)
 {
@@ -843,13 +865,14 @@ bool sector_exists(uint64_t id)
 // 0x4D04E0
 bool sector_loaded(int64_t id)
 {
-    int index;
+    SectorCacheEntry* cache_entry;
 
-    if (!sector_cache_find_by_id(id, &index)) {
+    cache_entry = sector_cache_lookup(id);
+    if (cache_entry == NULL) {
         return false;
     }
 
-    if ((sector_cache_entries[sector_cache_indexes[index]].sector.flags & SECTOR_IS_NEW) != 0) {
+    if ((cache_entry->sector.flags & SECTOR_IS_NEW) != 0) {
         return false;
     }
 
@@ -887,15 +910,16 @@ bool sector_lock(int64_t id, Sector** sector_ptr)
     in_sector_lock = true;
     dword_6017BC++;
 
-    cache_entry = &(sector_cache_entries[sector_cache_indexes[dword_60182C]]);
-    if (cache_entry->used && cache_entry->sector.id == id) {
-        cache_entry->refcount++;
-        cache_entry->timestamp = dword_6017BC;
-    } else if (sector_cache_find_by_id(id, &dword_60182C)) {
-        cache_entry = &(sector_cache_entries[sector_cache_indexes[dword_60182C]]);
+    // NOTE: Original code checks the most recently found entry, and then
+    // binary searches sorted indexes. The hash index resolves hits in one or
+    // two probes, the sorted indexes are only needed to find insertion point.
+    cache_entry = sector_cache_lookup(id);
+    if (cache_entry != NULL) {
         cache_entry->refcount++;
         cache_entry->timestamp = dword_6017BC;
     } else {
+        sector_cache_find_by_id(id, &dword_60182C);
+
         if (sector_cache_size >= sector_cache_capacity) {
             for (index = 0; index < sector_cache_capacity; index++) {
                 if (sector_cache_entries[sector_cache_indexes[index]].refcount == 0) {
@@ -923,6 +947,7 @@ bool sector_lock(int64_t id, Sector** sector_ptr)
                 &(sector_cache_indexes[oldest + 1]),
                 sizeof(*sector_cache_indexes) * (sector_cache_size - oldest - 1));
             sector_cache_size--;
+            sector_cache_rehash();
 
             sector_cache_find_by_id(id, &dword_60182C);
         }
@@ -964,6 +989,7 @@ bool sector_lock(int64_t id, Sector** sector_ptr)
         cache_entry->refcount = 1;
         cache_entry->timestamp = dword_6017BC;
         cache_entry->sector.id = id;
+        sector_cache_bucket_insert(index);
     }
 
     *sector_ptr = &(cache_entry->sector);
@@ -977,13 +1003,14 @@ bool sector_lock(int64_t id, Sector** sector_ptr)
 // 0x4D0AE0
 bool sector_unlock(int64_t id)
 {
-    int index;
+    SectorCacheEntry* cache_entry;
 
-    if (!sector_cache_find_by_id(id, &index)) {
+    cache_entry = sector_cache_lookup(id);
+    if (cache_entry == NULL) {
         return false;
     }
 
-    sector_cache_entries[sector_cache_indexes[index]].refcount--;
+    cache_entry->refcount--;
     sector_refcount--;
 
     return true;
@@ -1000,6 +1027,9 @@ void sector_cache_reset(void)
     }
 
     sector_cache_size = 0;
+    sector_cache_rehash();
+    sector_prefetch_center_valid = false;
+    memset(sector_prefetch_band, 0, sizeof(sector_prefetch_band));
 }
 
 // 0x4D0BC0
@@ -1024,6 +1054,7 @@ void sector_flush(unsigned int flags)
         }
     }
 
+    sector_cache_rehash();
     sector_block_save_internal();
 }
 
@@ -1136,6 +1167,80 @@ void sector_enumerate(SectorEnumerateFunc func)
     in_sector_enumerate = false;
 }
 
+void sector_prefetch_view(LocRect* loc_rect)
+{
+    int64_t center_x;
+    int64_t center_y;
+    int64_t dx;
+    int64_t dy;
+    int64_t min_x;
+    int64_t min_y;
+    int64_t max_x;
+    int64_t max_y;
+    int64_t x;
+    int64_t y;
+    int64_t band[6];
+
+    if (sector_editor || !map_is_valid()) {
+        return;
+    }
+
+    center_x = (loc_rect->x1 + loc_rect->x2) / 2;
+    center_y = (loc_rect->y1 + loc_rect->y2) / 2;
+
+    if (!sector_prefetch_center_valid) {
+        sector_prefetch_center_x = center_x;
+        sector_prefetch_center_y = center_y;
+        sector_prefetch_center_valid = true;
+        return;
+    }
+
+    dx = center_x - sector_prefetch_center_x;
+    dy = center_y - sector_prefetch_center_y;
+    if (dx == 0 && dy == 0) {
+        return;
+    }
+
+    sector_prefetch_center_x = center_x;
+    sector_prefetch_center_y = center_y;
+
+    min_x = loc_rect->x1 >> 6;
+    min_y = loc_rect->y1 >> 6;
+    max_x = loc_rect->x2 >> 6;
+    max_y = loc_rect->y2 >> 6;
+
+    band[0] = min_x;
+    band[1] = min_y;
+    band[2] = max_x;
+    band[3] = max_y;
+    band[4] = dx > 0 ? 1 : (dx < 0 ? -1 : 0);
+    band[5] = dy > 0 ? 1 : (dy < 0 ? -1 : 0);
+    if (memcmp(band, sector_prefetch_band, sizeof(band)) == 0) {
+        return;
+    }
+    memcpy(sector_prefetch_band, band, sizeof(band));
+
+    // Request the row and/or the column of sectors right past the visible
+    // ones on the side the view is moving to.
+    if (dx != 0) {
+        x = dx > 0 ? max_x + 1 : min_x - 1;
+        for (y = min_y; y <= max_y; y++) {
+            sector_prefetch_at(x, y);
+        }
+    }
+
+    if (dy != 0) {
+        y = dy > 0 ? max_y + 1 : min_y - 1;
+        for (x = min_x; x <= max_x; x++) {
+            sector_prefetch_at(x, y);
+        }
+
+        if (dx != 0) {
+            sector_prefetch_at(dx > 0 ? max_x + 1 : min_x - 1, y);
+        }
+    }
+}
+
 // 0x4D10C0
 bool sector_history_init(GameInitInfo* init_info)
 {
@@ -2363,3 +2468,85 @@ bool sector_block_load_internal(const char* base_map_name, const char* current_m
     tig_file_fclose(stream);
     return true;
 }
+
+unsigned int sector_cache_hash(int64_t id)
+{
+    // Fibonacci hashing, top bits of the product are the best mixed.
+    return (unsigned int)(((uint64_t)id * 0x9E3779B97F4A7C15ULL) >> 56) & (SECTOR_CACHE_BUCKETS - 1);
+}
+
+SectorCacheEntry* sector_cache_lookup(int64_t id)
+{
+    unsigned int bucket;
+    int slot;
+
+    bucket = sector_cache_hash(id);
+    while ((slot = sector_cache_buckets[bucket]) != 0) {
+        if (sector_cache_entries[slot - 1].sector.id == id) {
+            return &(sector_cache_entries[slot - 1]);
+        }
+
+        bucket = (bucket + 1) & (SECTOR_CACHE_BUCKETS - 1);
+    }
+
+    return NULL;
+}
+
+void sector_cache_bucket_insert(int index)
+{
+    unsigned int bucket;
+
+    bucket = sector_cache_hash(sector_cache_entries[index].sector.id);
+    while (sector_cache_buckets[bucket] != 0) {
+        bucket = (bucket + 1) & (SECTOR_CACHE_BUCKETS - 1);
+    }
+
+    sector_cache_buckets[bucket] = index + 1;
+}
+
+// Rebuilds hash index from the sorted indexes. Entries leave the cache only
+// on eviction and flushes (which write sectors to disk anyway), so there is
+// no point in maintaining deletions in place.
+void sector_cache_rehash(void)
+{
+    unsigned int index;
+
+    memset(sector_cache_buckets, 0, sizeof(sector_cache_buckets));
+
+    for (index = 0; index < sector_cache_size; index++) {
+        sector_cache_bucket_insert(sector_cache_indexes[index]);
+    }
+}
+
+// Schedules the sector file (.sec or the terrain fallback) to be read and
+// inflated on a background thread, so that `sector_load_game` opens it from
+// memory. Mirrors the path selection of `sector_load_game`.
+void sector_prefetch_at(int64_t x, int64_t y)
+{
+    int64_t id;
+    char path[TIG_MAX_PATH];
+
+    if (x < 0 || x >= sector_limit_x || y < 0 || y >= sector_limit_y) {
+        return;
+    }
+
+    id = SECTOR_MAKE(x, y);
+    if (sector_cache_lookup(id) != NULL) {
+        return;
+    }
+
+    if (sector_check_demo_limits(id)) {
+        snprintf(path, sizeof(path), "%s\\%" PRIu64 ".sec", sector_base_path, (uint64_t)id);
+        if (tig_file_prefetch(path, 0) == 0 && !tig_file_exists(path, NULL)) {
+            terrain_sector_path(id, path);
+            tig_file_prefetch(path, 0);
+        }
+    } else {
+        terrain_sector_path(id, path);
+        tig_file_prefetch(path, 0);
+    }
+
+    // NOTE: Sector differences (.dif) live in the save directory as loose
+    // files, which `tig_file_prefetch` does not serve, so they are not
+    // requested.
+}
@@ -75,6 +75,11 @@ bool sector_block_load(const char* base_map_name, const char* current_map_name);
 void sector_art_cache_enable(void);
 void sector_art_cache_disable(void);
 void sector_enumerate(SectorEnumerateFunc func);
+
+// Schedules background reading of sectors which are about to become visible
+// as the view at `loc_rect` moves.
+void sector_prefetch_view(LocRect* loc_rect);
+
 bool sector_history_init(GameInitInfo* init_info);
 void sector_history_reset(void);
 void sector_history_exit(void);
@@ -540,6 +540,7 @@ bool objlist_insert_internal(SectorObjectList* list, int64_t obj)
 
     node = object_node_create();
     node->obj = obj;
+    node->type = obj_field_int32_get(obj, OBJ_F_TYPE);
     node->next = NULL;
     sub_4F20A0(list, node);
 
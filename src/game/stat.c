@@ -1105,7 +1105,7 @@ bool poison_timeevent_schedule(int64_t obj, int poison, bool recovery)
     // Check if poison damage event is not already scheduled.
     poison_test_obj = obj;
     poison_test_event = POISON_EVENT_DAMAGE;
-    if (!timeevent_any(TIMEEVENT_TYPE_POISON, poison_timeevent_check)) {
+    if (!timeevent_any_obj(TIMEEVENT_TYPE_POISON, obj, poison_timeevent_check)) {
         // Schedule damage event in 15 seconds.
         sub_45A950(&datetime, 15000);
         if (!timeevent_add_delay(&timeevent, &datetime)) {
@@ -1117,7 +1117,7 @@ bool poison_timeevent_schedule(int64_t obj, int poison, bool recovery)
         // Check is poison recovery event event is not already scheduled.
         poison_test_obj = obj;
         poison_test_event = POISON_EVENT_RECOVERY;
-        if (!timeevent_any(TIMEEVENT_TYPE_POISON, poison_timeevent_check)) {
+        if (!timeevent_any_obj(TIMEEVENT_TYPE_POISON, obj, poison_timeevent_check)) {
             // Set event type to recovery.
             timeevent.params[0].integer_value = POISON_EVENT_RECOVERY;
 
@@ -46,8 +46,25 @@ typedef struct TimeEventNode {
     Ryan field_30[TIMEEVENT_PARAM_TYPE_COUNT];
     struct TimeEventNode* next;
     int field_D4;
+    struct TimeEventHeap* heap;
+    int heap_index;
+    uint64_t seq;
+    int64_t obj;
+    struct TimeEventNode* type_prev;
+    struct TimeEventNode* type_next;
+    struct TimeEventNode* obj_prev;
+    struct TimeEventNode* obj_next;
 } TimeEventNode;
 
+// Binary min-heap of nodes ordered by their datetime. Nodes scheduled at the
+// same datetime are ordered from the most recently added one, which matches
+// the insertion order of the original sorted lists.
+typedef struct TimeEventHeap {
+    TimeEventNode** nodes;
+    int size;
+    int capacity;
+} TimeEventHeap;
+
 typedef void (*TimeEventExitFunc)(TimeEvent* timeevent);
 typedef bool (*TimeEventShouldSaveFunc)(TimeEvent* timeevent);
 
@@ -68,6 +85,25 @@ static bool timeevent_add_delay_base(TimeEvent* timeevent, DateTime* delay, Date
 static bool timeevent_add_base_at_func(TimeEvent* timeevent, DateTime* base, DateTime* at);
 static TimeEventNode* timeevent_node_create(void);
 static void timeevent_node_destroy(TimeEventNode* node);
+static bool timeevent_node_before(const TimeEventNode* a, const TimeEventNode* b);
+static int timeevent_node_compare(const void* a, const void* b);
+static void timeevent_heap_sift_up(TimeEventHeap* heap, int index);
+static void timeevent_heap_sift_down(TimeEventHeap* heap, int index);
+static bool timeevent_heap_push(TimeEventHeap* heap, TimeEventNode* node);
+static void timeevent_heap_remove(TimeEventHeap* heap, TimeEventNode* node);
+static void timeevent_heap_destroy(TimeEventHeap* heap);
+static int64_t timeevent_node_primary_obj(TimeEventNode* node);
+static unsigned int timeevent_obj_hash(int64_t obj);
+static void timeevent_node_obj_link(TimeEventNode* node);
+static void timeevent_node_obj_unlink(TimeEventNode* node);
+static void timeevent_node_link(TimeEventNode* node, TimeEventHeap* heap);
+static void timeevent_node_unlink(TimeEventNode* node);
+static void timeevent_node_remove(TimeEventNode* node);
+static bool timeevent_scratch_reserve(int count);
+static int timeevent_collect_heap(TimeEventHeap* heap);
+static int timeevent_collect(TimeEventHeap* heap, int list, bool by_obj, int64_t obj, bool sorted);
+static bool timeevent_clear_matching(int list, bool by_obj, int64_t obj, TimeEventEnumerateFunc callback, bool all);
+static bool timeevent_any_matching(int list, bool by_obj, int64_t obj, TimeEventEnumerateFunc callback);
 static bool timeevent_recover_handles(TimeEventNode* timeevent);
 static bool timeevent_recover_handles_internal(TimeEventNode* node, bool force);
 static void sub_45B750(void);
@@ -162,10 +198,33 @@ static TimeEventParamTypeFlags dword_5B2794[TIMEEVENT_PARAM_COUNT][TIMEEVENT_PAR
 };
 
 // 0x5E7638
-static TimeEventNode* timeevent_lists[TIME_TYPE_COUNT];
+static TimeEventHeap timeevent_lists[TIME_TYPE_COUNT];
 
 // 0x5E7E14
-static TimeEventNode* timeevent_new_lists[TIME_TYPE_COUNT];
+static TimeEventHeap timeevent_new_lists[TIME_TYPE_COUNT];
+
+#define TIMEEVENT_OBJ_BUCKETS_SHIFT 10
+#define TIMEEVENT_OBJ_BUCKETS (1 << TIMEEVENT_OBJ_BUCKETS_SHIFT)
+#define TIMEEVENT_NODE_POOL_MAX 1024
+
+// Nodes of every type (both queued and pending), linked through `type_next`.
+static TimeEventNode* timeevent_type_lists[TIMEEVENT_TYPE_COUNT];
+
+// Nodes keyed by their primary object (see `timeevent_node_primary_obj`),
+// linked through `obj_next`.
+static TimeEventNode* timeevent_obj_buckets[TIMEEVENT_OBJ_BUCKETS];
+
+// Destroyed nodes kept for reuse, linked through `next`.
+static TimeEventNode* timeevent_node_pool;
+static int timeevent_node_pool_count;
+
+// Ever-increasing insertion counter to break ties between nodes scheduled at
+// the same datetime.
+static uint64_t timeevent_seq;
+
+// Temporary array of nodes collected by `timeevent_collect`.
+static TimeEventNode** timeevent_scratch;
+static int timeevent_scratch_capacity;
 
 // 0x5E85F0
 static bool timeevent_editor;
@@ -509,14 +568,6 @@ bool timeevent_init(GameInitInfo* init_info)
     timeevent_editor = init_info->editor;
 
     if (!timeevent_initialized) {
-        timeevent_lists[TIME_TYPE_REAL_TIME] = NULL;
-        timeevent_lists[TIME_TYPE_GAME_TIME] = NULL;
-        timeevent_lists[TIME_TYPE_ANIMATIONS] = NULL;
-
-        timeevent_new_lists[TIME_TYPE_REAL_TIME] = NULL;
-        timeevent_new_lists[TIME_TYPE_GAME_TIME] = NULL;
-        timeevent_new_lists[TIME_TYPE_ANIMATIONS] = NULL;
-
         sub_45A950(&timeevent_real_time, 0);
         sub_45A950(&timeevent_game_time, datetime_start_time_in_milliseconds);
         sub_45A950(&timeevent_anim_time, datetime_start_time_in_milliseconds);
@@ -562,8 +613,27 @@ void timeevent_reset(void)
 // 0x45AEC0
 void timeevent_exit(void)
 {
+    int index;
+    TimeEventNode* node;
+
     timeevent_initialized = false;
     timeevent_clear();
+
+    for (index = 0; index < TIME_TYPE_COUNT; index++) {
+        timeevent_heap_destroy(&(timeevent_lists[index]));
+        timeevent_heap_destroy(&(timeevent_new_lists[index]));
+    }
+
+    while (timeevent_node_pool != NULL) {
+        node = timeevent_node_pool;
+        timeevent_node_pool = node->next;
+        FREE(node);
+    }
+    timeevent_node_pool_count = 0;
+
+    FREE(timeevent_scratch);
+    timeevent_scratch = NULL;
+    timeevent_scratch_capacity = 0;
 }
 
 // 0x45AED0
@@ -572,6 +642,8 @@ bool timeevent_save(TigFile* stream)
     int index;
     int count_pos;
     int count;
+    int nodes_count;
+    int node_index;
     TimeEventNode* timeevent;
     int pos;
     TimeEventTypeInfo* info;
@@ -598,8 +670,11 @@ bool timeevent_save(TigFile* stream)
             return false;
         }
 
-        timeevent = timeevent_lists[index];
-        while (timeevent != NULL) {
+        // Nodes are written in the order they are going to be processed, the
+        // same order the original sorted lists had.
+        nodes_count = timeevent_collect_heap(&(timeevent_lists[index]));
+        for (node_index = 0; node_index < nodes_count; node_index++) {
+            timeevent = timeevent_scratch[node_index];
             info = &(stru_5B2188[timeevent->te.type]);
             // NOTE: Original code is slightly different. It uses bitwise AND
             // with 0x1 implying `saveable` is a bitfield.
@@ -612,7 +687,6 @@ bool timeevent_save(TigFile* stream)
                     count++;
                 }
             }
-            timeevent = timeevent->next;
         }
 
         if (tig_file_fgetpos(stream, &pos) != 0) {
@@ -856,11 +930,12 @@ void timeevent_ping(tig_timestamp_t timestamp)
             assert(0);
         }
 
-        // TimeEventNode objects are sorted by their datetime, so we are only
-        // interested in head node.
-        while ((node = timeevent_lists[time_type]) != NULL
-            && datetime_compare(datetime, &(node->te.datetime)) >= 0) {
-            timeevent_lists[time_type] = node->next;
+        // TimeEventNode objects are ordered by their datetime, so we are only
+        // interested in the root of the heap.
+        while (timeevent_lists[time_type].size != 0
+            && datetime_compare(datetime, &(timeevent_lists[time_type].nodes[0]->te.datetime)) >= 0) {
+            node = timeevent_lists[time_type].nodes[0];
+            timeevent_node_unlink(node);
 
             info = &(stru_5B2188[node->te.type]);
 
@@ -917,7 +992,328 @@ void timeevent_ping(tig_timestamp_t timestamp)
 // 0x45B600
 void timeevent_node_destroy(TimeEventNode* node)
 {
-    FREE(node);
+    if (timeevent_node_pool_count < TIMEEVENT_NODE_POOL_MAX) {
+        node->next = timeevent_node_pool;
+        timeevent_node_pool = node;
+        timeevent_node_pool_count++;
+    } else {
+        FREE(node);
+    }
+}
+
+bool timeevent_node_before(const TimeEventNode* a, const TimeEventNode* b)
+{
+    int cmp;
+
+    cmp = datetime_compare(&(a->te.datetime), &(b->te.datetime));
+    if (cmp != 0) {
+        return cmp < 0;
+    }
+
+    // Nodes added later go first (see `TimeEventHeap`).
+    return a->seq > b->seq;
+}
+
+int timeevent_node_compare(const void* a, const void* b)
+{
+    const TimeEventNode* node1 = *(const TimeEventNode**)a;
+    const TimeEventNode* node2 = *(const TimeEventNode**)b;
+
+    if (timeevent_node_before(node1, node2)) {
+        return -1;
+    }
+
+    if (timeevent_node_before(node2, node1)) {
+        return 1;
+    }
+
+    return 0;
+}
+
+void timeevent_heap_sift_up(TimeEventHeap* heap, int index)
+{
+    TimeEventNode* node;
+    int parent;
+
+    node = heap->nodes[index];
+    while (index > 0) {
+        parent = (index - 1) / 2;
+        if (!timeevent_node_before(node, heap->nodes[parent])) {
+            break;
+        }
+
+        heap->nodes[index] = heap->nodes[parent];
+        heap->nodes[index]->heap_index = index;
+        index = parent;
+    }
+
+    heap->nodes[index] = node;
+    node->heap_index = index;
+}
+
+void timeevent_heap_sift_down(TimeEventHeap* heap, int index)
+{
+    TimeEventNode* node;
+    int child;
+
+    node = heap->nodes[index];
+    for (;;) {
+        child = index * 2 + 1;
+        if (child >= heap->size) {
+            break;
+        }
+
+        if (child + 1 < heap->size
+            && timeevent_node_before(heap->nodes[child + 1], heap->nodes[child])) {
+            child++;
+        }
+
+        if (!timeevent_node_before(heap->nodes[child], node)) {
+            break;
+        }
+
+        heap->nodes[index] = heap->nodes[child];
+        heap->nodes[index]->heap_index = index;
+        index = child;
+    }
+
+    heap->nodes[index] = node;
+    node->heap_index = index;
+}
+
+bool timeevent_heap_push(TimeEventHeap* heap, TimeEventNode* node)
+{
+    TimeEventNode** nodes;
+    int capacity;
+
+    if (heap->size == heap->capacity) {
+        capacity = heap->capacity != 0 ? heap->capacity * 2 : 256;
+        nodes = (TimeEventNode**)REALLOC(heap->nodes, sizeof(*nodes) * capacity);
+        if (nodes == NULL) {
+            return false;
+        }
+
+        heap->nodes = nodes;
+        heap->capacity = capacity;
+    }
+
+    heap->nodes[heap->size++] = node;
+    timeevent_heap_sift_up(heap, heap->size - 1);
+
+    return true;
+}
+
+void timeevent_heap_remove(TimeEventHeap* heap, TimeEventNode* node)
+{
+    TimeEventNode* last;
+    int index;
+
+    index = node->heap_index;
+    heap->size--;
+
+    if (index != heap->size) {
+        last = heap->nodes[heap->size];
+        heap->nodes[index] = last;
+        last->heap_index = index;
+
+        // The moved node can violate the heap property in either direction.
+        timeevent_heap_sift_up(heap, index);
+        if (heap->nodes[index] == last) {
+            timeevent_heap_sift_down(heap, index);
+        }
+    }
+}
+
+void timeevent_heap_destroy(TimeEventHeap* heap)
+{
+    FREE(heap->nodes);
+    heap->nodes = NULL;
+    heap->size = 0;
+    heap->capacity = 0;
+}
+
+// Returns the value of the first object parameter of the node, which is the
+// one the enumerate callbacks key on (the owner of the event).
+int64_t timeevent_node_primary_obj(TimeEventNode* node)
+{
+    int index;
+
+    for (index = 0; index < TIMEEVENT_PARAM_COUNT; index++) {
+        if ((dword_5B2794[index][TIMEEVENT_PARAM_TYPE_OBJECT] & stru_5B2188[node->te.type].flags) != 0) {
+            return node->te.params[index].object_value;
+        }
+    }
+
+    return OBJ_HANDLE_NULL;
+}
+
+unsigned int timeevent_obj_hash(int64_t obj)
+{
+    return (unsigned int)(((uint64_t)obj * 0x9E3779B97F4A7C15ull) >> (64 - TIMEEVENT_OBJ_BUCKETS_SHIFT));
+}
+
+void timeevent_node_obj_link(TimeEventNode* node)
+{
+    TimeEventNode** bucket;
+
+    node->obj = timeevent_node_primary_obj(node);
+    if (node->obj == OBJ_HANDLE_NULL) {
+        return;
+    }
+
+    bucket = &(timeevent_obj_buckets[timeevent_obj_hash(node->obj)]);
+    node->obj_prev = NULL;
+    node->obj_next = *bucket;
+    if (*bucket != NULL) {
+        (*bucket)->obj_prev = node;
+    }
+    *bucket = node;
+}
+
+void timeevent_node_obj_unlink(TimeEventNode* node)
+{
+    if (node->obj == OBJ_HANDLE_NULL) {
+        return;
+    }
+
+    if (node->obj_prev != NULL) {
+        node->obj_prev->obj_next = node->obj_next;
+    } else {
+        timeevent_obj_buckets[timeevent_obj_hash(node->obj)] = node->obj_next;
+    }
+
+    if (node->obj_next != NULL) {
+        node->obj_next->obj_prev = node->obj_prev;
+    }
+
+    node->obj = OBJ_HANDLE_NULL;
+}
+
+void timeevent_node_link(TimeEventNode* node, TimeEventHeap* heap)
+{
+    node->seq = timeevent_seq++;
+    if (!timeevent_heap_push(heap, node)) {
+        tig_debug_printf("TimeEvent: timeevent_node_link: Error: failed to grow heap!\n");
+        exit(EXIT_FAILURE);
+    }
+    node->heap = heap;
+
+    node->type_prev = NULL;
+    node->type_next = timeevent_type_lists[node->te.type];
+    if (node->type_next != NULL) {
+        node->type_next->type_prev = node;
+    }
+    timeevent_type_lists[node->te.type] = node;
+
+    timeevent_node_obj_link(node);
+}
+
+void timeevent_node_unlink(TimeEventNode* node)
+{
+    timeevent_heap_remove(node->heap, node);
+    node->heap = NULL;
+
+    if (node->type_prev != NULL) {
+        node->type_prev->type_next = node->type_next;
+    } else {
+        timeevent_type_lists[node->te.type] = node->type_next;
+    }
+
+    if (node->type_next != NULL) {
+        node->type_next->type_prev = node->type_prev;
+    }
+
+    timeevent_node_obj_unlink(node);
+}
+
+// Unlinks the node from the queue, gives user code a chance for cleanup and
+// destroys it.
+void timeevent_node_remove(TimeEventNode* node)
+{
+    timeevent_node_unlink(node);
+
+    if (stru_5B2188[node->te.type].exit_func != NULL) {
+        stru_5B2188[node->te.type].exit_func(&(node->te));
+    }
+
+    timeevent_node_destroy(node);
+}
+
+bool timeevent_scratch_reserve(int count)
+{
+    TimeEventNode** nodes;
+    int capacity;
+
+    if (count <= timeevent_scratch_capacity) {
+        return true;
+    }
+
+    capacity = timeevent_scratch_capacity != 0 ? timeevent_scratch_capacity : 256;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+
+    nodes = (TimeEventNode**)REALLOC(timeevent_scratch, sizeof(*nodes) * capacity);
+    if (nodes == NULL) {
+        tig_debug_printf("TimeEvent: timeevent_scratch_reserve: Error: failed to grow buffer!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    timeevent_scratch = nodes;
+    timeevent_scratch_capacity = capacity;
+
+    return true;
+}
+
+// Collects all nodes of the heap into `timeevent_scratch` in the order they are
+// going to be processed.
+int timeevent_collect_heap(TimeEventHeap* heap)
+{
+    if (heap->size == 0) {
+        return 0;
+    }
+
+    timeevent_scratch_reserve(heap->size);
+    memcpy(timeevent_scratch, heap->nodes, sizeof(*timeevent_scratch) * heap->size);
+    qsort(timeevent_scratch, heap->size, sizeof(*timeevent_scratch), timeevent_node_compare);
+
+    return heap->size;
+}
+
+// Collects nodes of the given type from the heap into `timeevent_scratch`
+// using either type or object index. When `sorted` is set, the nodes are
+// arranged in the order they are going to be processed, so that the first one
+// accepted by a callback is the one the original list walk would pick.
+int timeevent_collect(TimeEventHeap* heap, int list, bool by_obj, int64_t obj, bool sorted)
+{
+    TimeEventNode* node;
+    int count = 0;
+
+    if (by_obj && obj != OBJ_HANDLE_NULL) {
+        node = timeevent_obj_buckets[timeevent_obj_hash(obj)];
+        while (node != NULL) {
+            if (node->heap == heap && node->te.type == list && node->obj == obj) {
+                timeevent_scratch_reserve(count + 1);
+                timeevent_scratch[count++] = node;
+            }
+            node = node->obj_next;
+        }
+    } else {
+        node = timeevent_type_lists[list];
+        while (node != NULL) {
+            if (node->heap == heap && (!by_obj || node->obj == OBJ_HANDLE_NULL)) {
+                timeevent_scratch_reserve(count + 1);
+                timeevent_scratch[count++] = node;
+            }
+            node = node->type_next;
+        }
+    }
+
+    if (sorted && count > 1) {
+        qsort(timeevent_scratch, count, sizeof(*timeevent_scratch), timeevent_node_compare);
+    }
+
+    return count;
 }
 
 // 0x45B610
@@ -972,14 +1368,14 @@ bool timeevent_recover_handles_internal(TimeEventNode* node, bool force)
 void sub_45B750(void)
 {
     int index;
-    TimeEventNode** node_ptr;
+    TimeEventHeap* heap;
     TimeEventNode* node;
 
     for (index = 0; index < TIME_TYPE_COUNT; index++) {
-        node_ptr = &(timeevent_new_lists[index]);
-        while (*node_ptr != NULL) {
-            node = *node_ptr;
-            *node_ptr = node->next;
+        heap = &(timeevent_new_lists[index]);
+        while (heap->size != 0) {
+            node = heap->nodes[0];
+            timeevent_node_unlink(node);
             if (sub_45B7A0(node)) {
                 sub_45BB40(node);
             } else {
@@ -1050,7 +1446,7 @@ bool timeevent_add_delay_base(TimeEvent* timeevent, DateTime* delay, DateTime* b
 // 0x45B8C0
 bool timeevent_add_base_at_func(TimeEvent* timeevent, DateTime* base, DateTime* at)
 {
-    TimeEventNode** node_ptr;
+    TimeEventHeap* heap;
     TimeEventNode* node;
     int time_type;
     int index;
@@ -1077,20 +1473,12 @@ bool timeevent_add_base_at_func(TimeEvent* timeevent, DateTime* base, DateTime*
 
     time_type = stru_5B2188[timeevent->type].time_type;
     if (!timeevent_in_ping || dword_5E8620) {
-        node_ptr = &(timeevent_lists[time_type]);
+        heap = &(timeevent_lists[time_type]);
     } else {
-        node_ptr = &(timeevent_new_lists[time_type]);
-    }
-
-    while (*node_ptr != NULL) {
-        if (datetime_compare(&(timeevent->datetime), &((*node_ptr)->te.datetime)) <= 0) {
-            break;
-        }
-
-        node_ptr = &((*node_ptr)->next);
+        heap = &(timeevent_new_lists[time_type]);
     }
 
-    node->next = *node_ptr;
+    node->next = NULL;
     node->te = *timeevent;
 
     for (index = 0; index < TIMEEVENT_PARAM_COUNT; index++) {
@@ -1101,7 +1489,7 @@ bool timeevent_add_base_at_func(TimeEvent* timeevent, DateTime* base, DateTime*
         }
     }
 
-    *node_ptr = node;
+    timeevent_node_link(node, heap);
 
     if (at != NULL) {
         *at = timeevent->datetime;
@@ -1113,6 +1501,15 @@ bool timeevent_add_base_at_func(TimeEvent* timeevent, DateTime* base, DateTime*
 // 0x45BA20
 TimeEventNode* timeevent_node_create(void)
 {
+    TimeEventNode* node;
+
+    if (timeevent_node_pool != NULL) {
+        node = timeevent_node_pool;
+        timeevent_node_pool = node->next;
+        timeevent_node_pool_count--;
+        return node;
+    }
+
     return (TimeEventNode*)MALLOC(sizeof(TimeEventNode));
 }
 
@@ -1177,7 +1574,7 @@ bool sub_45BAF0(TimeEvent* timeevent)
 // 0x45BB40
 bool sub_45BB40(TimeEventNode* node)
 {
-    TimeEventNode** node_ptr;
+    TimeEventHeap* heap;
     int time_type;
     int index;
 
@@ -1187,19 +1584,12 @@ bool sub_45BB40(TimeEventNode* node)
 
     time_type = stru_5B2188[node->te.type].time_type;
     if (timeevent_in_ping) {
-        node_ptr = &(timeevent_new_lists[time_type]);
+        heap = &(timeevent_new_lists[time_type]);
     } else {
-        node_ptr = &(timeevent_lists[time_type]);
-    }
-
-    while (*node_ptr != NULL) {
-        if (datetime_compare(&(node->te.datetime), &((*node_ptr)->te.datetime)) <= 0) {
-            break;
-        }
-        node_ptr = &((*node_ptr)->next);
+        heap = &(timeevent_lists[time_type]);
     }
 
-    node->next = *node_ptr;
+    node->next = NULL;
 
     for (index = 0; index < TIMEEVENT_PARAM_COUNT; index++) {
         if ((dword_5B2794[index][TIMEEVENT_PARAM_TYPE_OBJECT] & stru_5B2188[node->te.type].flags) != 0) {
@@ -1209,7 +1599,7 @@ bool sub_45BB40(TimeEventNode* node)
         }
     }
 
-    *node_ptr = node;
+    timeevent_node_link(node, heap);
 
     return true;
 }
@@ -1218,29 +1608,14 @@ bool sub_45BB40(TimeEventNode* node)
 void timeevent_clear(void)
 {
     int index;
-    TimeEventNode* node;
 
     for (index = 0; index < TIME_TYPE_COUNT; index++) {
-        while (timeevent_lists[index] != NULL) {
-            node = timeevent_lists[index];
-            timeevent_lists[index] = node->next;
-
-            if (stru_5B2188[node->te.type].exit_func != NULL) {
-                stru_5B2188[node->te.type].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
+        while (timeevent_lists[index].size != 0) {
+            timeevent_node_remove(timeevent_lists[index].nodes[timeevent_lists[index].size - 1]);
         }
 
-        while (timeevent_new_lists[index] != NULL) {
-            node = timeevent_new_lists[index];
-            timeevent_new_lists[index] = node->next;
-
-            if (stru_5B2188[node->te.type].exit_func != NULL) {
-                stru_5B2188[node->te.type].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
+        while (timeevent_new_lists[index].size != 0) {
+            timeevent_node_remove(timeevent_new_lists[index].nodes[timeevent_new_lists[index].size - 1]);
         }
     }
 }
@@ -1274,43 +1649,12 @@ void timeevent_clear_for_map_close(void)
 // 0x45BD70
 bool timeevent_clear_all_typed(int list)
 {
-    TimeEventNode** node_ptr;
-    TimeEventNode* node;
-
     if (list >= TIMEEVENT_TYPE_COUNT) {
         return false;
     }
 
-    node_ptr = &(timeevent_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-        } else {
-            node_ptr = &(node->next);
-        }
-    }
-
-    node_ptr = &(timeevent_new_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-        } else {
-            node_ptr = &(node->next);
-        }
+    while (timeevent_type_lists[list] != NULL) {
+        timeevent_node_remove(timeevent_type_lists[list]);
     }
 
     return true;
@@ -1319,141 +1663,61 @@ bool timeevent_clear_all_typed(int list)
 // 0x45BE40
 bool timeevent_clear_one_typed(int list)
 {
-    TimeEventNode** node_ptr;
-    TimeEventNode* node;
-
-    if (list >= TIMEEVENT_TYPE_COUNT) {
-        return false;
-    }
-
-    node_ptr = &(timeevent_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-
-            break;
-        }
-
-        node_ptr = &(node->next);
-    }
-
-    node_ptr = &(timeevent_new_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-
-            break;
-        }
-
-        node_ptr = &(node->next);
-    }
-
-    return true;
+    return timeevent_clear_matching(list, false, OBJ_HANDLE_NULL, NULL, false);
 }
 
 // 0x45BF10
 bool timeevent_clear_all_ex(int list, TimeEventEnumerateFunc callback)
 {
-    TimeEventNode** node_ptr;
-    TimeEventNode* node;
-
-    if (list >= TIMEEVENT_TYPE_COUNT) {
-        return false;
-    }
-
-    node_ptr = &(timeevent_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list && callback(&(node->te))) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-        } else {
-            node_ptr = &(node->next);
-        }
-    }
-
-    node_ptr = &(timeevent_new_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list && callback(&(node->te))) {
-            *node_ptr = node->next;
+    return timeevent_clear_matching(list, false, OBJ_HANDLE_NULL, callback, true);
+}
 
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
+// 0x45BFF0
+bool timeevent_clear_one_ex(int list, TimeEventEnumerateFunc callback)
+{
+    return timeevent_clear_matching(list, false, OBJ_HANDLE_NULL, callback, false);
+}
 
-            timeevent_node_destroy(node);
-        } else {
-            node_ptr = &(node->next);
-        }
-    }
+bool timeevent_clear_all_obj_ex(int list, int64_t obj, TimeEventEnumerateFunc callback)
+{
+    return timeevent_clear_matching(list, true, obj, callback, true);
+}
 
-    return true;
+bool timeevent_clear_one_obj_ex(int list, int64_t obj, TimeEventEnumerateFunc callback)
+{
+    return timeevent_clear_matching(list, true, obj, callback, false);
 }
 
-// 0x45BFF0
-bool timeevent_clear_one_ex(int list, TimeEventEnumerateFunc callback)
+// Removes nodes of the given type accepted by the callback (or all of them if
+// there is no callback). Unless `all` is set, at most one node is removed from
+// both the queue and pending nodes, the earliest one.
+bool timeevent_clear_matching(int list, bool by_obj, int64_t obj, TimeEventEnumerateFunc callback, bool all)
 {
-    TimeEventNode** node_ptr;
+    TimeEventHeap* heaps[2];
     TimeEventNode* node;
+    int heap_index;
+    int count;
+    int index;
 
     if (list >= TIMEEVENT_TYPE_COUNT) {
         return false;
     }
 
-    node_ptr = &(timeevent_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list && callback(&(node->te))) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-
-            break;
-        }
-
-        node_ptr = &(node->next);
-    }
+    heaps[0] = &(timeevent_lists[stru_5B2188[list].time_type]);
+    heaps[1] = &(timeevent_new_lists[stru_5B2188[list].time_type]);
 
-    node_ptr = &(timeevent_new_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list && callback(&(node->te))) {
-            *node_ptr = node->next;
+    for (heap_index = 0; heap_index < 2; heap_index++) {
+        count = timeevent_collect(heaps[heap_index], list, by_obj, obj, !all);
+        for (index = 0; index < count; index++) {
+            node = timeevent_scratch[index];
+            if (callback == NULL || callback(&(node->te))) {
+                timeevent_node_remove(node);
 
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
+                if (!all) {
+                    break;
+                }
             }
-
-            timeevent_node_destroy(node);
-
-            break;
         }
-
-        node_ptr = &(node->next);
     }
 
     return true;
@@ -1462,58 +1726,45 @@ bool timeevent_clear_one_ex(int list, TimeEventEnumerateFunc callback)
 // 0x45C0E0
 bool sub_45C0E0(int list)
 {
-    TimeEventNode* node;
-
     if (list >= TIMEEVENT_TYPE_COUNT) {
         return false;
     }
 
-    node = timeevent_new_lists[stru_5B2188[list].time_type];
-    while (node != NULL) {
-        if (node->te.type == list) {
-            return true;
-        }
-
-        node = node->next;
-    }
-
-    node = timeevent_lists[stru_5B2188[list].time_type];
-    while (node != NULL) {
-        if (node->te.type == list) {
-            return true;
-        }
-
-        node = node->next;
-    }
-
-    return false;
+    return timeevent_type_lists[list] != NULL;
 }
 
 // 0x45C140
 bool timeevent_any(int list, TimeEventEnumerateFunc callback)
 {
-    TimeEventNode* node;
+    return timeevent_any_matching(list, false, OBJ_HANDLE_NULL, callback);
+}
+
+bool timeevent_any_obj(int list, int64_t obj, TimeEventEnumerateFunc callback)
+{
+    return timeevent_any_matching(list, true, obj, callback);
+}
+
+bool timeevent_any_matching(int list, bool by_obj, int64_t obj, TimeEventEnumerateFunc callback)
+{
+    TimeEventHeap* heaps[2];
+    int heap_index;
+    int count;
+    int index;
 
     if (list >= TIMEEVENT_TYPE_COUNT) {
         return false;
     }
 
-    node = timeevent_new_lists[stru_5B2188[list].time_type];
-    while (node != NULL) {
-        if (node->te.type == list && callback(&(node->te))) {
-            return true;
-        }
-
-        node = node->next;
-    }
+    heaps[0] = &(timeevent_new_lists[stru_5B2188[list].time_type]);
+    heaps[1] = &(timeevent_lists[stru_5B2188[list].time_type]);
 
-    node = timeevent_lists[stru_5B2188[list].time_type];
-    while (node != NULL) {
-        if (node->te.type == list && callback(&(node->te))) {
-            return true;
+    for (heap_index = 0; heap_index < 2; heap_index++) {
+        count = timeevent_collect(heaps[heap_index], list, by_obj, obj, true);
+        for (index = 0; index < count; index++) {
+            if (callback(&(timeevent_scratch[index]->te))) {
+                return true;
+            }
         }
-
-        node = node->next;
     }
 
     return false;
@@ -1560,8 +1811,9 @@ void timeevent_save_nodes_to_map(const char* name)
     bool exists = false;
     int count;
     int time_type;
+    int nodes_count;
+    int index;
     TimeEventNode* node;
-    TimeEventNode** node_ptr;
 
     snprintf(path, sizeof(path), "Save\\Current\\maps\\%s\\TimeEvent.dat", name);
 
@@ -1605,11 +1857,11 @@ void timeevent_save_nodes_to_map(const char* name)
     }
 
     for (time_type = 0; time_type < TIME_TYPE_COUNT; time_type++) {
-        node_ptr = &(timeevent_lists[time_type]);
-        while (*node_ptr != NULL) {
-            node = *node_ptr;
+        nodes_count = timeevent_collect_heap(&(timeevent_lists[time_type]));
+        for (index = 0; index < nodes_count; index++) {
+            node = timeevent_scratch[index];
             if (sub_45C500(node) < 0) {
-                *node_ptr = node->next;
+                timeevent_node_unlink(node);
 
                 if (!timeevent_save_node(&(stru_5B2188[node->te.type]), node, stream)) {
                     tig_debug_printf("TimeEvent: timeevent_save_nodes_to_map: ERROR: Failed to save out nodes!\n");
@@ -1629,8 +1881,6 @@ void timeevent_save_nodes_to_map(const char* name)
                 }
 
                 timeevent_node_destroy(node);
-            } else {
-                node_ptr = &(node->next);
             }
         }
     }
@@ -1680,20 +1930,26 @@ int sub_45C500(TimeEventNode* node)
 void sub_45C580(void)
 {
     int time_type;
+    int index;
     TimeEventNode* node;
     char* name;
 
     for (time_type = 0; time_type < TIME_TYPE_COUNT; time_type++) {
-        node = timeevent_lists[time_type];
-        while (node != NULL) {
+        for (index = 0; index < timeevent_lists[time_type].size; index++) {
+            node = timeevent_lists[time_type].nodes[index];
             timeevent_recover_handles_internal(node, true);
-            node = node->next;
+
+            // Recovered handles may differ from the ones the node was indexed
+            // with.
+            timeevent_node_obj_unlink(node);
+            timeevent_node_obj_link(node);
         }
 
-        node = timeevent_new_lists[time_type];
-        while (node != NULL) {
+        for (index = 0; index < timeevent_new_lists[time_type].size; index++) {
+            node = timeevent_new_lists[time_type].nodes[index];
             timeevent_recover_handles_internal(node, true);
-            node = node->next;
+            timeevent_node_obj_unlink(node);
+            timeevent_node_obj_link(node);
         }
     }
 
@@ -1782,8 +2038,9 @@ void timeevent_break_nodes_to_map(const char* name)
     bool exists = false;
     int count;
     int time_type;
+    int nodes_count;
+    int index;
     TimeEventNode* node;
-    TimeEventNode** node_ptr;
 
     snprintf(path, sizeof(path), "Save\\Current\\maps\\%s\\TimeEvent.dat", name);
 
@@ -1827,11 +2084,11 @@ void timeevent_break_nodes_to_map(const char* name)
     }
 
     for (time_type = 0; time_type < TIME_TYPE_COUNT; time_type++) {
-        node_ptr = &(timeevent_lists[time_type]);
-        while (*node_ptr != NULL) {
-            node = *node_ptr;
+        nodes_count = timeevent_collect_heap(&(timeevent_lists[time_type]));
+        for (index = 0; index < nodes_count; index++) {
+            node = timeevent_scratch[index];
             if (sub_45C500(node) > 0) {
-                *node_ptr = node->next;
+                timeevent_node_unlink(node);
 
                 if (!timeevent_save_node(&(stru_5B2188[node->te.type]), node, stream)) {
                     tig_debug_printf("TimeEvent: timeevent_break_nodes_to_map: ERROR: Failed to save out nodes!\n");
@@ -1851,8 +2108,6 @@ void timeevent_break_nodes_to_map(const char* name)
                 }
 
                 timeevent_node_destroy(node);
-            } else {
-                node_ptr = &(node->next);
             }
         }
     }
@@ -1893,6 +2148,8 @@ bool debug_timeevent_process(TimeEvent* timeevent)
 void timeevent_debug_lists(void)
 {
     TimeEventNode* node;
+    int nodes_count;
+    int node_index;
     int time_type_counts[TIME_TYPE_COUNT];
     int timeevent_type_counts[TIMEEVENT_TYPE_COUNT];
     char time_str[TIME_STR_LENGTH];
@@ -1926,20 +2183,20 @@ void timeevent_debug_lists(void)
         datetime_format_datetime(&time, time_str, sizeof(time_str));
         tig_debug_printf("\t[%s] Game Time: [%s]\n", off_5B2178[index], time_str);
 
-        node = timeevent_new_lists[index];
-        while (node != NULL) {
+        nodes_count = timeevent_collect_heap(&(timeevent_new_lists[index]));
+        for (node_index = 0; node_index < nodes_count; node_index++) {
+            node = timeevent_scratch[node_index];
             time_type_counts[index]++;
             timeevent_type_counts[node->te.type]++;
             timeevent_debug_node(node, time_type_counts[index]);
-            node = node->next;
         }
 
-        node = timeevent_lists[index];
-        while (node != NULL) {
+        nodes_count = timeevent_collect_heap(&(timeevent_lists[index]));
+        for (node_index = 0; node_index < nodes_count; node_index++) {
+            node = timeevent_scratch[node_index];
             time_type_counts[index]++;
             timeevent_type_counts[node->te.type]++;
             timeevent_debug_node(node, time_type_counts[index]);
-            node = node->next;
         }
     }
 
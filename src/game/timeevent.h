@@ -162,6 +162,14 @@ bool timeevent_clear_all_ex(int list, TimeEventEnumerateFunc callback);
 bool timeevent_clear_one_ex(int list, TimeEventEnumerateFunc callback);
 bool sub_45C0E0(int list);
 bool timeevent_any(int list, TimeEventEnumerateFunc callback);
+
+// Variants of the functions above which only consider events whose first
+// object parameter is `obj`. They use object index instead of enumerating all
+// events of the type.
+bool timeevent_clear_all_obj_ex(int list, int64_t obj, TimeEventEnumerateFunc callback);
+bool timeevent_clear_one_obj_ex(int list, int64_t obj, TimeEventEnumerateFunc callback);
+bool timeevent_any_obj(int list, int64_t obj, TimeEventEnumerateFunc callback);
+
 bool timeevent_inc_milliseconds(unsigned int milliseconds);
 bool timeevent_inc_datetime(DateTime* datetime);
 void timeevent_sync(DateTime* game_time, DateTime* anim_time);